@@ -0,0 +1,41 @@
+#version 300 es
+
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// static unit quad
+layout(location = 0) in vec2 aVertexPosition;
+layout(location = 1) in vec2 aTexCoord;
+
+// per instance (divisor 1)
+layout(location = 2) in vec3  aModelRow0;
+layout(location = 3) in vec3  aModelRow1;
+layout(location = 4) in vec4  aTexCoordRect; // bl.st, tr.st
+layout(location = 5) in float aDepth;        // [0, 1], 0 is the front
+layout(location = 6) in vec4  aTint;
+layout(location = 7) in uint  aTextureSlot;
+
+out vec2      vTexCoord;
+out vec4      vTint;
+flat out uint vTextureSlot;
+
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
+void main()
+{
+    vec3 local_pos = vec3(aVertexPosition, 1.0);
+    vec2 world_pos = vec2(dot(aModelRow0, local_pos), dot(aModelRow1, local_pos));
+    vec3 ndc_pos   = uViewProjection * vec3(world_pos, 1.0);
+    gl_Position    = vec4(ndc_pos.xy, aDepth * 2.0 - 1.0, 1.0);
+    vTexCoord      = mix(aTexCoordRect.xy, aTexCoordRect.zw, aTexCoord);
+    vTint          = aTint;
+    vTextureSlot   = aTextureSlot;
+}
@@ -0,0 +1,33 @@
+#version 300 es
+precision mediump float;
+precision mediump sampler2D;
+
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// TEXTURE_SLOTS and SAMPLE_TEXTURE(slot, uv) are generated by BatchRenderer2D::Init
+
+in vec2      vTexCoord;
+in vec4      vTint;
+flat in uint vTextureSlot;
+
+out vec4 FragColor;
+
+uniform sampler2D uTextures[TEXTURE_SLOTS];
+
+void main()
+{
+    vec4 texColor = SAMPLE_TEXTURE(vTextureSlot, vTexCoord) * vTint;
+
+    if (texColor.a == 0.0)
+    {
+        discard;
+    }
+
+    FragColor = texColor;
+}
@@ -0,0 +1,32 @@
+#version 300 es
+
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+layout(location = 0) in vec3 aVertexPosition; // already in world space, z is the depth in [0, 1]
+layout(location = 1) in vec2 aTexCoord;
+layout(location = 2) in vec4 aTint;
+layout(location = 3) in uint aTextureSlot;
+
+out vec2      vTexCoord;
+out vec4      vTint;
+flat out uint vTextureSlot;
+
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
+void main()
+{
+    vec3 ndc_pos = uViewProjection * vec3(aVertexPosition.xy, 1.0);
+    gl_Position  = vec4(ndc_pos.xy, aVertexPosition.z * 2.0 - 1.0, 1.0);
+    vTexCoord    = aTexCoord;
+    vTint        = aTint;
+    vTextureSlot = aTextureSlot;
+}
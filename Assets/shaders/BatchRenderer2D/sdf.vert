@@ -0,0 +1,50 @@
+#version 300 es
+
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// static unit quad
+layout(location = 0) in vec2 aVertexPosition;
+
+// per instance (divisor 1)
+layout(location = 1) in vec3  aModelRow0; // quad transform already grown by the line width
+layout(location = 2) in vec3  aModelRow1;
+layout(location = 3) in vec2  aWorldSize;
+layout(location = 4) in vec2  aQuadSize;
+layout(location = 5) in vec4  aFillColor;
+layout(location = 6) in vec4  aLineColor;
+layout(location = 7) in float aLineWidth;
+layout(location = 8) in float aDepth; // [0, 1], 0 is the front
+layout(location = 9) in uint  aShape;
+
+out vec2       vLocalPosition;
+flat out vec2  vHalfSize;
+flat out vec4  vFillColor;
+flat out vec4  vLineColor;
+flat out float vLineWidth;
+flat out uint  vShape;
+
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
+void main()
+{
+    vec3 local_pos = vec3(aVertexPosition, 1.0);
+    vec2 world_pos = vec2(dot(aModelRow0, local_pos), dot(aModelRow1, local_pos));
+    vec3 ndc_pos   = uViewProjection * vec3(world_pos, 1.0);
+    gl_Position    = vec4(ndc_pos.xy, aDepth * 2.0 - 1.0, 1.0);
+
+    vLocalPosition = aVertexPosition * aQuadSize;
+    vHalfSize      = 0.5 * aWorldSize;
+    vFillColor     = aFillColor;
+    vLineColor     = aLineColor;
+    vLineWidth     = aLineWidth;
+    vShape         = aShape;
+}
@@ -9,30 +9,40 @@ precision mediump float;
  * \copyright DigiPen Institute of Technology
  */
 
+// each keyword becomes a separate program, see OpenGL::ShaderVariants
+#pragma shader_feature MODULATE_COLOR PROCEDURAL_TEXTURE USE_IMAGE USE_TEXTURE_ALPHA
+
 in vec3 vColor;
 in vec2 vTextureCoordinates;
 
 layout(location = 0) out vec4 fFragClr;
 
+#if defined(USE_IMAGE)
 uniform sampler2D uTex2d;
-uniform float     uModulateColor;
-uniform float     uProcTex;
-uniform float     uTileSize;
-uniform float     uUseImage;
-uniform bool      uUseTextureAlpha;
+#endif
+
+#if defined(PROCEDURAL_TEXTURE)
+uniform float uTileSize;
 
 const vec4 cyan = vec4(1.0, 0.0, 1.0, 1.0);
 const vec4 teal = vec4(0.0, 0.68, 0.94, 1.0);
+#endif
 
 void main()
 {
-    vec4 interpolated_color = mix(vec4(1.0), vec4(vColor, 1.0), uModulateColor);
-    vec4 procedural_color   = mix(vec4(1.0), (0.0 == mod(floor(gl_FragCoord.x / uTileSize) + floor(gl_FragCoord.y / uTileSize), 2.0)) ? cyan : teal, uProcTex);
-    vec4 texture_color      = mix(vec4(1.0), texture(uTex2d, vTextureCoordinates), uUseImage);
-    if (!uUseTextureAlpha)
-    {
-        texture_color.a = 1.0;
-    }
-
-    fFragClr = interpolated_color * procedural_color * texture_color;
+    vec4 color = vec4(1.0);
+#if defined(MODULATE_COLOR)
+    color *= vec4(vColor, 1.0);
+#endif
+#if defined(PROCEDURAL_TEXTURE)
+    color *= (0.0 == mod(floor(gl_FragCoord.x / uTileSize) + floor(gl_FragCoord.y / uTileSize), 2.0)) ? cyan : teal;
+#endif
+#if defined(USE_IMAGE)
+    vec4 texture_color = texture(uTex2d, vTextureCoordinates);
+#    if !defined(USE_TEXTURE_ALPHA)
+    texture_color.a = 1.0;
+#    endif
+    color *= texture_color;
+#endif
+    fFragClr = color;
 }
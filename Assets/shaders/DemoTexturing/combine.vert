@@ -17,12 +17,16 @@ out vec2 vTextureCoordinates;
 
 uniform float uTexCoordScale;
 
-uniform mat3 uToNDC;
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
 uniform mat3 uModel;
 
 void main()
 {
-    vec3 ndc_position   = uToNDC * uModel * vec3(aVertexPosition, 1.0);
+    vec3 ndc_position   = uViewProjection * uModel * vec3(aVertexPosition, 1.0);
     gl_Position         = vec4(ndc_position.xy, 0.0, 1.0);
     vColor              = aVertexColor;
     vTextureCoordinates = aVertexTextureCoordinates * uTexCoordScale;
@@ -0,0 +1,54 @@
+#version 300 es
+precision highp float;
+
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+// matches CS200::Renderer2DUtils::SDFShape
+const uint SHAPE_CIRCLE = 0u;
+
+in vec2        vLocalPosition; // world units relative to the shape center
+flat in vec2   vHalfSize;
+flat in vec4   vFillColor;
+flat in vec4   vLineColor;
+flat in float  vLineWidth;
+flat in uint   vShape;
+
+out vec4 FragColor;
+
+float sdf_circle(vec2 p, float radius)
+{
+    return length(p) - radius;
+}
+
+float sdf_box(vec2 p, vec2 half_size)
+{
+    vec2 d = abs(p) - half_size;
+    return length(max(d, 0.0)) + min(max(d.x, d.y), 0.0);
+}
+
+void main()
+{
+    float dist = vShape == SHAPE_CIRCLE ? sdf_circle(vLocalPosition, min(vHalfSize.x, vHalfSize.y)) : sdf_box(vLocalPosition, vHalfSize);
+
+    // half a pixel in world units on each side of an edge
+    float aa        = 0.5 * fwidth(dist);
+    float half_line = 0.5 * vLineWidth;
+    float outside   = smoothstep(-aa, aa, dist - half_line);
+    float in_fill   = 1.0 - smoothstep(-aa, aa, dist + half_line);
+
+    vec4 color = mix(vLineColor, vFillColor, in_fill);
+    color.a *= 1.0 - outside;
+
+    if (color.a == 0.0)
+    {
+        discard;
+    }
+
+    FragColor = color;
+}
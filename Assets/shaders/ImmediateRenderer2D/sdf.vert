@@ -0,0 +1,45 @@
+#version 300 es
+
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+layout(location = 0) in vec2 aVertexPosition;
+
+out vec2       vLocalPosition;
+flat out vec2  vHalfSize;
+flat out vec4  vFillColor;
+flat out vec4  vLineColor;
+flat out float vLineWidth;
+flat out uint  vShape;
+
+layout(std140) uniform Camera
+{
+    mat3 uViewProjection;
+};
+
+uniform mat3  uModel; // quad transform already grown by the line width
+uniform vec2  uWorldSize;
+uniform vec2  uQuadSize;
+uniform vec4  uFillColor;
+uniform vec4  uLineColor;
+uniform float uLineWidth;
+uniform uint  uShape;
+uniform float uDepth; // [0, 1], 0 is the front
+
+void main()
+{
+    vec3 ndc_pos = uViewProjection * uModel * vec3(aVertexPosition, 1.0);
+    gl_Position  = vec4(ndc_pos.xy, uDepth * 2.0 - 1.0, 1.0);
+
+    vLocalPosition = aVertexPosition * uQuadSize;
+    vHalfSize      = 0.5 * uWorldSize;
+    vFillColor     = uFillColor;
+    vLineColor     = uLineColor;
+    vLineWidth     = uLineWidth;
+    vShape         = uShape;
+}
@@ -22,3 +22,9 @@ target_link_libraries(dependencies INTERFACE
     the_gsl
     the_stb
 )
+
+# util::ThreadPool runs on std::thread, the web build has no pthreads and runs its jobs on the main thread
+if(NOT EMSCRIPTEN)
+    find_package(Threads REQUIRED)
+    target_link_libraries(dependencies INTERFACE Threads::Threads)
+endif()
@@ -0,0 +1,499 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "BatchRenderer2D.hpp"
+#include "OpenGL/Buffer.hpp"
+#include "OpenGL/Environment.hpp"
+#include "OpenGL/GL.hpp"
+#include "Renderer2DUtils.hpp"
+#include <algorithm>
+#include <array>
+#include <string>
+#include <utility>
+
+namespace CS200
+{
+    namespace
+    {
+        constexpr unsigned VERTICES_PER_QUAD = 4;
+        constexpr unsigned INDICES_PER_QUAD  = 6;
+
+        // unit quad corners in the same order as ImmediateRenderer2D so both renderers agree on winding
+        constexpr std::array<Math::vec2, VERTICES_PER_QUAD> QUAD_CORNERS = {
+            Math::vec2{ -0.5, -0.5 },
+            Math::vec2{  0.5, -0.5 },
+            Math::vec2{  0.5,  0.5 },
+            Math::vec2{ -0.5,  0.5 }
+        };
+
+        struct UnitQuadVertex
+        {
+            float x;
+            float y;
+            float s;
+            float t;
+        };
+
+        // GLSL ES 3.00 only allows constant indices into sampler arrays, so the slot is resolved with a select chain
+        std::string build_texture_slots_preamble(unsigned slot_count)
+        {
+            std::string preamble = "#define TEXTURE_SLOTS " + std::to_string(slot_count) + "\n#define SAMPLE_TEXTURE(slot, uv) (";
+            for (unsigned slot = 0; slot + 1 < slot_count; ++slot)
+            {
+                const auto index = std::to_string(slot);
+                preamble += "(slot) == " + index + "u ? texture(uTextures[" + index + "], uv) : ";
+            }
+            preamble += "texture(uTextures[" + std::to_string(slot_count - 1) + "], uv))";
+            return preamble;
+        }
+
+        void assign_texture_units(const OpenGL::CompiledShader& shader, unsigned slot_count)
+        {
+            std::array<GLint, BatchRenderer2D::MaxTextureSlots> units{};
+            for (unsigned slot = 0; slot < slot_count; ++slot)
+            {
+                units[slot] = static_cast<GLint>(slot);
+            }
+            GL::UseProgram(shader.Shader);
+            GL::Uniform1iv(shader.GetUniformLocation("uTextures[0]"), static_cast<GLsizei>(slot_count), units.data());
+        }
+    }
+
+    BatchRenderer2D::BatchRenderer2D(BatchRenderer2D&& other) noexcept
+        : mode(other.mode), vao(other.vao), vbo(other.vbo), ibo(other.ibo), sdfVao(other.sdfVao), sdfVbo(other.sdfVbo), stream(std::move(other.stream)), quadStream(std::move(other.quadStream)),
+          shapeStream(std::move(other.shapeStream)), quadStreamAttribute(other.quadStreamAttribute), quadShader(std::move(other.quadShader)), sdfShader(std::move(other.sdfShader)), vertices(std::move(other.vertices)), instances(std::move(other.instances)),
+          shapes(std::move(other.shapes)), batchTextures(other.batchTextures), batchTextureCount(other.batchTextureCount), textureSlotCount(other.textureSlotCount),
+          viewProjection(other.viewProjection), statistics(other.statistics)
+    {
+        other.vao               = 0;
+        other.vbo               = 0;
+        other.ibo               = 0;
+        other.sdfVao            = 0;
+        other.sdfVbo            = 0;
+        other.quadShader        = {};
+        other.sdfShader         = {};
+        other.batchTextureCount = 0;
+
+        // the watches point at other's shaders and capture other, they move over to this renderer
+        OpenGL::UnwatchShader(other.quadShader);
+        OpenGL::UnwatchShader(other.sdfShader);
+        watchShaders();
+    }
+
+    BatchRenderer2D& BatchRenderer2D::operator=(BatchRenderer2D&& other) noexcept
+    {
+        if (this != &other)
+        {
+            OpenGL::UnwatchShader(quadShader);
+            OpenGL::UnwatchShader(sdfShader);
+            OpenGL::UnwatchShader(other.quadShader);
+            OpenGL::UnwatchShader(other.sdfShader);
+
+            std::swap(mode, other.mode);
+            std::swap(vao, other.vao);
+            std::swap(vbo, other.vbo);
+            std::swap(ibo, other.ibo);
+            std::swap(sdfVao, other.sdfVao);
+            std::swap(sdfVbo, other.sdfVbo);
+            std::swap(stream, other.stream);
+            std::swap(quadStream, other.quadStream);
+            std::swap(shapeStream, other.shapeStream);
+            std::swap(quadStreamAttribute, other.quadStreamAttribute);
+            std::swap(quadShader, other.quadShader);
+            std::swap(sdfShader, other.sdfShader);
+            std::swap(vertices, other.vertices);
+            std::swap(instances, other.instances);
+            std::swap(shapes, other.shapes);
+            std::swap(batchTextures, other.batchTextures);
+            std::swap(batchTextureCount, other.batchTextureCount);
+            std::swap(textureSlotCount, other.textureSlotCount);
+            std::swap(viewProjection, other.viewProjection);
+            std::swap(statistics, other.statistics);
+
+            // each renderer watches the files of the mode it ended up with
+            watchShaders();
+            other.watchShaders();
+        }
+        return *this;
+    }
+
+    BatchRenderer2D::~BatchRenderer2D()
+    {
+        Shutdown();
+    }
+
+    void BatchRenderer2D::Init()
+    {
+        textureSlotCount           = static_cast<unsigned>(std::clamp(OpenGL::MaxTextureImageUnits, 1, static_cast<int>(MaxTextureSlots)));
+        const std::string preamble = build_texture_slots_preamble(textureSlotCount);
+        stream.Init(OpenGL::BufferType::Vertices, StreamBytesPerFrame);
+
+        // both programs build on driver threads while the buffers and vertex arrays are created
+        using filepath                    = std::filesystem::path;
+        const filepath        quad_vertex = mode == Mode::Instanced ? filepath{ "Assets/shaders/BatchRenderer2D/instanced.vert" } : filepath{ "Assets/shaders/BatchRenderer2D/quad.vert" };
+        OpenGL::PendingShader quad_shader = OpenGL::CreateShaderAsync(quad_vertex, filepath{ "Assets/shaders/BatchRenderer2D/quad.frag" }, preamble);
+        OpenGL::PendingShader sdf_shader  = OpenGL::CreateShaderAsync(filepath{ "Assets/shaders/BatchRenderer2D/sdf.vert" }, filepath{ "Assets/shaders/BatchRenderer2D/sdf.frag" });
+
+        if (mode == Mode::Instanced)
+        {
+            initInstancedQuads(quad_shader);
+        }
+        else
+        {
+            initVertexQuads(quad_shader);
+        }
+        initShapes(sdf_shader);
+
+        watchShaders();
+    }
+
+    void BatchRenderer2D::watchShaders()
+    {
+        // nothing to watch before Init() or after a move left this renderer empty
+        if (quadShader.Shader == 0)
+        {
+            return;
+        }
+        // developer builds rebuild the programs after their files are edited, the per program state is set again
+        using filepath             = std::filesystem::path;
+        const filepath quad_vertex = mode == Mode::Instanced ? filepath{ "Assets/shaders/BatchRenderer2D/instanced.vert" } : filepath{ "Assets/shaders/BatchRenderer2D/quad.vert" };
+        OpenGL::WatchShader(quadShader, quad_vertex, filepath{ "Assets/shaders/BatchRenderer2D/quad.frag" }, build_texture_slots_preamble(textureSlotCount),
+                            [this](const OpenGL::CompiledShader& shader)
+                            {
+                                assign_texture_units(shader, textureSlotCount);
+                                OpenGL::SetUniformBlockBinding(shader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera");
+                            });
+        OpenGL::WatchShader(sdfShader, filepath{ "Assets/shaders/BatchRenderer2D/sdf.vert" }, filepath{ "Assets/shaders/BatchRenderer2D/sdf.frag" }, {},
+                            [](const OpenGL::CompiledShader& shader) { OpenGL::SetUniformBlockBinding(shader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera"); });
+    }
+
+    void BatchRenderer2D::initInstancedQuads(OpenGL::PendingShader& pending_shader)
+    {
+        const std::array<unsigned short, INDICES_PER_QUAD>  indices = { 0, 1, 2, 2, 3, 0 };
+        const std::array<UnitQuadVertex, VERTICES_PER_QUAD> quad    = {
+            UnitQuadVertex{ -0.5f, -0.5f, 0.0f, 0.0f },
+            UnitQuadVertex{  0.5f, -0.5f, 1.0f, 0.0f },
+            UnitQuadVertex{  0.5f,  0.5f, 1.0f, 1.0f },
+            UnitQuadVertex{ -0.5f,  0.5f, 0.0f, 1.0f }
+        };
+
+        vbo = OpenGL::CreateBuffer(OpenGL::BufferType::Vertices, std::as_bytes(std::span{ quad }));
+        ibo = OpenGL::CreateBuffer(OpenGL::BufferType::Indices, std::as_bytes(std::span{ indices }));
+
+        namespace Attribute = OpenGL::Attribute;
+
+        const auto quad_layout = OpenGL::BufferLayout{ { Attribute::Float2, Attribute::Float2 } };
+        quadStream             = OpenGL::VertexBuffer{
+            stream.GetHandle(),
+            OpenGL::BufferLayout{ { Attribute::Type{ Attribute::Float3 }.WithDivisor(1), Attribute::Type{ Attribute::Float3 }.WithDivisor(1), Attribute::Type{ Attribute::Float4 }.WithDivisor(1),
+                                  Attribute::Type{ Attribute::Float }.WithDivisor(1), Attribute::Type{ Attribute::UByte4ToNormalized }.WithDivisor(1), Attribute::Type{ Attribute::UInt }.WithDivisor(1) } }
+        };
+        quadStreamAttribute = 2; // after the unit quad's position and texture coordinate
+        vao                 = OpenGL::CreateVertexArrayObject({ OpenGL::VertexBuffer{ vbo, quad_layout }, quadStream }, ibo);
+
+        quadShader = pending_shader.Get();
+        assign_texture_units(quadShader, textureSlotCount);
+
+        OpenGL::SetUniformBlockBinding(quadShader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera");
+
+        instances.clear();
+        instances.reserve(MaxInstancesPerBatch);
+    }
+
+    void BatchRenderer2D::initVertexQuads(OpenGL::PendingShader& pending_shader)
+    {
+        std::vector<unsigned short> indices(MaxQuadsPerBatch * INDICES_PER_QUAD);
+        for (unsigned quad = 0; quad < MaxQuadsPerBatch; ++quad)
+        {
+            const auto first   = static_cast<unsigned short>(quad * VERTICES_PER_QUAD);
+            const auto index   = quad * INDICES_PER_QUAD;
+            indices[index + 0] = first;
+            indices[index + 1] = static_cast<unsigned short>(first + 1);
+            indices[index + 2] = static_cast<unsigned short>(first + 2);
+            indices[index + 3] = static_cast<unsigned short>(first + 2);
+            indices[index + 4] = static_cast<unsigned short>(first + 3);
+            indices[index + 5] = first;
+        }
+
+        ibo = OpenGL::CreateBuffer(OpenGL::BufferType::Indices, std::as_bytes(std::span{ indices }));
+
+        quadStream = OpenGL::VertexBuffer{
+            stream.GetHandle(),
+            OpenGL::BufferLayout{ { OpenGL::Attribute::Float3, OpenGL::Attribute::Float2, OpenGL::Attribute::UByte4ToNormalized, OpenGL::Attribute::UInt } }
+        };
+        quadStreamAttribute = 0;
+        vao                 = OpenGL::CreateVertexArrayObject(quadStream, ibo);
+
+        quadShader = pending_shader.Get();
+        assign_texture_units(quadShader, textureSlotCount);
+        OpenGL::SetUniformBlockBinding(quadShader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera");
+
+        vertices.clear();
+        vertices.reserve(VERTICES_PER_QUAD * MaxQuadsPerBatch);
+    }
+
+    void BatchRenderer2D::initShapes(OpenGL::PendingShader& pending_shader)
+    {
+        // both index buffers start with the (0,1,2,2,3,0) pattern of a single quad, so the shapes reuse it
+        const std::array<float, 2 * VERTICES_PER_QUAD> sdf_positions = { -0.5f, -0.5f, 0.5f, -0.5f, 0.5f, 0.5f, -0.5f, 0.5f };
+
+        sdfVbo = OpenGL::CreateBuffer(OpenGL::BufferType::Vertices, std::as_bytes(std::span{ sdf_positions }));
+
+        namespace Attribute = OpenGL::Attribute;
+
+        const auto sdf_quad_layout = OpenGL::BufferLayout{ { Attribute::Float2 } };
+        shapeStream                = OpenGL::VertexBuffer{
+            stream.GetHandle(),
+            OpenGL::BufferLayout{ { Attribute::Type{ Attribute::Float3 }.WithDivisor(1), Attribute::Type{ Attribute::Float3 }.WithDivisor(1), Attribute::Type{ Attribute::Float2 }.WithDivisor(1),
+                                  Attribute::Type{ Attribute::Float2 }.WithDivisor(1), Attribute::Type{ Attribute::UByte4ToNormalized }.WithDivisor(1),
+                                  Attribute::Type{ Attribute::UByte4ToNormalized }.WithDivisor(1), Attribute::Type{ Attribute::Float }.WithDivisor(1), Attribute::Type{ Attribute::Float }.WithDivisor(1),
+                                  Attribute::Type{ Attribute::UInt }.WithDivisor(1) } }
+        };
+        sdfVao = OpenGL::CreateVertexArrayObject({ OpenGL::VertexBuffer{ sdfVbo, sdf_quad_layout }, shapeStream }, ibo);
+
+        sdfShader = pending_shader.Get();
+        OpenGL::SetUniformBlockBinding(sdfShader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera");
+
+        shapes.clear();
+        shapes.reserve(MaxShapesPerBatch);
+    }
+
+    void BatchRenderer2D::Shutdown()
+    {
+        OpenGL::DestroyShader(quadShader);
+        OpenGL::DestroyShader(sdfShader);
+
+        GL::DeleteBuffers(1, &vbo);
+        GL::DeleteBuffers(1, &ibo);
+        GL::DeleteBuffers(1, &sdfVbo);
+        GL::DeleteVertexArrays(1, &vao);
+        GL::DeleteVertexArrays(1, &sdfVao);
+        stream.Shutdown();
+
+        quadShader        = {};
+        sdfShader         = {};
+        vbo               = {};
+        ibo               = {};
+        sdfVbo            = {};
+        vao               = {};
+        sdfVao            = {};
+        batchTextureCount = 0;
+        vertices.clear();
+        vertices.shrink_to_fit();
+        instances.clear();
+        instances.shrink_to_fit();
+        shapes.clear();
+        shapes.shrink_to_fit();
+    }
+
+    void BatchRenderer2D::BeginScene(const Math::TransformationMatrix& view_projection)
+    {
+        viewProjection = view_projection;
+        statistics     = {};
+
+        // written once per scene, every 2D shader reads it through the shared Camera block
+        Renderer2DUtils::PublishCamera(view_projection);
+
+        batchTextureCount = 0;
+        vertices.clear();
+        instances.clear();
+        shapes.clear();
+    }
+
+    void BatchRenderer2D::EndScene()
+    {
+        flush();
+        stream.EndFrame();
+    }
+
+    void BatchRenderer2D::Flush()
+    {
+        flush();
+    }
+
+    void BatchRenderer2D::DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor, double depth)
+    {
+        if (!Renderer2DUtils::IsQuadVisible(viewProjection, transform))
+        {
+            ++statistics.Culled;
+            return;
+        }
+
+        flushShapes();
+        if (batchedQuads() >= batchCapacity())
+        {
+            flushQuads();
+        }
+
+        const std::uint32_t slot = acquireTextureSlot(texture);
+        const std::uint32_t tint = rgba_to_abgr(tintColor);
+        ++statistics.Quads;
+
+        if (mode == Mode::Instanced)
+        {
+            const auto to_float = [](double value) { return static_cast<float>(value); };
+            instances.push_back(QuadInstance{
+                { to_float(transform[0][0]), to_float(transform[0][1]), to_float(transform[0][2]) },
+                { to_float(transform[1][0]), to_float(transform[1][1]), to_float(transform[1][2]) },
+                { to_float(texture_coord_bl.x), to_float(texture_coord_bl.y), to_float(texture_coord_tr.x), to_float(texture_coord_tr.y) },
+                to_float(depth),
+                tint,
+                slot
+            });
+            return;
+        }
+
+        const Math::vec2 tex_scale = texture_coord_tr - texture_coord_bl;
+
+        for (const Math::vec2& corner : QUAD_CORNERS)
+        {
+            const Math::vec2 position = transform * corner;
+            const Math::vec2 unit_st{ corner.x + 0.5, corner.y + 0.5 };
+            vertices.push_back(QuadVertex{ static_cast<float>(position.x), static_cast<float>(position.y), static_cast<float>(depth), static_cast<float>(texture_coord_bl.x + unit_st.x * tex_scale.x),
+                                           static_cast<float>(texture_coord_bl.y + unit_st.y * tex_scale.y), tint, slot });
+        }
+    }
+
+    unsigned BatchRenderer2D::acquireTextureSlot(OpenGL::TextureHandle texture)
+    {
+        for (unsigned slot = 0; slot < batchTextureCount; ++slot)
+        {
+            if (batchTextures[slot] == texture)
+            {
+                return slot;
+            }
+        }
+        if (batchTextureCount == textureSlotCount)
+        {
+            flushQuads();
+        }
+        batchTextures[batchTextureCount] = texture;
+        return batchTextureCount++;
+    }
+
+    unsigned BatchRenderer2D::batchedQuads() const noexcept
+    {
+        return mode == Mode::Instanced ? static_cast<unsigned>(instances.size()) : static_cast<unsigned>(vertices.size() / VERTICES_PER_QUAD);
+    }
+
+    unsigned BatchRenderer2D::batchCapacity() const noexcept
+    {
+        return mode == Mode::Instanced ? MaxInstancesPerBatch : MaxQuadsPerBatch;
+    }
+
+    void BatchRenderer2D::DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        appendShape(transform, Renderer2DUtils::SDFShape::Circle, fill_color, line_color, line_width, depth);
+    }
+
+    void BatchRenderer2D::DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        appendShape(transform, Renderer2DUtils::SDFShape::Rectangle, fill_color, line_color, line_width, depth);
+    }
+
+    void BatchRenderer2D::DrawLine(const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width, double depth)
+    {
+        const auto line_transform = Renderer2DUtils::CalculateLineTransform(transform, start_point, end_point, line_width);
+        appendShape(line_transform, Renderer2DUtils::SDFShape::Rectangle, line_color, line_color, 0.0, depth);
+    }
+
+    void BatchRenderer2D::appendShape(const Math::TransformationMatrix& transform, Renderer2DUtils::SDFShape shape, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        const auto sdf = Renderer2DUtils::CalculateSDFTransform(transform, line_width);
+        if (!(sdf.WorldSize[0] > 0.0f && sdf.WorldSize[1] > 0.0f))
+        {
+            return;
+        }
+        if (!Renderer2DUtils::IsQuadVisible(viewProjection, transform, line_width))
+        {
+            ++statistics.Culled;
+            return;
+        }
+
+        flushQuads();
+        if (shapes.size() >= MaxShapesPerBatch)
+        {
+            flushShapes();
+        }
+        ++statistics.Shapes;
+
+        // QuadTransform is column-major, the instance record stores the first two rows
+        const auto& m = sdf.QuadTransform;
+        shapes.push_back(ShapeInstance{
+            { m[0], m[3], m[6] },
+            { m[1], m[4], m[7] },
+            { sdf.WorldSize[0], sdf.WorldSize[1] },
+            { sdf.QuadSize[0], sdf.QuadSize[1] },
+            rgba_to_abgr(fill_color),
+            rgba_to_abgr(line_color),
+            static_cast<float>(line_width),
+            static_cast<float>(depth),
+            static_cast<std::uint32_t>(shape)
+        });
+    }
+
+    void BatchRenderer2D::flush()
+    {
+        flushQuads();
+        flushShapes();
+    }
+
+    void BatchRenderer2D::flushQuads()
+    {
+        const auto quad_count = static_cast<GLsizei>(batchedQuads());
+        if (quad_count == 0)
+        {
+            return;
+        }
+
+        const auto     batch_bytes = mode == Mode::Instanced ? std::as_bytes(std::span{ instances }) : std::as_bytes(std::span{ vertices });
+        const GLintptr offset      = stream.Upload(batch_bytes);
+        OpenGL::SetVertexBufferOffset(vao, quadStreamAttribute, quadStream, offset);
+
+        GL::UseProgram(quadShader.Shader);
+
+        for (unsigned slot = 0; slot < batchTextureCount; ++slot)
+        {
+            GL::ActiveTexture(GL_TEXTURE0 + slot);
+            GL::BindTexture(GL_TEXTURE_2D, batchTextures[slot]);
+        }
+        GL::ActiveTexture(GL_TEXTURE0);
+        GL::BindVertexArray(vao);
+
+        if (mode == Mode::Instanced)
+        {
+            GL::DrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(INDICES_PER_QUAD), GL_UNSIGNED_SHORT, nullptr, quad_count);
+        }
+        else
+        {
+            GL::DrawElements(GL_TRIANGLES, quad_count * static_cast<GLsizei>(INDICES_PER_QUAD), GL_UNSIGNED_SHORT, nullptr);
+        }
+
+        ++statistics.DrawCalls;
+        vertices.clear();
+        instances.clear();
+        batchTextureCount = 0;
+    }
+
+    void BatchRenderer2D::flushShapes()
+    {
+        if (shapes.empty())
+        {
+            return;
+        }
+
+        const GLintptr offset = stream.Upload(std::as_bytes(std::span{ shapes }));
+        OpenGL::SetVertexBufferOffset(sdfVao, 1, shapeStream, offset);
+
+        GL::UseProgram(sdfShader.Shader);
+        GL::BindVertexArray(sdfVao);
+        GL::DrawElementsInstanced(GL_TRIANGLES, static_cast<GLsizei>(INDICES_PER_QUAD), GL_UNSIGNED_SHORT, nullptr, static_cast<GLsizei>(shapes.size()));
+
+        ++statistics.DrawCalls;
+        shapes.clear();
+    }
+}
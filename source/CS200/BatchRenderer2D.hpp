@@ -0,0 +1,370 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Matrix.hpp"
+#include "IRenderer2D.hpp"
+#include "OpenGL/Shader.hpp"
+#include "OpenGL/StreamBuffer.hpp"
+#include "OpenGL/VertexArray.hpp"
+#include "Renderer2DUtils.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief Batched 2D renderer that collects sprites and submits them in as few draw calls as possible
+     *
+     * BatchRenderer2D implements the same IRenderer2D contract as ImmediateRenderer2D, but instead of
+     * issuing a full program/uniform/texture/draw sequence for every sprite it transforms each quad on
+     * the CPU and appends its four vertices to a CPU-side vertex list. The list is uploaded and drawn
+     * with a single glDrawElements call whenever the batch has to be broken.
+     *
+     * Up to min(OpenGL::MaxTextureImageUnits, MaxTextureSlots) textures are bound at once. Every quad
+     * carries the index of its texture slot and the fragment shader picks the matching sampler, so
+     * switching between already bound textures does not break the batch. The sampler selection is
+     * generated for the actual slot count and injected into quad.frag when the shader is compiled.
+     *
+     * A batch is flushed when:
+     * - A new texture is needed and every texture slot is already in use
+     * - The CPU vertex list reaches MaxQuadsPerBatch quads
+     * - EndScene() is called
+     *
+     * Quads and shapes whose world AABB does not overlap the BeginScene() view are culled on the CPU
+     * before they reach a batch, see Renderer2DUtils::IsQuadVisible.
+     *
+     * Vertex Format (28 bytes):
+     * - Position (2 floats) already in world space, the view-projection is applied in the vertex shader
+     * - Depth (1 float) in [0, 1]
+     * - Texture coordinate (2 floats) already remapped into the [bl, tr] sub-rectangle
+     * - Tint (4 unsigned bytes) normalized to [0,1] by the vertex attribute
+     * - Texture slot (1 unsigned int)
+     *
+     * Because the index pattern of every quad is identical, the index buffer is generated once in Init()
+     * for the maximum batch size and never touched again.
+     *
+     * Instanced Mode:
+     * Mode::Instanced keeps the unit quad from ImmediateRenderer2D static on the GPU and streams one
+     * compact record per sprite into an instance buffer instead of four vertices. The per-instance
+     * attributes use a vertex attribute divisor of 1 and the batch is drawn with glDrawElementsInstanced.
+     *
+     * Instance Format (56 bytes):
+     * - First two rows of the 2x3 affine model transform (6 floats), applied in the vertex shader
+     * - Texture coordinate rectangle (4 floats) as bottom-left st followed by top-right st
+     * - Depth (1 float) in [0, 1]
+     * - Tint (4 unsigned bytes) normalized to [0,1] by the vertex attribute
+     * - Texture slot (1 unsigned int)
+     *
+     * Shapes:
+     * DrawCircle(), DrawRectangle() and DrawLine() are always instanced, in both modes. Each shape
+     * appends one record to a separate shape list that is drawn over a position-only unit quad by
+     * an anti-aliased SDF shader. Quads and shapes are kept in submission order, so switching from
+     * one kind to the other flushes the pending batch of the other kind.
+     *
+     * Shape Instance Format (60 bytes):
+     * - First two rows of the quad transform grown by the line width (6 floats)
+     * - Shape size and grown quad size in world units (4 floats)
+     * - Fill and outline colors (2 x 4 unsigned bytes) normalized to [0,1] by the vertex attribute
+     * - Outline width and depth (2 floats) and shape kind (1 unsigned int, Renderer2DUtils::SDFShape)
+     *
+     * Streaming:
+     * Quad vertices, quad instances and shape instances all go through one OpenGL::StreamBuffer. Every
+     * flush appends its batch behind the previous one and re-points the streamed attributes at it, so
+     * the GPU can still be drawing earlier batches while the CPU fills the next one. EndScene() ends
+     * the stream's frame.
+     *
+     * Example Usage:
+     * \code
+     * BatchRenderer2D renderer;
+     * renderer.Init();
+     *
+     * renderer.BeginScene(CS200::build_ndc_matrix(screen_size));
+     * for (const auto& sprite : sprites)
+     *     renderer.DrawQuad(sprite.transform, sprite.texture);  // no GL calls here unless the texture slots run out
+     * renderer.EndScene();                                       // remaining quads are drawn here
+     *
+     * const auto& stats = renderer.GetStatistics();              // how many draw calls the frame needed
+     * \endcode
+     */
+    class BatchRenderer2D : public IRenderer2D
+    {
+    public:
+        /**
+         * \brief Number of draw calls and primitives submitted between BeginScene() and EndScene()
+         */
+        struct Statistics
+        {
+            unsigned DrawCalls = 0;
+            unsigned Quads     = 0; ///< visible quads added to a batch
+            unsigned Shapes    = 0; ///< visible circles, rectangles and lines added to a batch
+            unsigned Culled    = 0; ///< quads and shapes rejected because they are outside the view
+        };
+
+        /**
+         * \brief How sprites are encoded for the GPU
+         */
+        enum class Mode
+        {
+            Vertices,  ///< four pre-transformed vertices per sprite
+            Instanced  ///< one instance record per sprite drawn over a static unit quad
+        };
+
+        /**
+         * \brief Largest number of quads submitted by a single draw call
+         *
+         * In Mode::Vertices the 4 vertices per quad must stay addressable by 16 bit indices.
+         */
+        static constexpr unsigned MaxQuadsPerBatch = 8192;
+
+        /**
+         * \brief Largest number of instance records submitted by a single draw call in Mode::Instanced
+         */
+        static constexpr unsigned MaxInstancesPerBatch = 16384;
+
+        /**
+         * \brief Largest number of circles, rectangles and lines submitted by a single draw call
+         */
+        static constexpr unsigned MaxShapesPerBatch = 8192;
+
+        /**
+         * \brief Upper bound of textures bound per batch, the real count is also limited by OpenGL::MaxTextureImageUnits
+         */
+        static constexpr unsigned MaxTextureSlots = 16;
+
+        /**
+         * \brief Size of one region of the stream buffer, holds several full batches of every kind
+         */
+        static constexpr GLsizeiptr StreamBytesPerFrame = 4 * 1024 * 1024;
+
+        /**
+         * \brief Creates an uninitialized renderer, Init() must be called before use
+         * \param render_mode How sprites are encoded for the GPU
+         */
+        explicit BatchRenderer2D(Mode render_mode = Mode::Vertices) noexcept : mode(render_mode)
+        {
+        }
+
+        BatchRenderer2D(const BatchRenderer2D& other) = delete;
+
+        /**
+         * \brief Move constructor - transfer ownership of OpenGL resources
+         * \param other The renderer to move from
+         *
+         * The hot reload watches of the shaders move along, other stops being rebuilt.
+         */
+        BatchRenderer2D(BatchRenderer2D&& other) noexcept;
+
+        BatchRenderer2D& operator=(const BatchRenderer2D& other) = delete;
+
+        /**
+         * \brief Move assignment - swap OpenGL resources with other
+         * \param other The renderer to move from
+         * \return Reference to this object
+         *
+         * Both renderers watch the shader files of the mode they hold afterwards.
+         */
+        BatchRenderer2D& operator=(BatchRenderer2D&& other) noexcept;
+
+        ~BatchRenderer2D() override;
+
+        /**
+         * \brief Initialize OpenGL resources for batched rendering
+         *
+         * Implementation notes:
+         * - Mode::Vertices: static index buffer holding the (0,1,2,2,3,0) pattern for MaxQuadsPerBatch quads
+         *   and a VAO reading position, texture coordinate and normalized tint attributes from the stream buffer
+         * - Mode::Instanced: static unit quad vertex/index buffers plus streamed instance attributes that
+         *   use a divisor of 1
+         * - Load and compile the batch shaders from Assets/shaders/BatchRenderer2D/ with a generated
+         *   TEXTURE_SLOTS / SAMPLE_TEXTURE preamble and point uTextures[i] at texture unit i
+         * - Reserve the CPU vertex/instance list so DrawQuad() never reallocates
+         * - Shapes: position-only unit quad, streamed shape instances and the SDF shaders, sharing the index buffer
+         */
+        void Init() override;
+
+        /**
+         * \brief Clean up all OpenGL resources, safe to call multiple times
+         */
+        void Shutdown() override;
+
+        /**
+         * \brief Begin a new frame with camera/view transformation
+         * \param view_projection Combined view and projection matrix for the frame
+         *
+         * Implementation notes:
+         * - Write the matrix once into the shared Camera uniform block, Renderer2DUtils::PublishCamera()
+         * - Reset the CPU vertex/shape lists and the per-frame statistics
+         */
+        void BeginScene(const Math::TransformationMatrix& view_projection) override;
+
+        /**
+         * \brief Submit every quad or shape still waiting in the CPU lists and end the stream buffer's frame
+         */
+        void EndScene() override;
+
+        /**
+         * \brief Draw the pending batch now, the scene stays open
+         */
+        void Flush() override;
+
+        /**
+         * \brief Append a textured quad to the current batch
+         * \param transform World transformation matrix (position, rotation, scale)
+         * \param texture OpenGL texture handle to sample from
+         * \param texture_coord_bl Bottom-left texture coordinate (typically {0,0})
+         * \param texture_coord_tr Top-right texture coordinate (typically {1,1})
+         * \param tintColor Color to multiply with texture (RGBA::White for no tint)
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         *
+         * Implementation notes:
+         * - Reject the quad without touching the batch when its AABB is outside the view
+         * - Flush first if the batch is full, or if the texture is not bound yet and no slot is free
+         * - Mode::Vertices: transform the four unit quad corners on the CPU and interpolate the
+         *   texture coordinates between bl and tr
+         * - Mode::Instanced: store the affine part of transform and the [bl, tr] rectangle as is
+         * - Pack the tint into the vertex so no uniform change is needed between quads
+         */
+        void DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor, double depth) override;
+
+        /**
+         * \brief Append a circle to the current shape batch
+         * \param transform World transformation matrix, the unit quad is the circle's bounding box
+         * \param fill_color Color inside the outline
+         * \param line_color Color of the outline
+         * \param line_width Outline thickness in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        void DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth) override;
+
+        /**
+         * \brief Append a rectangle to the current shape batch
+         * \param transform World transformation matrix applied to the unit quad
+         * \param fill_color Color inside the outline
+         * \param line_color Color of the outline
+         * \param line_width Outline thickness in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        void DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth) override;
+
+        /**
+         * \brief Append a line segment to the current shape batch as a filled rectangle
+         * \param transform Transformation applied to both end points
+         * \param start_point Start of the line
+         * \param end_point End of the line
+         * \param line_color Color of the line
+         * \param line_width Thickness of the line in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        void DrawLine(const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width, double depth) override;
+
+        using IRenderer2D::DrawLine;
+
+        /**
+         * \brief Statistics of the current (or last completed) scene
+         * \return Draw call, quad and shape counts accumulated since the last BeginScene()
+         */
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        /**
+         * \brief Draw whichever of the quad or shape batch is pending
+         */
+        void flush();
+
+        /**
+         * \brief Upload the CPU vertex/instance list and draw it with a single draw call
+         */
+        void flushQuads();
+
+        /**
+         * \brief Upload the shape instance list and draw it with a single instanced draw call
+         */
+        void flushShapes();
+
+        void initInstancedQuads(OpenGL::PendingShader& pending_shader);
+        void initVertexQuads(OpenGL::PendingShader& pending_shader);
+        void initShapes(OpenGL::PendingShader& pending_shader);
+        void watchShaders();
+
+        void appendShape(const Math::TransformationMatrix& transform, Renderer2DUtils::SDFShape shape, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth);
+
+        [[nodiscard]] unsigned acquireTextureSlot(OpenGL::TextureHandle texture);
+        [[nodiscard]] unsigned batchedQuads() const noexcept;
+        [[nodiscard]] unsigned batchCapacity() const noexcept;
+
+        struct QuadVertex
+        {
+            float         x     = 0.0f;
+            float         y     = 0.0f;
+            float         depth = 0.0f;
+            float         s     = 0.0f;
+            float         t     = 0.0f;
+            std::uint32_t tint{}; // bytes in R,G,B,A memory order
+            std::uint32_t textureSlot{};
+        };
+
+        struct QuadInstance
+        {
+            float         modelRow0[3]{};    // x' = m00 * x + m01 * y + m02
+            float         modelRow1[3]{};    // y' = m10 * x + m11 * y + m12
+            float         texCoordRect[4]{}; // bl.s, bl.t, tr.s, tr.t
+            float         depth = 0.0f;
+            std::uint32_t tint{};
+            std::uint32_t textureSlot{};
+        };
+
+        struct ShapeInstance
+        {
+            float         modelRow0[3]{};
+            float         modelRow1[3]{};
+            float         worldSize[2]{};
+            float         quadSize[2]{};
+            std::uint32_t fillColor{}; // bytes in R,G,B,A memory order
+            std::uint32_t lineColor{};
+            float         lineWidth = 0.0f;
+            float         depth     = 0.0f;
+            std::uint32_t shape{};
+        };
+
+        // a full batch of any kind must fit in one region of the stream buffer
+        static_assert(sizeof(QuadVertex) * 4 * MaxQuadsPerBatch <= StreamBytesPerFrame);
+        static_assert(sizeof(QuadInstance) * MaxInstancesPerBatch <= StreamBytesPerFrame);
+        static_assert(sizeof(ShapeInstance) * MaxShapesPerBatch <= StreamBytesPerFrame);
+
+        Mode mode = Mode::Vertices;
+
+        OpenGL::VertexArrayHandle vao{};
+        OpenGL::BufferHandle      vbo{}; // static unit quad, Mode::Instanced only
+        OpenGL::BufferHandle      ibo{};
+        OpenGL::VertexArrayHandle sdfVao{};
+        OpenGL::BufferHandle      sdfVbo{};
+
+        OpenGL::StreamBuffer stream{};
+        OpenGL::VertexBuffer quadStream{};  // stream handle and the layout of QuadVertex or QuadInstance
+        OpenGL::VertexBuffer shapeStream{}; // stream handle and the layout of ShapeInstance
+        GLuint               quadStreamAttribute = 0;
+
+        OpenGL::CompiledShader quadShader{};
+        OpenGL::CompiledShader sdfShader{};
+
+        std::vector<QuadVertex>                            vertices{};
+        std::vector<QuadInstance>                          instances{};
+        std::vector<ShapeInstance>                         shapes{};
+        std::array<OpenGL::TextureHandle, MaxTextureSlots> batchTextures{};
+        unsigned                                           batchTextureCount = 0;
+        unsigned                                           textureSlotCount  = 1;
+        Math::TransformationMatrix                         viewProjection;
+        Statistics                                         statistics{};
+    };
+}
@@ -0,0 +1,91 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "CompressedImage.hpp"
+#include "Engine/Path.hpp"
+#include "KTX.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+#include <string>
+
+namespace CS200
+{
+    CompressedImage::CompressedImage(const std::filesystem::path& ktx_path)
+    {
+        std::span<const std::byte> bytes;
+        std::string                name = ktx_path.string();
+        if (const auto packed = assets::find_packed(ktx_path))
+        {
+            // the archive stays mapped for the whole run, the levels point into it like they would into the mapped file
+            bytes = *packed;
+        }
+        else
+        {
+            const std::filesystem::path located = assets::locate_asset(ktx_path);
+            if (!file.Open(located))
+            {
+                throw std::runtime_error("Failed to map " + located.string());
+            }
+            bytes = file.GetBytes();
+            name  = located.string();
+        }
+
+        ktx::Header header;
+        if (bytes.size() < sizeof(header))
+        {
+            throw std::runtime_error("Truncated KTX header in " + name);
+        }
+        std::memcpy(&header, bytes.data(), sizeof(header));
+        if (header.identifier != ktx::Identifier || header.endianness != ktx::Endianness)
+        {
+            throw std::runtime_error("Not a little-endian KTX 1.1 file: " + name);
+        }
+        if (header.glType != 0 || header.glFormat != 0 || header.pixelDepth > 1 || header.numberOfArrayElements > 1 || header.numberOfFaces != 1 || header.pixelWidth == 0 ||
+            header.pixelHeight == 0)
+        {
+            throw std::runtime_error("Only single 2D compressed KTX textures are supported: " + name);
+        }
+
+        if (header.pixelWidth > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) || header.pixelHeight > static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+        {
+            throw std::runtime_error("KTX texture too large: " + name);
+        }
+        // a full chain goes down to 1×1, floor(log2(largest side)) + 1 levels
+        const auto max_mip_count = static_cast<std::uint32_t>(std::bit_width(std::max(header.pixelWidth, header.pixelHeight)));
+        const auto mip_count     = std::max(header.numberOfMipmapLevels, 1u);
+        if (mip_count > max_mip_count)
+        {
+            throw std::runtime_error("Too many KTX mipmap levels in " + name);
+        }
+
+        format             = header.glInternalFormat;
+        std::size_t offset = sizeof(header) + header.bytesOfKeyValueData;
+        Math::ivec2 size{ static_cast<int>(header.pixelWidth), static_cast<int>(header.pixelHeight) };
+        levels.reserve(mip_count);
+        for (std::uint32_t level = 0; level < mip_count; ++level)
+        {
+            std::uint32_t image_size = 0;
+            if (offset + sizeof(image_size) > bytes.size())
+            {
+                throw std::runtime_error("Truncated KTX level in " + name);
+            }
+            std::memcpy(&image_size, bytes.data() + offset, sizeof(image_size));
+            offset += sizeof(image_size);
+            if (offset + image_size > bytes.size())
+            {
+                throw std::runtime_error("Truncated KTX level in " + name);
+            }
+
+            levels.push_back(Level{ size, bytes.subspan(offset, image_size) });
+            offset += (image_size + 3u) & ~3u;
+            size = Math::ivec2{ std::max(size.x / 2, 1), std::max(size.y / 2, 1) };
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/MappedFile.hpp"
+#include "Engine/Vec2.hpp"
+#include "OpenGL/GLTypes.hpp"
+#include <cstddef>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief Block compressed texture data read from a KTX file
+     *
+     * The counterpart of CS200::Image for files produced by the texture_compressor tool. The file is
+     * memory mapped and every mipmap level is a view into the mapping, so the blocks go to
+     * glCompressedTexImage2D without being copied first.
+     *
+     * Example Usage:
+     * \code
+     * CS200::CompressedImage image("Assets/images/ship.s3tc.ktx");
+     * if (OpenGL::IsCompressedFormatSupported(image.GetFormat(), image.GetSize()))
+     *     texture = OpenGL::CreateTextureFromCompressedImage(image);
+     * \endcode
+     */
+    class CompressedImage
+    {
+    public:
+        /**
+         * \brief One mipmap level, level 0 first
+         */
+        struct Level
+        {
+            Math::ivec2                Size{};
+            std::span<const std::byte> Blocks{};
+        };
+
+        /**
+         * \brief Map and validate a KTX file
+         * \param ktx_path Path to the file, located like CS200::Image does, viewed in place when it is in Assets.pak
+         *
+         * Throws std::runtime_error when the file is missing, truncated or not a compressed 2D KTX 1.1 file.
+         */
+        explicit CompressedImage(const std::filesystem::path& ktx_path);
+
+        CompressedImage(const CompressedImage&)            = delete;
+        CompressedImage& operator=(const CompressedImage&) = delete;
+
+        CompressedImage(CompressedImage&& temporary) noexcept            = default;
+        CompressedImage& operator=(CompressedImage&& temporary) noexcept = default;
+
+        ~CompressedImage() = default;
+
+        /**
+         * \brief glInternalFormat of the blocks, for example GL_COMPRESSED_RGBA8_ETC2_EAC
+         */
+        [[nodiscard]] GLenum GetFormat() const noexcept
+        {
+            return format;
+        }
+
+        /**
+         * \brief Size of level 0 in pixels
+         */
+        [[nodiscard]] Math::ivec2 GetSize() const noexcept
+        {
+            return levels.empty() ? Math::ivec2{} : levels.front().Size;
+        }
+
+        [[nodiscard]] std::span<const Level> GetLevels() const noexcept
+        {
+            return levels;
+        }
+
+    private:
+        util::MappedFile   file{};
+        GLenum             format = 0;
+        std::vector<Level> levels{};
+    };
+}
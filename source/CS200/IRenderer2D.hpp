@@ -7,15 +7,11 @@
  */
 #pragma once
 
+#include "Engine/Matrix.hpp"
 #include "Engine/Vec2.hpp"
 #include "OpenGL/Texture.hpp"
 #include "RGBA.hpp"
 
-namespace Math
-{
-    class TransformationMatrix;
-}
-
 namespace CS200
 {
     /**
@@ -124,6 +120,14 @@ namespace CS200
          */
         virtual void EndScene() = 0;
 
+        /**
+         * \brief Submit everything drawn so far without ending the scene
+         *
+         * Renderers that defer their GL work (batching, sorting) draw what they have collected.
+         * Call it before changing GL state that must only affect the draws that come after.
+         */
+        virtual void Flush() = 0;
+
         /**
          * \brief Draw a textured quadrilateral with transformation and tinting
          * \param transform World transformation matrix (position, rotation, scale)
@@ -131,15 +135,69 @@ namespace CS200
          * \param texture_coord_bl Bottom-left UV coordinate (default: {0,0})
          * \param texture_coord_tr Top-right UV coordinate (default: {1,1})
          * \param tintColor Color to multiply with texture samples (default: white)
+         * \param depth Distance from the viewer in [0, 1], 0 is the front (default: 0)
          *
          * Renders a textured quad that can represent sprites, backgrounds, or UI elements.
          * The quad is defined in local coordinates from -0.5 to 0.5, then transformed
          * by the given matrix.
          *
+         * The depth is written to the depth buffer, it only changes the result while
+         * GL_DEPTH_TEST is enabled (see RenderQueue2D::SetDepthPasses).
          */
         virtual void DrawQuad(
             const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl = Math::vec2{ 0.0, 0.0 }, Math::vec2 texture_coord_tr = Math::vec2{ 1.0, 1.0 },
-            CS200::RGBA tintColor = CS200::WHITE) = 0;
+            CS200::RGBA tintColor = CS200::WHITE, double depth = 0.0) = 0;
+
+        /**
+         * \brief Draw an anti-aliased circle with a fill color and an outline
+         * \param transform World transformation matrix, the unit quad (-0.5 to 0.5) is the circle's bounding box
+         * \param fill_color Color inside the outline (CS200::CLEAR for an outline only)
+         * \param line_color Color of the outline
+         * \param line_width Outline thickness in world units, centered on the circle's edge (0 for no outline)
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         *
+         * The circle is evaluated per pixel with a signed distance function, so it stays smooth
+         * at any scale. Non-uniform scales use the smaller axis as the diameter.
+         */
+        virtual void DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color = CS200::WHITE, CS200::RGBA line_color = CS200::BLACK, double line_width = 2.0, double depth = 0.0) = 0;
+
+        /**
+         * \brief Draw an anti-aliased rectangle with a fill color and an outline
+         * \param transform World transformation matrix applied to the unit quad (-0.5 to 0.5)
+         * \param fill_color Color inside the outline (CS200::CLEAR for an outline only)
+         * \param line_color Color of the outline
+         * \param line_width Outline thickness in world units, centered on the rectangle's edge (0 for no outline)
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        virtual void DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color = CS200::WHITE, CS200::RGBA line_color = CS200::BLACK, double line_width = 2.0, double depth = 0.0) = 0;
+
+        /**
+         * \brief Draw an anti-aliased line segment
+         * \param transform Transformation applied to both end points
+         * \param start_point Start of the line in the transform's local space
+         * \param end_point End of the line in the transform's local space
+         * \param line_color Color of the line
+         * \param line_width Thickness of the line in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         *
+         * The segment is turned into a rotated rectangle with Renderer2DUtils::CalculateLineTransform
+         * and drawn with the same SDF shader as DrawRectangle().
+         */
+        virtual void DrawLine(
+            const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color = CS200::WHITE, double line_width = 1.0, double depth = 0.0) = 0;
+
+        /**
+         * \brief Draw an anti-aliased line segment given directly in world coordinates
+         * \param start_point Start of the line
+         * \param end_point End of the line
+         * \param line_color Color of the line
+         * \param line_width Thickness of the line in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        void DrawLine(Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color = CS200::WHITE, double line_width = 1.0, double depth = 0.0)
+        {
+            DrawLine(Math::TransformationMatrix{}, start_point, end_point, line_color, line_width, depth);
+        }
     };
 
 }
@@ -7,27 +7,90 @@
  * \copyright DigiPen Institute of Technology
  */
 #include "Image.hpp"
+#include "ImageCache.hpp"
+#include "Mipmap.hpp"
 #include "Engine/Error.hpp"
 #include "Engine/Path.hpp"
 #include "OpenGL/GL.hpp"
 #include <stb_image.h>
+#include <utility>
 
 namespace CS200
 {
 
-    Image::Image(const std::filesystem::path& image_path, bool flip_vertical)
+    Image::Image(const std::filesystem::path& image_path, bool flip_vertical, bool build_mipmaps)
     {
-        stbi_set_flip_vertically_on_load(flip_vertical);
+        if (const auto packed = assets::find_packed(image_path))
+        {
+            // decoded straight from the mapped archive, there is no source file for the image cache to check against
+            stbi_set_flip_vertically_on_load_thread(flip_vertical);
+            data_ = stbi_load_from_memory(reinterpret_cast<const stbi_uc*>(packed->data()), gsl::narrow<int>(packed->size()), &width, &height, &file_num_channels, num_channels);
+            if (!data_)
+            {
+                throw std::runtime_error("Failed to load image " + image_path.string());
+            }
+            if (build_mipmaps)
+            {
+                buildMipChain();
+            }
+            return;
+        }
+
         const std::filesystem::path image_ = assets::locate_asset(image_path);
-        data_                              = stbi_load(image_.string().c_str(), &width, &height, &file_num_channels, num_channels);
+        if (auto cached = load_cached_image(image_, flip_vertical, build_mipmaps))
+        {
+            // texels used in place from the mapped cache file, no decode and no copy
+            mapping           = std::move(cached->File);
+            data_             = reinterpret_cast<unsigned char*>(cached->Texels);
+            width             = cached->Size.x;
+            height            = cached->Size.y;
+            file_num_channels = num_channels;
+            mipChain          = cached->MipChain;
+            return;
+        }
+
+        stbi_set_flip_vertically_on_load_thread(flip_vertical);
+        data_ = stbi_load(image_.string().c_str(), &width, &height, &file_num_channels, num_channels);
 
         if (!data_)
         {
             throw std::runtime_error("Failed to load image");
         }
+        if (build_mipmaps)
+        {
+            buildMipChain();
+        }
+        store_cached_image(image_, flip_vertical, GetSize(), std::span(data(), static_cast<std::size_t>(width) * static_cast<std::size_t>(height)), mipChain);
+    }
+
+    void Image::buildMipChain()
+    {
+        // runs wherever the image is decoded, for TextureManager that is a worker thread
+        mipStorage.resize(mip_chain_texel_count(GetSize()));
+        build_mip_chain(GetSize(), std::span(data(), static_cast<std::size_t>(width) * static_cast<std::size_t>(height)), mipStorage);
+        mipChain = mipStorage;
     }
 
-    Image::Image(Image&& temporary) noexcept
+    std::optional<Math::ivec2> Image::ReadSize(const std::filesystem::path& image_path)
+    {
+        Math::ivec2 size{};
+        int         channels = 0;
+        if (const auto packed = assets::find_packed(image_path))
+        {
+            if (stbi_info_from_memory(reinterpret_cast<const stbi_uc*>(packed->data()), gsl::narrow<int>(packed->size()), &size.x, &size.y, &channels) == 0)
+            {
+                return std::nullopt;
+            }
+            return size;
+        }
+        if (!assets::asset_exists(image_path) || stbi_info(assets::locate_asset(image_path).string().c_str(), &size.x, &size.y, &channels) == 0)
+        {
+            return std::nullopt;
+        }
+        return size;
+    }
+
+    Image::Image(Image&& temporary) noexcept : mapping(std::move(temporary.mapping)), mipStorage(std::move(temporary.mipStorage)), mipChain(std::exchange(temporary.mipChain, {}))
     {
         data_             = temporary.data_;
         width             = temporary.width;
@@ -46,13 +109,16 @@ namespace CS200
             std::swap(width, temporary.width);
             std::swap(height, temporary.height);
             std::swap(file_num_channels, temporary.file_num_channels);
+            std::swap(mapping, temporary.mapping);
+            std::swap(mipStorage, temporary.mipStorage);
+            std::swap(mipChain, temporary.mipChain);
         }
         return *this;
     }
 
     Image::~Image()
     {
-        if (data_ != nullptr)
+        if (data_ != nullptr && !mapping)
         {
             stbi_image_free(data_);
         }
@@ -73,4 +139,9 @@ namespace CS200
         return { width, height };
     }
 
+    std::span<const RGBA> Image::GetMipChain() const noexcept
+    {
+        return mipChain;
+    }
+
 }
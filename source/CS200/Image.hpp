@@ -8,12 +8,16 @@
  */
 #pragma once
 
+#include "Engine/MappedFile.hpp"
 #include "Engine/Vec2.hpp"
 #include "OpenGL/Handle.hpp"
 #include "RGBA.hpp"
 #include <GL/glew.h>
 #include <filesystem>
 #include <gsl/gsl>
+#include <optional>
+#include <span>
+#include <vector>
 
 namespace CS200
 {
@@ -30,6 +34,7 @@ namespace CS200
      * - RAII memory management (automatic cleanup in destructor)
      * - Move-only semantics to prevent expensive copying
      * - Optional vertical flipping for different coordinate systems
+     * - Decoded texels are cached on disk, later runs map them instead of decoding
      *
      * Common Use Cases:
      * - Loading textures for sprites, backgrounds, UI elements
@@ -66,16 +71,21 @@ namespace CS200
          * \brief Load an image from file and store its pixel data
          * \param image_path Path to the image file (relative to Assets folder, like "Assets/ship.png")
          * \param flip_vertical Whether to flip the image vertically when loading (default: false)
+         * \param build_mipmaps Also compute the smaller mipmap levels, see GetMipChain() (default: false)
          *
          * Implementation notes:
-         * - Use assets::locate_asset() to find the full file path
+         * - Decode from memory with stbi_load_from_memory() when assets::find_packed() has the image
+         * - Otherwise use assets::locate_asset() to find the full file path
          * - Use stb_image library functions to load the image data
          * - Always load as 4-channel RGBA regardless of source format
-         * - Set stbi_set_flip_vertically_on_load() before loading
+         * - Set stbi_set_flip_vertically_on_load_thread() before loading, the per-thread
+         *   setting lets worker threads decode images with different flip settings at once
          * - Throw an error if loading fails
          * - Store the loaded pixel data and image dimensions
+         * - With build_mipmaps, take the chain from the image cache or build it with
+         *   CS200::build_mip_chain() and cache it along with the texels
          */
-        explicit Image(const std::filesystem::path& image_path, bool flip_vertical = false);
+        explicit Image(const std::filesystem::path& image_path, bool flip_vertical = false, bool build_mipmaps = false);
 
         /**
          * \brief Copy constructor - deleted to prevent accidental copying
@@ -150,13 +160,36 @@ namespace CS200
          */
         Math::ivec2 GetSize() const noexcept;
 
+        /**
+         * \brief Get the mipmap levels below level 0
+         * \return Level 1 down to 1×1, one after the other as CS200::build_mip_chain() lays them out,
+         *         empty unless the image was loaded with build_mipmaps
+         *
+         * OpenGL::CreateTextureFromImage() uploads these instead of filtering the image again.
+         */
+        std::span<const RGBA> GetMipChain() const noexcept;
+
+        /**
+         * \brief Read the dimensions of an image file without decoding it
+         * \param image_path Same path the constructor takes
+         * \return Width and height in pixels, std::nullopt when the file is missing or stb_image cannot read it
+         *
+         * Only the header is parsed with stbi_info(), cheap enough for the main thread. TextureManager
+         * sizes the staging memory of an upload with it before the decode starts on a worker.
+         */
+        [[nodiscard]] static std::optional<Math::ivec2> ReadSize(const std::filesystem::path& image_path);
+
     private:
+        void buildMipChain();
 
-        unsigned char* data_;
-        int            width;
-        int            height;
-        int            file_num_channels;
-        int            num_channels = 4;
+        unsigned char*        data_;
+        int                   width;
+        int                   height;
+        int                   file_num_channels;
+        int                   num_channels = 4;
+        util::MappedFile      mapping{};    // open when data_ points into a cache file instead of stb_image memory
+        std::vector<RGBA>     mipStorage{}; // the chain when it was built here rather than mapped from the cache
+        std::span<const RGBA> mipChain{};
     };
 
 }
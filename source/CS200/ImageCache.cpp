@@ -0,0 +1,196 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ImageCache.hpp"
+#include "Engine/Hash.hpp"
+#include "Engine/Path.hpp"
+#include "Mipmap.hpp"
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr std::array<char, 4> MAGIC   = { 'C', 'S', 'T', 'X' };
+    constexpr std::uint32_t       VERSION = 1;
+
+    enum Flags : std::uint32_t
+    {
+        FLIPPED_VERTICALLY = 1u << 0,
+        MIPMAPPED          = 1u << 1 // the levels below level 0 follow its texels
+    };
+
+    // 48 bytes so the texels that follow stay 16 byte aligned in the mapping
+    struct Header
+    {
+        std::array<char, 4> Magic{};
+        std::uint32_t       Version    = 0;
+        std::uint32_t       Width      = 0;
+        std::uint32_t       Height     = 0;
+        std::uint32_t       Flags      = 0;
+        std::uint32_t       Reserved   = 0;
+        std::int64_t        SourceTime = 0;
+        std::uint64_t       SourceSize = 0;
+        std::uint64_t       PathHash   = 0;
+    };
+
+    static_assert(sizeof(Header) == 48);
+
+    std::uint64_t hash_path(const fs::path& source_path) noexcept
+    {
+        return util::hash_bytes(source_path.generic_string());
+    }
+
+    std::uint32_t flags_for(bool flip_vertical, bool mipmapped) noexcept
+    {
+        return (flip_vertical ? FLIPPED_VERTICALLY : 0u) | (mipmapped ? MIPMAPPED : 0u);
+    }
+
+    fs::path entry_path(std::uint64_t path_hash, std::uint32_t flags)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx_%u.texels", static_cast<unsigned long long>(path_hash), flags);
+        return assets::get_cache_path() / name;
+    }
+
+    // the size and time of the source file, what a cache entry is validated against
+    bool stat_source(const fs::path& source_path, std::int64_t& time, std::uint64_t& size) noexcept
+    {
+        std::error_code error;
+        const auto      write_time = fs::last_write_time(source_path, error);
+        if (error)
+        {
+            return false;
+        }
+        const auto file_size = fs::file_size(source_path, error);
+        if (error)
+        {
+            return false;
+        }
+        time = write_time.time_since_epoch().count();
+        size = file_size;
+        return true;
+    }
+}
+
+namespace CS200
+{
+    std::optional<CachedImage> load_cached_image(const std::filesystem::path& source_path, bool flip_vertical, bool mipmapped)
+    {
+#if defined(__EMSCRIPTEN__)
+        // the web file system is rebuilt every run, a cache would never be read back
+        static_cast<void>(source_path);
+        static_cast<void>(flip_vertical);
+        static_cast<void>(mipmapped);
+        return std::nullopt;
+#else
+        std::int64_t  source_time = 0;
+        std::uint64_t source_size = 0;
+        if (!stat_source(source_path, source_time, source_size))
+        {
+            return std::nullopt;
+        }
+
+        const std::uint64_t path_hash = hash_path(source_path);
+        const std::uint32_t flags     = flags_for(flip_vertical, mipmapped);
+        CachedImage         cached;
+        if (!cached.File.Open(entry_path(path_hash, flags)))
+        {
+            return std::nullopt;
+        }
+
+        const auto bytes = cached.File.GetBytes();
+        if (bytes.size() < sizeof(Header))
+        {
+            return std::nullopt;
+        }
+        Header header;
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+
+        if (header.Magic != MAGIC || header.Version != VERSION || header.Flags != flags || header.PathHash != path_hash || header.SourceTime != source_time || header.SourceSize != source_size ||
+            header.Width > static_cast<std::uint32_t>(std::numeric_limits<int>::max()) || header.Height > static_cast<std::uint32_t>(std::numeric_limits<int>::max()))
+        {
+            return std::nullopt;
+        }
+        const Math::ivec2   size{ static_cast<int>(header.Width), static_cast<int>(header.Height) };
+        const std::uint64_t level0_texels = std::uint64_t{ header.Width } * header.Height;
+        const std::uint64_t chain_texels  = mipmapped ? mip_chain_texel_count(size) : 0;
+        if (bytes.size() != sizeof(Header) + (level0_texels + chain_texels) * sizeof(RGBA))
+        {
+            return std::nullopt;
+        }
+
+        cached.Size     = size;
+        cached.Texels   = reinterpret_cast<RGBA*>(bytes.data() + sizeof(Header));
+        cached.MipChain = std::span(cached.Texels + level0_texels, static_cast<std::size_t>(chain_texels));
+        return cached;
+#endif
+    }
+
+    void store_cached_image(const std::filesystem::path& source_path, bool flip_vertical, Math::ivec2 size, std::span<const RGBA> texels, std::span<const RGBA> mip_chain) noexcept
+    {
+#if defined(__EMSCRIPTEN__)
+        static_cast<void>(source_path);
+        static_cast<void>(flip_vertical);
+        static_cast<void>(size);
+        static_cast<void>(texels);
+        static_cast<void>(mip_chain);
+#else
+        try
+        {
+            Header header;
+            header.Magic    = MAGIC;
+            header.Version  = VERSION;
+            header.Width    = static_cast<std::uint32_t>(size.x);
+            header.Height   = static_cast<std::uint32_t>(size.y);
+            header.Flags    = flags_for(flip_vertical, !mip_chain.empty());
+            header.PathHash = hash_path(source_path);
+            if (!stat_source(source_path, header.SourceTime, header.SourceSize))
+            {
+                return;
+            }
+
+            const fs::path final_path = entry_path(header.PathHash, header.Flags);
+            fs::path       temporary  = final_path;
+            // thread ids repeat across processes, the random part keeps two running copies apart
+            temporary += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ std::random_device{}()) + ".tmp";
+            {
+                std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+                file.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+                file.write(reinterpret_cast<const char*>(texels.data()), static_cast<std::streamsize>(texels.size_bytes()));
+                file.write(reinterpret_cast<const char*>(mip_chain.data()), static_cast<std::streamsize>(mip_chain.size_bytes()));
+                if (!file)
+                {
+                    file.close();
+                    fs::remove(temporary);
+                    return;
+                }
+            }
+            // fails on Windows while another run still maps the old entry, it gets replaced next time
+            std::error_code error;
+            fs::rename(temporary, final_path, error);
+            if (error)
+            {
+                fs::remove(temporary, error);
+            }
+        }
+        catch (const std::exception&)
+        {
+            // a missing cache entry only costs a decode
+        }
+#endif
+    }
+}
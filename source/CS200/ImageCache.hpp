@@ -0,0 +1,59 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/MappedFile.hpp"
+#include "Engine/Vec2.hpp"
+#include "RGBA.hpp"
+#include <filesystem>
+#include <optional>
+#include <span>
+
+namespace CS200
+{
+    /**
+     * \brief Decoded texels of an image, read from the cache without decoding or copying
+     *
+     * Texels and MipChain point into File, they stay valid as long as File is open.
+     */
+    struct CachedImage
+    {
+        util::MappedFile File{};
+        Math::ivec2      Size{};
+        RGBA*            Texels = nullptr;
+        std::span<RGBA>  MipChain{}; ///< levels 1 and below as CS200::build_mip_chain() lays them out, empty unless requested
+    };
+
+    /**
+     * \brief Map the cached texels of an image file
+     * \param source_path Resolved path of the source image
+     * \param flip_vertical Load option the texels were stored with
+     * \param mipmapped true for the entry that also holds the mip chain
+     * \return The texels, or std::nullopt when nothing is cached or the source changed since
+     *
+     * Cache files live in assets::get_cache_path(), one per source path and load options. Each starts
+     * with a small header recording the image size and the size and modification time of the source,
+     * followed by the RGBA texels exactly as CS200::Image would hold them and, for a mipmapped entry,
+     * the smaller levels. An entry is only used when the recorded source size and time still match
+     * the file on disk.
+     */
+    [[nodiscard]] std::optional<CachedImage> load_cached_image(const std::filesystem::path& source_path, bool flip_vertical, bool mipmapped = false);
+
+    /**
+     * \brief Write the decoded texels of an image file to the cache
+     * \param source_path Resolved path of the source image
+     * \param flip_vertical Load option the texels were decoded with
+     * \param size Image dimensions in pixels
+     * \param texels size.x * size.y RGBA values
+     * \param mip_chain Output of CS200::build_mip_chain() for a mipmapped entry, empty otherwise
+     *
+     * Failures are ignored, the image is simply decoded again next time. The entry is written to a
+     * temporary file and renamed into place, so concurrent loads never map a half written entry.
+     */
+    void store_cached_image(const std::filesystem::path& source_path, bool flip_vertical, Math::ivec2 size, std::span<const RGBA> texels, std::span<const RGBA> mip_chain = {}) noexcept;
+}
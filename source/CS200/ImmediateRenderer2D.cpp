@@ -13,21 +13,16 @@
 #include "OpenGL/Buffer.hpp"
 #include "OpenGL/GL.hpp"
 #include "Renderer2DUtils.hpp"
+#include <cstdint>
 #include <utility>
 
 namespace CS200
 {
     ImmediateRenderer2D::ImmediateRenderer2D(ImmediateRenderer2D&& other) noexcept
-        : vao(other.vao), ibo(other.ibo), vbo(other.vbo), indicesCount(other.indicesCount), uniformBlock(other.uniformBlock), sdfVao(other.sdfVao), sdfVbo(other.sdfVbo), uboCamera(other.uboCamera),
-          viewProjection(other.viewProjection), textureShader(std::move(other.textureShader)), sdfShader(std::move(other.sdfShader))
+        : geometry(std::exchange(other.geometry, nullptr)), unitQuad(other.unitQuad), uniformBlock(other.uniformBlock), textureShader(std::move(other.textureShader)), textureUniforms(other.textureUniforms),
+          sdfShader(std::move(other.sdfShader)), sdfUniforms(other.sdfUniforms), viewProjection(other.viewProjection), statistics(other.statistics)
     {
-        other.vao          = 0;
-        other.vbo          = 0;
-        other.ibo          = 0;
-        other.indicesCount = 0;
-        other.sdfVao       = 0;
-        other.sdfVbo       = 0;
-        other.uboCamera    = 0;
+        other.unitQuad     = {};
         other.uniformBlock = 0;
     }
 
@@ -35,17 +30,15 @@ namespace CS200
     {
         if (this != &other)
         {
-            std::swap(vao, other.vao);
-            std::swap(vbo, other.vbo);
-            std::swap(ibo, other.ibo);
-            std::swap(indicesCount, other.indicesCount);
-            std::swap(sdfVao, other.sdfVao);
+            std::swap(geometry, other.geometry);
+            std::swap(unitQuad, other.unitQuad);
             std::swap(uniformBlock, other.uniformBlock);
-            std::swap(sdfVbo, other.sdfVbo);
-            std::swap(uboCamera, other.uboCamera);
             std::swap(viewProjection, other.viewProjection);
             std::swap(textureShader, other.textureShader);
+            std::swap(textureUniforms, other.textureUniforms);
             std::swap(sdfShader, other.sdfShader);
+            std::swap(sdfUniforms, other.sdfUniforms);
+            std::swap(statistics, other.statistics);
         }
 
         return *this;
@@ -66,29 +59,39 @@ namespace CS200
 
     void ImmediateRenderer2D::Init()
     {
-        const std::array<unsigned int, 6> indices  = { 0, 1, 2, 2, 3, 0 };
-        const std::array<Vertex, 4>       vertices = {
+        // both programs build on driver threads while the geometry is uploaded
+        using filepath                        = std::filesystem::path;
+        OpenGL::PendingShader pending_texture = OpenGL::CreateShaderAsync(filepath{ "Assets/shaders/ImmediateRenderer2D/quad.vert" }, filepath{ "Assets/shaders/ImmediateRenderer2D/quad.frag" });
+        OpenGL::PendingShader pending_sdf     = OpenGL::CreateShaderAsync(filepath{ "Assets/shaders/ImmediateRenderer2D/sdf.vert" }, filepath{ "Assets/shaders/ImmediateRenderer2D/sdf.frag" });
+
+        const std::array<std::uint32_t, 6> indices  = { 0, 1, 2, 2, 3, 0 };
+        const std::array<Vertex, 4>        vertices = {
             Vertex{ -0.5f, -0.5f, 0.0f, 0.0f },
             Vertex{  0.5f, -0.5f, 1.0f, 0.0f },
             Vertex{  0.5f,  0.5f, 1.0f, 1.0f },
             Vertex{ -0.5f,  0.5f, 0.0f, 1.0f }
         };
 
-        vbo          = OpenGL::CreateBuffer(OpenGL::BufferType::Vertices, std::as_bytes(std::span{ vertices }));
-        ibo          = OpenGL::CreateBuffer(OpenGL::BufferType::Indices, std::as_bytes(std::span{ indices }));
-        indicesCount = static_cast<GLsizei>(indices.size());
-
-
         const auto layout = OpenGL::BufferLayout{
             { OpenGL::Attribute::Float2, OpenGL::Attribute::Float2 }
         };
 
-        const auto vertex_buffer = OpenGL::VertexBuffer{ vbo, layout };
+        // one small mesh, it shares the buffers and VAO of every other mesh with this layout
+        geometry = &OpenGL::GetSharedGeometryArena(layout);
+        unitQuad = geometry->Add(std::as_bytes(std::span{ vertices }), indices);
+
+        textureShader = pending_texture.Get();
+
+        constexpr std::array<OpenGL::UniformName, QuadUniformCount> quad_uniform_names = { "uModel", "uTexCoordTransform", "uTint", "uDepth", "uTexture" };
+        textureUniforms = OpenGL::ResolveUniforms(textureShader, quad_uniform_names);
 
-        vao = OpenGL::CreateVertexArrayObject(vertex_buffer, ibo);
+        sdfShader = pending_sdf.Get();
 
-        using filepath = std::filesystem::path;
-        textureShader  = OpenGL::CreateShader(filepath{ "Assets/shaders/ImmediateRenderer2D/quad.vert" }, filepath{ "Assets/shaders/ImmediateRenderer2D/quad.frag" });
+        constexpr std::array<OpenGL::UniformName, SDFUniformCount> sdf_uniform_names = { "uModel", "uWorldSize", "uQuadSize", "uFillColor", "uLineColor", "uLineWidth", "uShape", "uDepth" };
+        sdfUniforms = OpenGL::ResolveUniforms(sdfShader, sdf_uniform_names);
+
+        OpenGL::SetUniformBlockBinding(textureShader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera");
+        OpenGL::SetUniformBlockBinding(sdfShader.Shader, Renderer2DUtils::CameraBlockBinding, "Camera");
     }
 
     void ImmediateRenderer2D::Shutdown()
@@ -96,37 +99,44 @@ namespace CS200
         OpenGL::DestroyShader(textureShader);
         OpenGL::DestroyShader(sdfShader);
 
-        GL::DeleteBuffers(1, &vbo);
-        GL::DeleteBuffers(1, &ibo);
         GL::DeleteBuffers(1, &uniformBlock);
-        GL::DeleteBuffers(1, &sdfVbo);
-
-        GL::DeleteVertexArrays(1, &vao);
-        GL::DeleteVertexArrays(1, &sdfVao);
+        if (geometry != nullptr)
+        {
+            geometry->Remove(unitQuad);
+            geometry = nullptr;
+        }
 
         textureShader = {};
         uniformBlock  = {};
         sdfShader     = {};
-        vbo           = {};
-        ibo           = {};
-        sdfVbo        = {};
-        uboCamera     = {};
-        vao           = {};
-        sdfVao        = {};
-        indicesCount  = 0;
+        unitQuad      = {};
     }
 
     void ImmediateRenderer2D::BeginScene(const Math::TransformationMatrix& view_projection)
     {
         this->viewProjection = view_projection;
+        statistics           = {};
+
+        // written once per scene, every 2D shader reads it through the shared Camera block
+        Renderer2DUtils::PublishCamera(view_projection);
     }
 
     void ImmediateRenderer2D::EndScene()
     {
     }
 
-    void ImmediateRenderer2D::DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor)
+    void ImmediateRenderer2D::Flush()
     {
+    }
+
+    void ImmediateRenderer2D::DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor, double depth)
+    {
+        if (!Renderer2DUtils::IsQuadVisible(viewProjection, transform))
+        {
+            ++statistics.Culled;
+            return;
+        }
+
         GL::UseProgram(textureShader.Shader);
 
         const Math::vec2                 tex_scale          = texture_coord_tr - texture_coord_bl;
@@ -134,21 +144,64 @@ namespace CS200
 
         const std::array<float, 9> model      = CS200::Renderer2DUtils::to_opengl_mat3(transform);
         const std::array<float, 9> tex_mat    = CS200::Renderer2DUtils::to_opengl_mat3(texcoord_transform);
-        const std::array<float, 9> view_proj  = CS200::Renderer2DUtils::to_opengl_mat3(viewProjection);
         const std::array<float, 4> tint_array = CS200::unpack_color(tintColor);
 
-        GL::UniformMatrix3fv(textureShader.UniformLocations.at("uModel"), 1, GL_FALSE, model.data());
-        GL::UniformMatrix3fv(textureShader.UniformLocations.at("uTexCoordTransform"), 1, GL_FALSE, tex_mat.data());
-        GL::UniformMatrix3fv(textureShader.UniformLocations.at("uViewProjection"), 1, GL_FALSE, view_proj.data());
-        GL::Uniform4fv(textureShader.UniformLocations.at("uTint"), 1, tint_array.data());
-        GL::Uniform1f(textureShader.UniformLocations.at("uDepth"), 0.0f);
-        GL::Uniform1i(textureShader.UniformLocations.at("uTexture"), 0);
+        GL::UniformMatrix3fv(textureUniforms[QuadModel], 1, GL_FALSE, model.data());
+        GL::UniformMatrix3fv(textureUniforms[QuadTexCoordTransform], 1, GL_FALSE, tex_mat.data());
+        GL::Uniform4fv(textureUniforms[QuadTint], 1, tint_array.data());
+        GL::Uniform1f(textureUniforms[QuadDepth], static_cast<float>(depth));
+        GL::Uniform1i(textureUniforms[QuadTexture], 0);
 
         GL::ActiveTexture(GL_TEXTURE0);
         GL::BindTexture(GL_TEXTURE_2D, texture);
-        GL::BindVertexArray(vao);
-        GL::DrawElements(GL_TRIANGLES, indicesCount, GL_UNSIGNED_INT, nullptr);
+        geometry->Draw(unitQuad);
+        ++statistics.DrawCalls;
+    }
+
+    void ImmediateRenderer2D::DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        drawSDF(transform, Renderer2DUtils::SDFShape::Circle, fill_color, line_color, line_width, depth);
+    }
+
+    void ImmediateRenderer2D::DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        drawSDF(transform, Renderer2DUtils::SDFShape::Rectangle, fill_color, line_color, line_width, depth);
+    }
+
+    void ImmediateRenderer2D::DrawLine(const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width, double depth)
+    {
+        const auto line_transform = Renderer2DUtils::CalculateLineTransform(transform, start_point, end_point, line_width);
+        drawSDF(line_transform, Renderer2DUtils::SDFShape::Rectangle, line_color, line_color, 0.0, depth);
+    }
+
+    void ImmediateRenderer2D::drawSDF(const Math::TransformationMatrix& transform, Renderer2DUtils::SDFShape shape, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        const auto sdf = Renderer2DUtils::CalculateSDFTransform(transform, line_width);
+        if (!(sdf.WorldSize[0] > 0.0f && sdf.WorldSize[1] > 0.0f))
+        {
+            return;
+        }
+        if (!Renderer2DUtils::IsQuadVisible(viewProjection, transform, line_width))
+        {
+            ++statistics.Culled;
+            return;
+        }
+
+        GL::UseProgram(sdfShader.Shader);
+
+        const std::array<float, 4> fill = CS200::unpack_color(fill_color);
+        const std::array<float, 4> line = CS200::unpack_color(line_color);
+
+        GL::UniformMatrix3fv(sdfUniforms[SDFModel], 1, GL_FALSE, sdf.QuadTransform.data());
+        GL::Uniform2fv(sdfUniforms[SDFWorldSize], 1, sdf.WorldSize.data());
+        GL::Uniform2fv(sdfUniforms[SDFQuadSize], 1, sdf.QuadSize.data());
+        GL::Uniform4fv(sdfUniforms[SDFFillColor], 1, fill.data());
+        GL::Uniform4fv(sdfUniforms[SDFLineColor], 1, line.data());
+        GL::Uniform1f(sdfUniforms[SDFLineWidth], static_cast<float>(line_width));
+        GL::Uniform1ui(sdfUniforms[SDFShapeType], static_cast<GLuint>(shape));
+        GL::Uniform1f(sdfUniforms[SDFDepth], static_cast<float>(depth));
 
-        GL::UseProgram(0);
+        geometry->Draw(unitQuad);
+        ++statistics.DrawCalls;
     }
 }
\ No newline at end of file
@@ -10,8 +10,9 @@
 
 #include "Engine/Matrix.hpp"
 #include "IRenderer2D.hpp"
+#include "OpenGL/GeometryArena.hpp"
 #include "OpenGL/Shader.hpp"
-#include "OpenGL/VertexArray.hpp"
+#include "Renderer2DUtils.hpp"
 #include <array>
 
 namespace CS200
@@ -41,7 +42,7 @@ namespace CS200
      * - Uses two rendering paths: textured quads and SDF shapes
      * - Quad rendering: Standard texture mapping with transform and tint
      * - SDF rendering: Fragment shader-based shapes with perfect edges and outlines
-     * - Uniform buffer for camera data shared between shaders
+     * - Camera data read from the uniform buffer shared by every 2D shader
      * - Immediate submission to GPU (no batching)
      *
      * Common Use Cases:
@@ -85,6 +86,15 @@ namespace CS200
     class ImmediateRenderer2D : public IRenderer2D
     {
     public:
+        /**
+         * \brief Number of draw calls issued and primitives culled between BeginScene() and EndScene()
+         */
+        struct Statistics
+        {
+            unsigned DrawCalls = 0;
+            unsigned Culled    = 0; ///< quads and shapes rejected because they are outside the view
+        };
+
         /**
          * \brief Default constructor - creates uninitialized renderer
          *
@@ -141,13 +151,11 @@ namespace CS200
          * \brief Initialize OpenGL resources for rendering
          *
          * Implementation notes:
-         * - Create index buffer with quad indices (0,1,2,2,3,0)
-         * - Create vertex buffer with quad vertices (-0.5 to 0.5 range)
-         * - Set up VAO with position and texture coordinate attributes
-         * - Create SDF vertex buffer (position-only attributes)
+         * - Add the unit quad (-0.5 to 0.5 range, indices 0,1,2,2,3,0) to the shared GeometryArena of
+         *   its layout, position and texture coordinate attributes
+         * - The SDF shader draws the same mesh and only reads the position attribute
          * - Load and compile vertex/fragment shaders from Assets/shaders/
-         * - Create uniform buffer for camera/view-projection matrix
-         * - Bind uniform buffer to both shaders with name "Camera"
+         * - Point the "Camera" block of both shaders at Renderer2DUtils::CameraBlockBinding
          */
         void Init() override;
 
@@ -167,9 +175,7 @@ namespace CS200
          * \param view_projection Combined view and projection matrix for the frame
          *
          * Implementation notes:
-         * - Convert 3x3 matrix to 4x3 format for uniform buffer
-         * - Update uniform buffer with new matrix data
-         * - Bind uniform buffer for use by shaders
+         * - Publish the matrix to the shared Camera uniform buffer, Renderer2DUtils::PublishCamera()
          * - Store matrix for potential later use
          */
         void BeginScene(const Math::TransformationMatrix& view_projection) override;
@@ -183,6 +189,11 @@ namespace CS200
          */
         void EndScene() override;
 
+        /**
+         * \brief Nothing to submit, every draw call already reached OpenGL
+         */
+        void Flush() override;
+
         /**
          * \brief Draw a textured quad with transformation and tinting
          * \param transform World transformation matrix (position, rotation, scale)
@@ -190,34 +201,101 @@ namespace CS200
          * \param texture_coord_bl Bottom-left texture coordinate (typically {0,0})
          * \param texture_coord_tr Top-right texture coordinate (typically {1,1})
          * \param tintColor Color to multiply with texture (RGBA::White for no tint)
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
          *
          * Implementation notes:
+         * - Return before any GL call when the quad is outside the view (Renderer2DUtils::IsQuadVisible)
          * - Calculate texture coordinate transformation matrix
          * - Set shader uniforms: model matrix, depth, texture transform, tint color
+         * - quad.vert maps depth [0, 1] to NDC z [-1, 1]
          * - Bind texture to texture unit 0
          * - Draw using quad VAO and index buffer
          * - Use GL_TRIANGLES with 6 indices (2 triangles)
          */
-        void DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor) override;
+        void DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor, double depth) override;
 
+        /**
+         * \brief Draw a circle with the SDF shader
+         * \param transform World transformation matrix, the unit quad is the circle's bounding box
+         * \param fill_color Color inside the outline
+         * \param line_color Color of the outline
+         * \param line_width Outline thickness in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         *
+         * Implementation notes:
+         * - Grow the quad by the line width with Renderer2DUtils::CalculateSDFTransform
+         * - Set the SDF uniforms and draw the position-only SDF quad, one draw call per shape
+         */
+        void DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth) override;
 
-    private:
+        /**
+         * \brief Draw a rectangle with the SDF shader
+         * \param transform World transformation matrix applied to the unit quad
+         * \param fill_color Color inside the outline
+         * \param line_color Color of the outline
+         * \param line_width Outline thickness in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        void DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth) override;
+
+        /**
+         * \brief Draw a line segment as a filled SDF rectangle
+         * \param transform Transformation applied to both end points
+         * \param start_point Start of the line
+         * \param end_point End of the line
+         * \param line_color Color of the line
+         * \param line_width Thickness of the line in world units
+         * \param depth Distance from the viewer in [0, 1], 0 is the front
+         */
+        void DrawLine(const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width, double depth) override;
 
+        using IRenderer2D::DrawLine;
+
+        /**
+         * \brief Statistics of the current (or last completed) scene
+         * \return Draw call and culled primitive counts accumulated since the last BeginScene()
+         */
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        void drawSDF(const Math::TransformationMatrix& transform, Renderer2DUtils::SDFShape shape, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth);
 
-        OpenGL::VertexArrayHandle vao{}; // Vertex Array Object
-        OpenGL::BufferHandle      vbo{}; //  Vertex Buffer Object
-        OpenGL::BufferHandle      ibo{}; //  Index Buffer Object
-        OpenGL::BufferHandle      uniformBlock{};
+        enum QuadUniform : std::size_t
+        {
+            QuadModel,
+            QuadTexCoordTransform,
+            QuadTint,
+            QuadDepth,
+            QuadTexture,
+            QuadUniformCount
+        };
 
-        GLsizei indicesCount = 0;
+        enum SDFUniform : std::size_t
+        {
+            SDFModel,
+            SDFWorldSize,
+            SDFQuadSize,
+            SDFFillColor,
+            SDFLineColor,
+            SDFLineWidth,
+            SDFShapeType,
+            SDFDepth,
+            SDFUniformCount
+        };
 
-        OpenGL::VertexArrayHandle sdfVao{}; 
-        OpenGL::BufferHandle      sdfVbo{}; 
+        OpenGL::GeometryArena*      geometry = nullptr; // shared arena of the unit quad's layout, the SDF shader only reads the position
+        OpenGL::GeometryArena::Mesh unitQuad{};
+        OpenGL::BufferHandle        uniformBlock{};
 
-        OpenGL::CompiledShader textureShader{};
-        OpenGL::CompiledShader sdfShader{};
+        OpenGL::CompiledShader              textureShader{};
+        std::array<GLint, QuadUniformCount> textureUniforms{}; // indexed by QuadUniform
+        OpenGL::CompiledShader              sdfShader{};
+        std::array<GLint, SDFUniformCount>  sdfUniforms{}; // indexed by SDFUniform
 
-        OpenGL::BufferHandle       uboCamera{};
         Math::TransformationMatrix viewProjection;
+        Statistics                 statistics{};
     };
 }
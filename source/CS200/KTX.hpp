@@ -0,0 +1,57 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * \brief Layout of KTX 1.1 texture containers, shared by the engine loader and the texture_compressor tool
+ *
+ * A KTX file is a 64 byte header, bytesOfKeyValueData bytes of key/value pairs, then for every mipmap
+ * level a uint32 byte count followed by that level's data padded to 4 bytes.
+ * https://registry.khronos.org/KTX/specs/1.0/ktxspec.v1.html
+ *
+ * Only the subset this project writes is read back: little-endian, 2D, one face, no array, compressed.
+ * Rows are stored bottom row first (KTXorientation "S=r,T=u") like every texture CS200::Image loads.
+ */
+namespace CS200::ktx
+{
+    constexpr std::array<std::uint8_t, 12> Identifier = { 0xAB, 'K', 'T', 'X', ' ', '1', '1', 0xBB, '\r', '\n', 0x1A, '\n' };
+    constexpr std::uint32_t                Endianness = 0x04030201;
+
+    struct Header
+    {
+        std::array<std::uint8_t, 12> identifier{};
+        std::uint32_t                endianness            = 0;
+        std::uint32_t                glType                = 0; ///< 0 for compressed formats
+        std::uint32_t                glTypeSize            = 1;
+        std::uint32_t                glFormat              = 0; ///< 0 for compressed formats
+        std::uint32_t                glInternalFormat      = 0;
+        std::uint32_t                glBaseInternalFormat  = 0;
+        std::uint32_t                pixelWidth            = 0;
+        std::uint32_t                pixelHeight           = 0;
+        std::uint32_t                pixelDepth            = 0;
+        std::uint32_t                numberOfArrayElements = 0;
+        std::uint32_t                numberOfFaces         = 1;
+        std::uint32_t                numberOfMipmapLevels  = 1;
+        std::uint32_t                bytesOfKeyValueData   = 0;
+    };
+
+    static_assert(sizeof(Header) == 64);
+
+    /**
+     * \brief File name suffixes replacing ".png" for each block compression family
+     *
+     * TextureManager looks for "Assets/ship.s3tc.ktx" etc. next to "Assets/ship.png".
+     */
+    constexpr std::string_view BPTCSuffix = ".bptc.ktx";
+    constexpr std::string_view S3TCSuffix = ".s3tc.ktx";
+    constexpr std::string_view ETC2Suffix = ".etc2.ktx";
+}
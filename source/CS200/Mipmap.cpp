@@ -0,0 +1,137 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Mipmap.hpp"
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+
+namespace
+{
+    using Bytes = std::array<std::uint8_t, 4>; // r, g, b, a in memory order
+
+    constexpr int LinearSteps = 4096; // fine enough that dark sRGB values survive the round trip
+
+    float srgb_to_linear(float value) noexcept
+    {
+        return value <= 0.04045f ? value / 12.92f : std::pow((value + 0.055f) / 1.055f, 2.4f);
+    }
+
+    float linear_to_srgb(float value) noexcept
+    {
+        return value <= 0.0031308f ? value * 12.92f : 1.055f * std::pow(value, 1.0f / 2.4f) - 0.055f;
+    }
+
+    const std::array<float, 256>& decode_table()
+    {
+        static const std::array<float, 256> table = []
+        {
+            std::array<float, 256> values{};
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = srgb_to_linear(static_cast<float>(i) / 255.0f);
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    const std::array<std::uint8_t, LinearSteps>& encode_table()
+    {
+        static const std::array<std::uint8_t, LinearSteps> table = []
+        {
+            std::array<std::uint8_t, LinearSteps> values{};
+            for (std::size_t i = 0; i < values.size(); ++i)
+            {
+                values[i] = static_cast<std::uint8_t>(std::lround(linear_to_srgb(static_cast<float>(i) / (LinearSteps - 1)) * 255.0f));
+            }
+            return values;
+        }();
+        return table;
+    }
+
+    // [begin, end) of the source texels averaged into destination texel `index`, the last one absorbs an odd leftover
+    constexpr std::array<int, 2> footprint(int index, int destination_extent, int source_extent) noexcept
+    {
+        const int begin = index * 2;
+        const int end   = index == destination_extent - 1 ? source_extent : begin + 2;
+        return { begin, end };
+    }
+}
+
+namespace CS200
+{
+    void downsample_srgb(Math::ivec2 size, std::span<const RGBA> source, std::span<RGBA> destination) noexcept
+    {
+        const auto& decode           = decode_table();
+        const auto& encode           = encode_table();
+        const auto  destination_size = next_mip_size(size);
+
+        for (int y = 0; y < destination_size.y; ++y)
+        {
+            const auto [row_begin, row_end] = footprint(y, destination_size.y, size.y);
+            for (int x = 0; x < destination_size.x; ++x)
+            {
+                const auto [column_begin, column_end] = footprint(x, destination_size.x, size.x);
+
+                float red = 0, green = 0, blue = 0, alpha = 0;
+                int   count = 0;
+                for (int row = row_begin; row < row_end; ++row)
+                {
+                    for (int column = column_begin; column < column_end; ++column)
+                    {
+                        const auto  texel  = std::bit_cast<Bytes>(source[static_cast<std::size_t>(row * size.x + column)]);
+                        const float weight = static_cast<float>(texel[3]) / 255.0f;
+                        red += decode[texel[0]] * weight;
+                        green += decode[texel[1]] * weight;
+                        blue += decode[texel[2]] * weight;
+                        alpha += weight;
+                        ++count;
+                    }
+                }
+
+                Bytes result{};
+                if (alpha > 0.0f)
+                {
+                    const auto to_index = [](float linear) { return static_cast<std::size_t>(std::lround(std::fmin(linear, 1.0f) * (LinearSteps - 1))); };
+                    result[0]           = encode[to_index(red / alpha)];
+                    result[1]           = encode[to_index(green / alpha)];
+                    result[2]           = encode[to_index(blue / alpha)];
+                    result[3]           = static_cast<std::uint8_t>(std::lround(alpha / static_cast<float>(count) * 255.0f));
+                }
+                destination[static_cast<std::size_t>(y * destination_size.x + x)] = std::bit_cast<RGBA>(result);
+            }
+        }
+    }
+
+    std::size_t mip_chain_texel_count(Math::ivec2 size) noexcept
+    {
+        std::size_t count = 0;
+        while (size.x > 1 || size.y > 1)
+        {
+            size = next_mip_size(size);
+            count += static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+        }
+        return count;
+    }
+
+    void build_mip_chain(Math::ivec2 size, std::span<const RGBA> level0, std::span<RGBA> chain) noexcept
+    {
+        std::span<const RGBA> previous = level0;
+        std::size_t           offset   = 0;
+        while (size.x > 1 || size.y > 1)
+        {
+            const Math::ivec2 next_size = next_mip_size(size);
+            const auto        current   = chain.subspan(offset, static_cast<std::size_t>(next_size.x) * static_cast<std::size_t>(next_size.y));
+            downsample_srgb(size, previous, current);
+            offset += current.size();
+            previous = current;
+            size     = next_size;
+        }
+    }
+}
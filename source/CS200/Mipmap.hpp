@@ -0,0 +1,53 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Engine/Vec2.hpp"
+#include "RGBA.hpp"
+#include <cstddef>
+#include <span>
+
+namespace CS200
+{
+    /**
+     * \brief Size of the next smaller mipmap level, halved and rounded down but never below 1
+     */
+    [[nodiscard]] constexpr Math::ivec2 next_mip_size(Math::ivec2 size) noexcept
+    {
+        return Math::ivec2{ size.x > 1 ? size.x / 2 : 1, size.y > 1 ? size.y / 2 : 1 };
+    }
+
+    /**
+     * \brief Build the next mipmap level with a 2×2 box filter
+     * \param size Dimensions of source
+     * \param source Texels in the byte order uploaded as GL_RGBA / GL_UNSIGNED_BYTE
+     * \param destination next_mip_size(size).x × next_mip_size(size).y texels
+     *
+     * Texels are sRGB encoded, averaging them directly darkens every edge between bright and dark
+     * areas. Colors are converted to linear light through lookup tables, averaged weighted by
+     * their alpha so fully transparent texels do not bleed their (usually black) color into the
+     * visible ones, then encoded back. Odd sizes fold the last row or column into the previous
+     * destination texel, so every source texel contributes.
+     */
+    void downsample_srgb(Math::ivec2 size, std::span<const RGBA> source, std::span<RGBA> destination) noexcept;
+
+    /**
+     * \brief Number of texels in mipmap levels 1 down to 1×1 of an image of this size, level 0 excluded
+     */
+    [[nodiscard]] std::size_t mip_chain_texel_count(Math::ivec2 size) noexcept;
+
+    /**
+     * \brief Build every level below level 0 with downsample_srgb()
+     * \param size Dimensions of level 0
+     * \param level0 size.x × size.y texels
+     * \param chain mip_chain_texel_count(size) texels, receives level 1, then level 2 right after it and so on
+     *
+     * Level 1 is filtered straight from level0, each following level from the one before it in chain.
+     */
+    void build_mip_chain(Math::ivec2 size, std::span<const RGBA> level0, std::span<RGBA> chain) noexcept;
+}
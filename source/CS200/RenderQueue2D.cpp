@@ -0,0 +1,240 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "RenderQueue2D.hpp"
+#include "OpenGL/GL.hpp"
+#include "Renderer2DUtils.hpp"
+#include <algorithm>
+#include <utility>
+
+namespace CS200
+{
+    namespace
+    {
+        constexpr unsigned RADIX_BITS    = 8;
+        constexpr unsigned RADIX_BUCKETS = 1u << RADIX_BITS;
+        constexpr unsigned RADIX_PASSES  = 64 / RADIX_BITS;
+
+        constexpr std::size_t INITIAL_COMMAND_CAPACITY = 4096;
+
+        constexpr std::uint64_t DEPTH_KEY_MAX = 0xffff;
+
+        enum ShaderKey : std::uint64_t
+        {
+            TexturedQuadShader = 0,
+            SDFShader          = 1
+        };
+    }
+
+    RenderQueue2D::RenderQueue2D(IRenderer2D& backend_renderer) noexcept : backend(backend_renderer)
+    {
+        layerOrdering.fill(Ordering::Submission);
+    }
+
+    void RenderQueue2D::Init()
+    {
+        backend.Init();
+        commands.reserve(INITIAL_COMMAND_CAPACITY);
+        entries.reserve(INITIAL_COMMAND_CAPACITY);
+        scratch.reserve(INITIAL_COMMAND_CAPACITY);
+    }
+
+    void RenderQueue2D::Shutdown()
+    {
+        backend.Shutdown();
+        commands.clear();
+        commands.shrink_to_fit();
+        entries.clear();
+        entries.shrink_to_fit();
+        scratch.clear();
+        scratch.shrink_to_fit();
+    }
+
+    void RenderQueue2D::BeginScene(const Math::TransformationMatrix& view_projection)
+    {
+        currentLayer = 0;
+        statistics   = {};
+        commands.clear();
+        entries.clear();
+
+        backend.BeginScene(view_projection);
+    }
+
+    void RenderQueue2D::EndScene()
+    {
+        submitSorted();
+        backend.EndScene();
+    }
+
+    void RenderQueue2D::Flush()
+    {
+        submitSorted();
+        backend.Flush();
+    }
+
+    void RenderQueue2D::DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor, double depth)
+    {
+        const bool opaque = (tintColor & 0xff) == 0xff && OpenGL::IsTextureOpaque(texture);
+        submit(Command{ transform, texture_coord_bl, texture_coord_tr, 0.0, depth, texture, tintColor, CS200::CLEAR, CommandType::Quad }, opaque);
+    }
+
+    void RenderQueue2D::DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        // anti-aliased edges always blend
+        submit(Command{ transform, {}, {}, line_width, depth, 0, fill_color, line_color, CommandType::Circle }, false);
+    }
+
+    void RenderQueue2D::DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth)
+    {
+        submit(Command{ transform, {}, {}, line_width, depth, 0, fill_color, line_color, CommandType::Rectangle }, false);
+    }
+
+    void RenderQueue2D::DrawLine(const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width, double depth)
+    {
+        // stored the same way the renderers draw it, a filled rectangle without outline
+        const auto line_transform = Renderer2DUtils::CalculateLineTransform(transform, start_point, end_point, line_width);
+        submit(Command{ line_transform, {}, {}, 0.0, depth, 0, line_color, line_color, CommandType::Rectangle }, false);
+    }
+
+    void RenderQueue2D::submit(Command&& command, bool opaque)
+    {
+        entries.push_back(SortEntry{ makeKey(command, opaque), static_cast<std::uint32_t>(commands.size()) });
+        commands.push_back(std::move(command));
+        ++statistics.Commands;
+        if (depthPasses && opaque)
+        {
+            ++statistics.Opaque;
+        }
+    }
+
+    std::uint64_t RenderQueue2D::makeKey(const Command& command, bool opaque) const noexcept
+    {
+        std::uint64_t key = static_cast<std::uint64_t>(currentLayer) << SortKey::LayerShift;
+        if (depthPasses)
+        {
+            // 0 is the front, opaque ascending so early-Z rejects what is behind, translucent descending for correct blending
+            const auto depth = static_cast<std::uint64_t>(std::clamp(command.Depth, 0.0, 1.0) * static_cast<double>(DEPTH_KEY_MAX));
+            if (opaque)
+            {
+                key |= depth << SortKey::DepthShift;
+            }
+            else
+            {
+                key |= std::uint64_t{ 1 } << SortKey::PassShift;
+                key |= (DEPTH_KEY_MAX - depth) << SortKey::DepthShift;
+            }
+        }
+        if (layerOrdering[currentLayer] == Ordering::Submission)
+        {
+            // equal keys inside the layer, the stable sort keeps the call order
+            return key;
+        }
+
+        const std::uint64_t shader = command.Type == CommandType::Quad ? TexturedQuadShader : SDFShader;
+        key |= static_cast<std::uint64_t>(opaque ? 0 : 1) << SortKey::BlendShift;
+        key |= shader << SortKey::ShaderShift;
+        key |= static_cast<std::uint64_t>(command.Texture) << SortKey::TextureShift;
+        return key;
+    }
+
+    void RenderQueue2D::submitSorted()
+    {
+        sort();
+
+        if (!depthPasses)
+        {
+            for (const SortEntry& entry : entries)
+            {
+                dispatch(commands[entry.Command]);
+            }
+        }
+        else
+        {
+            GL::Enable(GL_DEPTH_TEST);
+            GL::DepthFunc(GL_LEQUAL);
+            GL::DepthMask(GL_TRUE);
+
+            // every layer runs both passes, the mask flips at each change between them
+            bool translucent_pass = false;
+            for (const SortEntry& entry : entries)
+            {
+                const bool translucent = ((entry.Key >> SortKey::PassShift) & 1) != 0;
+                if (translucent != translucent_pass)
+                {
+                    // the batches of the previous pass have to reach the GPU before the depth mask changes
+                    backend.Flush();
+                    GL::DepthMask(translucent ? GL_FALSE : GL_TRUE);
+                    translucent_pass = translucent;
+                }
+                dispatch(commands[entry.Command]);
+            }
+            backend.Flush();
+
+            GL::DepthMask(GL_TRUE);
+            GL::Disable(GL_DEPTH_TEST);
+        }
+
+        commands.clear();
+        entries.clear();
+    }
+
+    void RenderQueue2D::sort()
+    {
+        const auto count = static_cast<std::uint32_t>(entries.size());
+        if (count < 2)
+        {
+            return;
+        }
+
+        // one read of the keys builds the histograms of all eight bytes
+        std::array<std::array<std::uint32_t, RADIX_BUCKETS>, RADIX_PASSES> histograms{};
+        for (const SortEntry& entry : entries)
+        {
+            for (unsigned pass = 0; pass < RADIX_PASSES; ++pass)
+            {
+                ++histograms[pass][(entry.Key >> (pass * RADIX_BITS)) & (RADIX_BUCKETS - 1)];
+            }
+        }
+
+        scratch.resize(count);
+        for (unsigned pass = 0; pass < RADIX_PASSES; ++pass)
+        {
+            const unsigned shift  = pass * RADIX_BITS;
+            auto&          counts = histograms[pass];
+            if (counts[(entries.front().Key >> shift) & (RADIX_BUCKETS - 1)] == count)
+            {
+                // every key has the same byte here, most passes are skipped because the key is sparse
+                continue;
+            }
+
+            std::uint32_t offset = 0;
+            for (std::uint32_t& bucket : counts)
+            {
+                const std::uint32_t bucket_size = bucket;
+                bucket                          = offset;
+                offset += bucket_size;
+            }
+
+            for (const SortEntry& entry : entries)
+            {
+                scratch[counts[(entry.Key >> shift) & (RADIX_BUCKETS - 1)]++] = entry;
+            }
+            entries.swap(scratch);
+            ++statistics.SortPasses;
+        }
+    }
+
+    void RenderQueue2D::dispatch(const Command& command)
+    {
+        switch (command.Type)
+        {
+            case CommandType::Quad: backend.DrawQuad(command.Transform, command.Texture, command.TexCoordBL, command.TexCoordTR, command.Color, command.Depth); break;
+            case CommandType::Circle: backend.DrawCircle(command.Transform, command.Color, command.LineColor, command.LineWidth, command.Depth); break;
+            case CommandType::Rectangle: backend.DrawRectangle(command.Transform, command.Color, command.LineColor, command.LineWidth, command.Depth); break;
+        }
+    }
+}
@@ -0,0 +1,229 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "IRenderer2D.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace CS200
+{
+    /**
+     * \brief Records 2D draw commands, sorts them by state and replays them on another renderer
+     *
+     * RenderQueue2D is an IRenderer2D decorator. Draw*() calls made between BeginScene() and EndScene()
+     * only store a command together with a 64 bit sort key. EndScene() radix sorts the keys, replays the
+     * commands in key order on the backend renderer and ends the backend's scene.
+     * With a batching backend such as BatchRenderer2D this turns interleaved textures into long runs
+     * that share a batch.
+     *
+     * Sort Key Layout (most significant bits first):
+     * - Layer (8 bits) set with SetLayer(), lower layers are drawn first
+     * - Pass (1 bit) opaque before translucent inside the layer, only with depth passes
+     * - Blend (1 bit) opaque before translucent
+     * - Depth (16 bits) front-to-back for opaque, back-to-front for translucent, only with depth passes
+     * - Shader (2 bits) textured quads before SDF shapes
+     * - Texture (32 bits) OpenGL texture handle
+     *
+     * Reordering by texture changes which overlapping translucent sprite ends up on top, so every layer
+     * can choose between Ordering::Batched (sort by the full key) and Ordering::Submission (only the layer
+     * is part of the key). The sort is stable, so commands with equal keys keep their submission order.
+     * Every layer starts as Ordering::Submission, which draws exactly what the caller submitted.
+     *
+     * Depth Passes:
+     * SetDepthPasses(true) splits every layer in two passes that share the depth buffer (GL_LEQUAL).
+     * Opaque quads, a tint alpha of 255 and OpenGL::IsTextureOpaque(), are drawn first front-to-back
+     * with depth writes, so hidden fragments of the sprites behind them are rejected by early-Z.
+     * Everything else in the layer is drawn afterwards back-to-front with the depth test but without
+     * depth writes. SDF shapes always count as translucent because of their anti-aliased edges.
+     * Layers keep their order, a higher layer is drawn after both passes of the one below it and
+     * wins at equal depth. Commands sharing a depth keep their submission order inside their pass,
+     * so a scene where every depth is 0 renders as before except that inside one layer an opaque
+     * quad is drawn under a translucent one submitted before it.
+     *
+     * Example Usage:
+     * \code
+     * RenderQueue2D queue{ batch_renderer };
+     * queue.Init();                                               // also initializes batch_renderer
+     * queue.SetLayerOrdering(1, RenderQueue2D::Ordering::Batched);
+     *
+     * queue.BeginScene(CS200::build_ndc_matrix(screen_size));
+     * queue.SetLayer(0);
+     * background.Draw(...);                                       // kept in call order
+     * queue.SetLayer(1);
+     * for (const auto& sprite : sprites)
+     *     queue.DrawQuad(sprite.transform, sprite.texture);       // grouped by texture
+     * queue.EndScene();                                           // sorted and submitted here
+     * \endcode
+     */
+    class RenderQueue2D : public IRenderer2D
+    {
+    public:
+        /**
+         * \brief How the commands of one layer are ordered
+         */
+        enum class Ordering : std::uint8_t
+        {
+            Submission, ///< keep the call order, needed when translucent sprites overlap
+            Batched     ///< sort by shader and texture to minimize batch breaks
+        };
+
+        /**
+         * \brief Bit positions of the fields packed into a sort key
+         */
+        struct SortKey
+        {
+            static constexpr unsigned LayerShift   = 56;
+            static constexpr unsigned PassShift    = 55;
+            static constexpr unsigned BlendShift   = 54;
+            static constexpr unsigned DepthShift   = 38;
+            static constexpr unsigned ShaderShift  = 36;
+            static constexpr unsigned TextureShift = 4;
+        };
+
+        /**
+         * \brief Number of commands recorded and dispatched in the current (or last completed) scene
+         */
+        struct Statistics
+        {
+            unsigned Commands   = 0;
+            unsigned Opaque     = 0; ///< commands drawn in the front-to-back pass
+            unsigned SortPasses = 0; ///< radix passes actually executed, bytes shared by every key are skipped
+        };
+
+        /**
+         * \brief Creates a queue that replays its commands on backend
+         * \param backend Renderer that receives the sorted commands, must outlive the queue
+         */
+        explicit RenderQueue2D(IRenderer2D& backend) noexcept;
+
+        RenderQueue2D(const RenderQueue2D& other)            = delete;
+        RenderQueue2D(RenderQueue2D&& other)                 = delete;
+        RenderQueue2D& operator=(const RenderQueue2D& other) = delete;
+        RenderQueue2D& operator=(RenderQueue2D&& other)      = delete;
+
+        ~RenderQueue2D() override = default;
+
+        /**
+         * \brief Initialize the backend renderer and reserve the command storage
+         */
+        void Init() override;
+
+        /**
+         * \brief Shut down the backend renderer and drop any recorded command
+         */
+        void Shutdown() override;
+
+        /**
+         * \brief Start recording a scene
+         * \param view_projection Combined view and projection matrix, forwarded to the backend immediately
+         *
+         * Resets the current layer to 0.
+         */
+        void BeginScene(const Math::TransformationMatrix& view_projection) override;
+
+        /**
+         * \brief Sort the recorded commands and submit them to the backend renderer
+         */
+        void EndScene() override;
+
+        /**
+         * \brief Sort and submit everything recorded so far, then flush the backend
+         *
+         * Commands recorded after Flush() are sorted separately, they are always drawn on top.
+         */
+        void Flush() override;
+
+        void DrawQuad(const Math::TransformationMatrix& transform, OpenGL::TextureHandle texture, Math::vec2 texture_coord_bl, Math::vec2 texture_coord_tr, CS200::RGBA tintColor, double depth) override;
+        void DrawCircle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth) override;
+        void DrawRectangle(const Math::TransformationMatrix& transform, CS200::RGBA fill_color, CS200::RGBA line_color, double line_width, double depth) override;
+        void DrawLine(const Math::TransformationMatrix& transform, Math::vec2 start_point, Math::vec2 end_point, CS200::RGBA line_color, double line_width, double depth) override;
+
+        using IRenderer2D::DrawLine;
+
+        /**
+         * \brief Select the layer of every following Draw*() call
+         * \param layer Layers are submitted in increasing order
+         */
+        void SetLayer(std::uint8_t layer) noexcept
+        {
+            currentLayer = layer;
+        }
+
+        /**
+         * \brief Choose how the commands inside a layer are ordered
+         * \param layer Layer to configure, the setting persists across scenes
+         * \param ordering Ordering::Batched allows reordering by state, Ordering::Submission keeps call order
+         */
+        void SetLayerOrdering(std::uint8_t layer, Ordering ordering) noexcept
+        {
+            layerOrdering[layer] = ordering;
+        }
+
+        /**
+         * \brief Turn the opaque front-to-back / translucent back-to-front passes on or off
+         * \param enabled true to draw with GL_DEPTH_TEST, the depth buffer is cleared by RenderingAPI::Clear()
+         */
+        void SetDepthPasses(bool enabled) noexcept
+        {
+            depthPasses = enabled;
+        }
+
+        /**
+         * \brief Statistics of the current (or last completed) scene
+         * \return Recorded command count and executed radix passes
+         */
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        enum class CommandType : std::uint8_t
+        {
+            Quad,
+            Circle,
+            Rectangle
+        };
+
+        struct Command
+        {
+            Math::TransformationMatrix Transform;
+            Math::vec2                 TexCoordBL{};
+            Math::vec2                 TexCoordTR{};
+            double                     LineWidth = 0.0;
+            double                     Depth     = 0.0;
+            OpenGL::TextureHandle      Texture   = 0;
+            CS200::RGBA                Color     = CS200::WHITE; // tint of a quad, fill of a shape
+            CS200::RGBA                LineColor = CS200::BLACK;
+            CommandType                Type      = CommandType::Quad;
+        };
+
+        struct SortEntry
+        {
+            std::uint64_t Key     = 0;
+            std::uint32_t Command = 0;
+        };
+
+        void          submit(Command&& command, bool opaque);
+        std::uint64_t makeKey(const Command& command, bool opaque) const noexcept;
+        void          submitSorted();
+        void          sort();
+        void          dispatch(const Command& command);
+
+        IRenderer2D&              backend;
+        std::vector<Command>      commands{};
+        std::vector<SortEntry>    entries{};
+        std::vector<SortEntry>    scratch{};
+        std::array<Ordering, 256> layerOrdering{};
+        std::uint8_t              currentLayer = 0;
+        bool                      depthPasses  = false;
+        Statistics                statistics{};
+    };
+}
@@ -6,11 +6,36 @@
  * \copyright DigiPen Institute of Technology
  */
 #include "Renderer2DUtils.hpp"
+#include "OpenGL/Buffer.hpp"
+#include "OpenGL/GL.hpp"
 
 #include <cmath>
+#include <span>
+
+namespace
+{
+    OpenGL::BufferHandle camera_buffer = 0; // std140 Camera block at CameraBlockBinding
+}
 
 namespace CS200::Renderer2DUtils
 {
+    void PublishCamera(const Math::TransformationMatrix& view_projection)
+    {
+        if (camera_buffer == 0)
+        {
+            camera_buffer = OpenGL::CreateBuffer(OpenGL::BufferType::UniformBlocks, static_cast<GLsizeiptr>(sizeof(std140_mat3)));
+        }
+        const std140_mat3 camera = to_std140_mat3(view_projection);
+        OpenGL::UpdateBufferData(OpenGL::BufferType::UniformBlocks, camera_buffer, std::as_bytes(std::span{ camera }));
+        GL::BindBufferBase(GL_UNIFORM_BUFFER, CameraBlockBinding, camera_buffer);
+    }
+
+    void DestroyCameraBuffer() noexcept
+    {
+        GL::DeleteBuffers(1, &camera_buffer);
+        camera_buffer = 0;
+    }
+
     Math::TransformationMatrix CalculateLineTransform(const Math::TransformationMatrix& transform, const Math::vec2& start_point, const Math::vec2& end_point, double line_width) noexcept
     {
         const Math::vec2 line_vector = end_point - start_point;
@@ -27,6 +52,18 @@ namespace CS200::Renderer2DUtils
         return final_transform;
     }
 
+    bool IsQuadVisible(const Math::TransformationMatrix& view_projection, const Math::TransformationMatrix& transform, double padding) noexcept
+    {
+        const Math::vec2 world_center{ transform[0][2], transform[1][2] };
+        const Math::vec2 world_half{ 0.5 * (std::abs(transform[0][0]) + std::abs(transform[0][1])) + padding, 0.5 * (std::abs(transform[1][0]) + std::abs(transform[1][1])) + padding };
+
+        const Math::vec2 ndc_center = view_projection * world_center;
+        const Math::vec2 ndc_half{ std::abs(view_projection[0][0]) * world_half.x + std::abs(view_projection[0][1]) * world_half.y,
+                                   std::abs(view_projection[1][0]) * world_half.x + std::abs(view_projection[1][1]) * world_half.y };
+
+        return std::abs(ndc_center.x) - ndc_half.x <= 1.0 && std::abs(ndc_center.y) - ndc_half.y <= 1.0;
+    }
+
     SDFTransform CalculateSDFTransform(const Math::TransformationMatrix& transform, double line_width) noexcept
     {
         const vec2      world_size{ static_cast<float>(std::sqrt(transform[0][0] * transform[0][0] + transform[1][0] * transform[1][0])),
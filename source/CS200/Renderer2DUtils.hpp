@@ -11,6 +11,7 @@
 #include "Engine/Vec2.hpp"
 #include "RGBA.hpp"
 #include <array>
+#include <cstdint>
 #include <optional>
 
 namespace CS200::Renderer2DUtils
@@ -54,6 +55,49 @@ namespace CS200::Renderer2DUtils
                  static_cast<float>(transform[0][2]), static_cast<float>(transform[1][2]), static_cast<float>(transform[2][2]) };
     }
 
+    /**
+     * \brief Uniform buffer binding point of the "Camera" block shared by every 2D shader
+     *
+     * \code
+     * layout(std140) uniform Camera
+     * {
+     *     mat3 uViewProjection;
+     * };
+     * \endcode
+     */
+    constexpr unsigned CameraBlockBinding = 0;
+
+    using std140_mat3 = std::array<float, 12>; ///< mat3 laid out as three vec4 aligned columns (std140)
+
+    /**
+     * \brief Convert engine transformation matrix to the std140 layout of a mat3 inside a uniform block
+     * \param transform Engine transformation matrix (row-major, double precision)
+     * \return Column-major matrix where every column is padded to 4 floats
+     *
+     * std140 stores a mat3 as an array of three vec3 columns and every array element is aligned to
+     * a vec4, so each column is followed by one float of padding (48 bytes in total).
+     */
+    inline std140_mat3 to_std140_mat3(const Math::TransformationMatrix& transform) noexcept
+    {
+        const mat3 m = to_opengl_mat3(transform);
+        return { m[0], m[1], m[2], 0.0f, m[3], m[4], m[5], 0.0f, m[6], m[7], m[8], 0.0f };
+    }
+
+    /**
+     * \brief Write the view-projection matrix into the Camera uniform buffer shared by every 2D shader
+     * \param view_projection Matrix mapping world coordinates to NDC
+     *
+     * The buffer is created on first use and bound at CameraBlockBinding, so every program whose Camera
+     * block points there (OpenGL::SetUniformBlockBinding) reads the matrix. The renderers call it from
+     * BeginScene(), code drawing with its own shaders calls it directly rather than opening a scene.
+     */
+    void PublishCamera(const Math::TransformationMatrix& view_projection);
+
+    /**
+     * \brief Delete the shared Camera uniform buffer, called by Engine::Stop() while the context exists
+     */
+    void DestroyCameraBuffer() noexcept;
+
     /**
      * \brief Convert packed RGBA color to normalized float array for shaders
      * \param rgba Packed color in 0xRRGGBBAA format
@@ -116,6 +160,29 @@ namespace CS200::Renderer2DUtils
      */
     Math::TransformationMatrix CalculateLineTransform(const Math::TransformationMatrix& transform, const Math::vec2& start_point, const Math::vec2& end_point, double line_width) noexcept;
 
+    /**
+     * \brief Test whether a unit quad can cover any part of the view
+     * \param view_projection Matrix given to BeginScene(), maps world coordinates to NDC
+     * \param transform World transformation of the unit quad (-0.5 to 0.5)
+     * \param padding Extra world units added on every side, e.g. the outline of an SDF shape
+     * \return false when the quad is certainly outside the [-1, 1] NDC square
+     *
+     * The quad's world AABB is taken straight from the matrix: its center is the translation column and
+     * its half extents are half the sum of the absolute linear terms of each row. The same rule maps that
+     * AABB into NDC, where it is compared against the view. The test is conservative, rotated quads near a
+     * corner of the view may be kept even though they are not visible.
+     */
+    bool IsQuadVisible(const Math::TransformationMatrix& view_projection, const Math::TransformationMatrix& transform, double padding = 0.0) noexcept;
+
+    /**
+     * \brief Shape evaluated by the SDF fragment shaders, the values match the constants in the shaders
+     */
+    enum class SDFShape : std::uint32_t
+    {
+        Circle    = 0,
+        Rectangle = 1
+    };
+
     /**
      * \brief Data structure containing transformation information for SDF shape rendering
      *
@@ -11,10 +11,15 @@
 #include "../OpenGL/GL.hpp"
 #include "Engine/Engine.hpp"
 #include "Engine/Error.hpp"
+#include "Engine/Hash.hpp"
 #include "Engine/Logger.hpp"
 #include "OpenGL/Environment.hpp"
+#include "OpenGL/ProgramCache.hpp"
 #include <GL/glew.h>
+#include <algorithm>
 #include <cassert>
+#include <initializer_list>
+#include <string_view>
 
 namespace
 {
@@ -34,6 +39,81 @@ namespace
         assert(false && "Unknown severity level!");
     }
 #endif
+
+    // Emscripten reports WebGL extensions both as "WEBGL_x" and "GL_WEBGL_x"
+    bool has_extension(std::initializer_list<std::string_view> names)
+    {
+        GLint extension_count = 0;
+        GL::GetIntegerv(GL_NUM_EXTENSIONS, &extension_count);
+        for (GLint i = 0; i < extension_count; ++i)
+        {
+            const auto* extension = reinterpret_cast<const char*>(GL::GetStringi(GL_EXTENSIONS, static_cast<GLuint>(i)));
+            if (extension != nullptr && std::find(names.begin(), names.end(), std::string_view{ extension }) != names.end())
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    bool has_buffer_storage()
+    {
+        if constexpr (OpenGL::IsWebGL)
+        {
+            return false;
+        }
+        else
+        {
+            return OpenGL::current_version() >= OpenGL::version(4, 4) || has_extension({ "GL_ARB_buffer_storage" });
+        }
+    }
+
+    void detect_texture_compression()
+    {
+        if constexpr (OpenGL::IsWebGL)
+        {
+            OpenGL::HasETC2 = has_extension({ "WEBGL_compressed_texture_etc", "GL_WEBGL_compressed_texture_etc" });
+            OpenGL::HasS3TC = has_extension({ "WEBGL_compressed_texture_s3tc", "GL_WEBGL_compressed_texture_s3tc" });
+            OpenGL::HasBPTC = has_extension({ "EXT_texture_compression_bptc", "GL_EXT_texture_compression_bptc" });
+        }
+        else
+        {
+            OpenGL::HasETC2 = OpenGL::current_version() >= OpenGL::version(4, 3) || has_extension({ "GL_ARB_ES3_compatibility" });
+            OpenGL::HasS3TC = has_extension({ "GL_EXT_texture_compression_s3tc" });
+            OpenGL::HasBPTC = OpenGL::current_version() >= OpenGL::version(4, 2) || has_extension({ "GL_ARB_texture_compression_bptc" });
+        }
+    }
+
+    float max_anisotropy()
+    {
+        const bool supported = (!OpenGL::IsWebGL && OpenGL::current_version() >= OpenGL::version(4, 6)) ||
+                               has_extension({ "GL_ARB_texture_filter_anisotropic", "GL_EXT_texture_filter_anisotropic", "EXT_texture_filter_anisotropic" });
+        GLfloat max_value = 1.0f;
+        if (supported)
+        {
+            GL::GetFloatv(GL_MAX_TEXTURE_MAX_ANISOTROPY, &max_value);
+        }
+        return max_value;
+    }
+
+    bool has_program_binary()
+    {
+        if constexpr (OpenGL::IsWebGL)
+        {
+            return false;
+        }
+        else
+        {
+            if (OpenGL::current_version() < OpenGL::version(4, 1) && !has_extension({ "GL_ARB_get_program_binary" }))
+            {
+                return false;
+            }
+            // some drivers expose the entry points but no format, there is nothing to store then
+            GLint format_count = 0;
+            GL::GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+            return format_count > 0;
+        }
+    }
 }
 
 namespace CS200::RenderingAPI
@@ -54,6 +134,11 @@ namespace CS200::RenderingAPI
 
         GL::GetIntegerv(GL_MAX_TEXTURE_IMAGE_UNITS, &OpenGL::MaxTextureImageUnits);
         GL::GetIntegerv(GL_MAX_TEXTURE_SIZE, &OpenGL::MaxTextureSize);
+        OpenGL::HasBufferStorage = has_buffer_storage();
+        detect_texture_compression();
+        OpenGL::MaxAnisotropy            = max_anisotropy();
+        OpenGL::HasProgramBinary         = has_program_binary();
+        OpenGL::HasParallelShaderCompile = has_extension({ "GL_KHR_parallel_shader_compile", "GL_ARB_parallel_shader_compile", "KHR_parallel_shader_compile" });
 
 #if defined(DEVELOPER_VERSION) && not defined(IS_WEBGL2)
         if (OpenGL::current_version() >= OpenGL::version(4, 3))
@@ -81,6 +166,8 @@ namespace CS200::RenderingAPI
         Engine::GetLogger().LogEvent("Version: " + std::string(version));
         Engine::GetLogger().LogEvent("GLSL Version: " + std::string(shading_lang_version));
 
+        OpenGL::DriverHash = util::hash_bytes(version, util::hash_bytes(renderer, util::hash_bytes(vendor)));
+
         GLint majorVersion = 0;
         GL::GetIntegerv(GL_MAJOR_VERSION, &majorVersion);
         Engine::GetLogger().LogEvent("Major Version: " + std::to_string(majorVersion));
@@ -108,6 +195,10 @@ namespace CS200::RenderingAPI
         GLint dims[2] = { 0, 0 };
         GL::GetIntegerv(GL_MAX_VIEWPORT_DIMS, dims);
         Engine::GetLogger().LogEvent("Max Viewport Dimensions: " + std::to_string(dims[0]) + " x " + std::to_string(dims[1]));
+
+        const auto yes_no = [](bool supported) { return supported ? std::string{ "yes" } : std::string{ "no" }; };
+        Engine::GetLogger().LogEvent("Texture Compression: BPTC " + yes_no(OpenGL::HasBPTC) + ", S3TC " + yes_no(OpenGL::HasS3TC) + ", ETC2 " + yes_no(OpenGL::HasETC2));
+        Engine::GetLogger().LogEvent("Max Anisotropy: " + std::to_string(OpenGL::MaxAnisotropy));
     }
 
     void SetClearColor(CS200::RGBA color) noexcept
@@ -118,7 +209,7 @@ namespace CS200::RenderingAPI
 
     void Clear() noexcept
     {
-        GL::Clear(GL_COLOR_BUFFER_BIT);
+        GL::Clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
     }
 
     void SetViewport(Math::ivec2 size, Math::ivec2 anchor_left_bottom) noexcept
@@ -10,6 +10,7 @@
 #include "DemoCS230Textures.hpp"
 
 #include "CS200/IRenderer2D.hpp"
+#include "CS200/RenderQueue2D.hpp"
 #include "CS200/RenderingAPI.hpp"
 #include "DemoTexturing.hpp"
 #include "Engine/Engine.hpp"
@@ -18,6 +19,7 @@
 #include "Engine/Texture.hpp"
 #include "Engine/TextureManager.hpp"
 #include "Engine/Window.hpp"
+#include "OpenGL/GL.hpp"
 
 #include <cmath>
 #include <imgui.h>
@@ -25,15 +27,17 @@
 void DemoCS230Textures::Load()
 {
     auto&      texture_manager        = Engine::GetTextureManager();
+    texture_manager.SetAtlasMode(true);
     const auto background_image_paths = { "Assets/images/DemoCS230Textures/Planets.png", "Assets/images/DemoCS230Textures/Ships.png", "Assets/images/DemoCS230Textures/Foreground.png" };
     for (const auto& path : background_image_paths)
     {
-        backgroundTextures.push_back(texture_manager.Load(path));
+        backgroundTextures.push_back(texture_manager.LoadAsync(path));
     }
 
-    robotTexture = texture_manager.Load("Assets/images/DemoCS230Textures/Robot.png");
-    catTexture   = texture_manager.Load("Assets/images/DemoCS230Textures/Cat.png");
+    robotTexture = texture_manager.LoadAsync("Assets/images/DemoCS230Textures/Robot.png");
+    catTexture   = texture_manager.LoadAsync("Assets/images/DemoCS230Textures/Cat.png");
 
+    Engine::GetRenderQueue2D().SetDepthPasses(true);
     initializeRobotAnimations();
     initializeCatAnimations();
 
@@ -70,13 +74,20 @@ void DemoCS230Textures::Draw() const
     const auto window_size = Engine::GetWindow().GetSize();
     renderer_2d.BeginScene(CS200::build_ndc_matrix(window_size));
 
-    const auto background_tint = CS200::pack_color(backgroundTintColor);
+    // parallax layers overlap, layer 0 keeps them in submission order
+    auto& render_queue = Engine::GetRenderQueue2D();
+    render_queue.SetLayer(0);
+
+    // the first background is the farthest, opaque ones are then drawn front-to-back by the depth pass
+    const auto background_tint  = CS200::pack_color(backgroundTintColor);
+    double     background_depth = 0.9;
     for (const auto& texture : backgroundTextures)
     {
-        texture->Draw(Math::TransformationMatrix{}, background_tint);
+        texture->Draw(Math::TransformationMatrix{}, background_tint, background_depth);
+        background_depth -= 0.1;
     }
 
-    CS230::Texture*  currentTexture = (selectedCharacter == CharacterType::Robot) ? robotTexture : catTexture;
+    CS230::Texture*  currentTexture = (selectedCharacter == CharacterType::Robot) ? robotTexture.Get() : catTexture.Get();
     const auto       middle_x       = Engine::GetWindowEnvironment().DisplaySize.x / 2.0;
     const auto       texel_base     = getCurrentFrameTexelPosition();
     const auto       frame_size     = getCurrentFrameSize();
@@ -89,7 +100,8 @@ void DemoCS230Textures::Draw() const
     const auto translate = Math::TranslationMatrix(Math::vec2{ middle_x, floor_y });
     const auto transform = translate * scale * to_center;
     const auto character_tint = CS200::pack_color(characterTintColor);
-    currentTexture->Draw(transform, texel_base, frame_size, character_tint);
+    render_queue.SetLayer(1);
+    currentTexture->Draw(transform, texel_base, frame_size, character_tint, 0.5);
     renderer_2d.EndScene();
 }
 
@@ -99,6 +111,14 @@ void DemoCS230Textures::DrawImGui()
     {
         const auto timing = Engine::GetWindowEnvironment();
         ImGui::LabelText("FPS", "%d", timing.FPS);
+        const auto gl_calls = GL::GetStateCacheStats();
+        ImGui::LabelText("GL state calls", "%u issued / %u skipped", gl_calls.Issued, gl_calls.Skipped);
+        const auto& queue_stats = Engine::GetRenderQueue2D().GetStatistics();
+        ImGui::LabelText("Render commands", "%u (%u opaque, %u radix passes)", queue_stats.Commands, queue_stats.Opaque, queue_stats.SortPasses);
+        ImGui::LabelText("Atlas pages", "%zu (%zu textures loading)", Engine::GetTextureManager().GetAtlasPageCount(), Engine::GetTextureManager().GetPendingCount());
+        constexpr double mebibyte = 1024.0 * 1024.0;
+        ImGui::LabelText("Texture memory", "%.1f / %.1f MiB (%zu evicted)", static_cast<double>(Engine::GetTextureManager().GetResidentBytes()) / mebibyte,
+                         static_cast<double>(Engine::GetTextureManager().GetBudget()) / mebibyte, Engine::GetTextureManager().GetEvictionCount());
         ImGui::SeparatorText("Tint Color Controls");
         ImGui::ColorEdit4("Background Tint", targetBackgroundTintColor.data());
         ImGui::ColorEdit4("Character Tint", targetCharacterTintColor.data());
@@ -205,11 +225,12 @@ void DemoCS230Textures::DrawImGui()
 
 void DemoCS230Textures::Unload()
 {
-    auto& texture_manager = Engine::GetTextureManager();
-    texture_manager.Unload();
+    // the released textures stay cached until the texture budget needs their memory
+    Engine::GetTextureManager().SetAtlasMode(false);
+    Engine::GetRenderQueue2D().SetDepthPasses(false);
     backgroundTextures.clear();
-    robotTexture = nullptr;
-    catTexture   = nullptr;
+    robotTexture.Reset();
+    catTexture.Reset();
 }
 
 gsl::czstring DemoCS230Textures::GetName() const
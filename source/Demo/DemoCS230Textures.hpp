@@ -10,17 +10,13 @@
 #pragma once
 
 #include "Engine/GameState.hpp"
+#include "Engine/TextureManager.hpp"
 #include "Engine/Vec2.hpp"
 #include <array>
 #include <memory>
 #include <string>
 #include <vector>
 
-namespace CS230
-{
-    class Texture;
-}
-
 class DemoCS230Textures : public CS230::GameState
 {
 public:
@@ -94,13 +90,13 @@ private:
         }
     };
 
-    std::vector<CS230::Texture*> backgroundTextures;
-    CS230::Texture*              robotTexture              = nullptr;
-    CS230::Texture*              catTexture                = nullptr;
-    std::array<float, 4>         backgroundTintColor       = { 0.1f, 0.2f, 0.3f, 0.4f };
-    std::array<float, 4>         characterTintColor        = { 0.4f, 0.3f, 0.2f, 0.1f };
-    std::array<float, 4>         targetBackgroundTintColor = { 1.0f, 1.0f, 1.0f, 1.0f };
-    std::array<float, 4>         targetCharacterTintColor  = { 1.0f, 1.0f, 1.0f, 1.0f };
+    std::vector<CS230::TextureRef> backgroundTextures;
+    CS230::TextureRef              robotTexture{};
+    CS230::TextureRef              catTexture{};
+    std::array<float, 4>           backgroundTintColor       = { 0.1f, 0.2f, 0.3f, 0.4f };
+    std::array<float, 4>           characterTintColor        = { 0.4f, 0.3f, 0.2f, 0.1f };
+    std::array<float, 4>           targetBackgroundTintColor = { 1.0f, 1.0f, 1.0f, 1.0f };
+    std::array<float, 4>           targetCharacterTintColor  = { 1.0f, 1.0f, 1.0f, 1.0f };
 
     // Character selection and animation state
     CharacterType          selectedCharacter = CharacterType::Cat;
@@ -17,10 +17,13 @@
 #include "Engine/GameStateManager.hpp"
 #include "Engine/Logger.hpp"
 #include "Engine/Random.hpp"
+#include "Engine/TextureManager.hpp"
 #include "Engine/Window.hpp"
 #include "OpenGL/Buffer.hpp"
 #include "OpenGL/GL.hpp"
+#include "OpenGL/TextureUploader.hpp"
 #include <cmath>
+#include <cstdint>
 #include <imgui.h>
 #include <limits>
 #include <numbers>
@@ -28,6 +31,7 @@
 
 void DemoTexturing::Load()
 {
+    // the variant of the starting settings builds on driver threads while the textures below are decoded and generated
     loadShaders();
     createQuadModel();
 
@@ -41,15 +45,17 @@ void DemoTexturing::Load()
 
 void DemoTexturing::Unload()
 {
-    OpenGL::DestroyShader(texturingCombineShader);
+    combineShaders.Destroy();
+    combineUniforms.clear();
     GL::DeleteTextures(1, &duckTextureHandle), duckTextureHandle                = 0;
     GL::DeleteTextures(1, &noiseTextureHandle), noiseTextureHandle              = 0;
     GL::DeleteTextures(1, &logoTextureHandle), logoTextureHandle                = 0;
-    GL::DeleteBuffers(1, &quad.positionBufferHandle), quad.positionBufferHandle = 0;
-    GL::DeleteBuffers(1, &quad.colorBufferHandle), quad.colorBufferHandle       = 0;
-    GL::DeleteBuffers(1, &quad.texCoordBufferHandle), quad.texCoordBufferHandle = 0;
-    GL::DeleteBuffers(1, &quad.indexBufferHandle), quad.indexBufferHandle       = 0;
-    GL::DeleteVertexArrays(1, &quad.modelHandle), quad.modelHandle              = 0;
+    if (models != nullptr)
+    {
+        models->Remove(quad);
+        models = nullptr;
+    }
+    quad = {};
 
     // other demos assume blending is enabled
     GL::Enable(GL_BLEND);
@@ -82,6 +88,8 @@ void DemoTexturing::Update()
 void DemoTexturing::Draw() const
 {
     CS200::RenderingAPI::Clear();
+    // drawn with its own shader, only the camera is needed from the 2D renderers
+    CS200::Renderer2DUtils::PublishCamera(CS200::build_ndc_matrix(Engine::GetWindow().GetSize()));
 
     if (settings.DoBlending)
     {
@@ -93,7 +101,7 @@ void DemoTexturing::Draw() const
         GL::Disable(GL_BLEND);
     }
 
-    GL::UseProgram(texturingCombineShader.Shader);
+    const auto& locations = useCombineShader();
     GL::ActiveTexture(GL_TEXTURE0);
 
     // Choose which texture to bind based on settings
@@ -104,34 +112,14 @@ void DemoTexturing::Draw() const
         case TextureType::Logo: GL::BindTexture(GL_TEXTURE_2D, logoTextureHandle); break;
     }
 
-
-    const auto& locations = texturingCombineShader.UniformLocations;
-    GL::Uniform1i(locations.at("uTex2d"), 0);
-    GL::Uniform1f(locations.at("uTexCoordScale"), static_cast<float>(settings.TexCoordScale));
-    GL::Uniform1f(locations.at("uModulateColor"), static_cast<float>(settings.ModulateColor));
-    GL::Uniform1f(locations.at("uProcTex"), static_cast<float>(settings.ApplyProceduralTexture));
-    GL::Uniform1f(locations.at("uTileSize"), static_cast<float>(settings.ProceduralTileSize));
-    GL::Uniform1f(locations.at("uUseImage"), static_cast<float>(settings.UseTexture));
-    GL::Uniform1i(locations.at("uUseTextureAlpha"), settings.DoBlending);
-    const auto window_size      = Engine::GetWindow().GetSize();
-    const auto to_ndc_transform = CS200::build_ndc_matrix(window_size);
-    const auto to_ndc_opengl    = CS200::Renderer2DUtils::to_opengl_mat3(to_ndc_transform);
-    GL::UniformMatrix3fv(locations.at("uToNDC"), 1, GL_FALSE, to_ndc_opengl.data());
+    GL::Uniform1i(locations[Tex2d], 0);
+    GL::Uniform1f(locations[TexCoordScale], static_cast<float>(settings.TexCoordScale));
+    GL::Uniform1f(locations[TileSize], static_cast<float>(settings.ProceduralTileSize));
     const auto screen_size  = Engine::GetWindowEnvironment().DisplaySize;
     const auto model_matrix = CS200::Renderer2DUtils::to_opengl_mat3(Math::TranslationMatrix(screen_size * 0.5) * Math::ScaleMatrix(std::min(screen_size.x, screen_size.y)));
-    GL::UniformMatrix3fv(locations.at("uModel"), 1, GL_FALSE, model_matrix.data());
-
-    GL::BindVertexArray(quad.modelHandle);
+    GL::UniformMatrix3fv(locations[Model], 1, GL_FALSE, model_matrix.data());
 
-    constexpr GLenum  primitive_pattern        = GL_TRIANGLES;
-    constexpr GLenum  indices_type             = GL_UNSIGNED_BYTE;
-    constexpr GLvoid* byte_offset_into_indices = nullptr;
-    GL::DrawElements(primitive_pattern, quad.indicesCount, indices_type, byte_offset_into_indices);
-
-
-    GL::BindTexture(GL_TEXTURE_2D, 0);
-    GL::BindVertexArray(0);
-    GL::UseProgram(0);
+    models->Draw(quad, GL_TRIANGLES);
 }
 
 void DemoTexturing::DrawImGui()
@@ -205,65 +193,80 @@ gsl::czstring DemoTexturing::GetName() const
 
 void DemoTexturing::loadShaders()
 {
-    using namespace std::filesystem;
-    texturingCombineShader = OpenGL::CreateShader(path{ "Assets/shaders/DemoTexturing/combine.vert" }, path{ "Assets/shaders/DemoTexturing/combine.frag" });
+    using std::filesystem::path;
+    combineShaders = OpenGL::ShaderVariants(path{ "Assets/shaders/DemoTexturing/combine.vert" }, path{ "Assets/shaders/DemoTexturing/combine.frag" });
+
+    combineFeatures.ModulateColor     = combineShaders.GetFeatureBit("MODULATE_COLOR");
+    combineFeatures.ProceduralTexture = combineShaders.GetFeatureBit("PROCEDURAL_TEXTURE");
+    combineFeatures.UseImage          = combineShaders.GetFeatureBit("USE_IMAGE");
+    combineFeatures.UseTextureAlpha   = combineShaders.GetFeatureBit("USE_TEXTURE_ALPHA");
+    combineShaders.Prepare(selectedFeatures());
 }
 
-void DemoTexturing::createQuadModel()
+OpenGL::ShaderVariants::FeatureMask DemoTexturing::selectedFeatures() const noexcept
 {
-    struct position
-    {
-        float x, y;
-    };
+    OpenGL::ShaderVariants::FeatureMask features = 0;
+    if (settings.ModulateColor)
+        features |= combineFeatures.ModulateColor;
+    if (settings.ApplyProceduralTexture)
+        features |= combineFeatures.ProceduralTexture;
+    if (settings.UseTexture)
+        features |= combineFeatures.UseImage;
+    // texture alpha only matters when there is a texture, this keeps two identical variants from being built
+    if (settings.UseTexture && settings.DoBlending)
+        features |= combineFeatures.UseTextureAlpha;
+    return features;
+}
 
-    struct texture_coordinate
+const std::array<GLint, DemoTexturing::CombineUniformCount>& DemoTexturing::useCombineShader() const
+{
+    const OpenGL::ShaderVariants::FeatureMask features = selectedFeatures();
+    const OpenGL::CompiledShader&             shader   = combineShaders.Get(features);
+    GL::UseProgram(shader.Shader);
+
+    CombineLocations& locations = combineUniforms[features];
+    if (locations.Program != shader.Shader)
     {
-        float s, t;
-    };
+        locations.Program = shader.Shader;
+        // looked up directly rather than with ResolveUniforms(), a uniform compiled out of this variant is expected
+        locations.Uniforms = { shader.GetUniformLocation("uTex2d"), shader.GetUniformLocation("uTexCoordScale"), shader.GetUniformLocation("uTileSize"),
+                               shader.GetUniformLocation("uModel") };
+        // Draw() fills the shared camera uniform buffer
+        OpenGL::SetUniformBlockBinding(shader.Shader, CS200::Renderer2DUtils::CameraBlockBinding, "Camera");
+    }
+    return locations.Uniforms;
+}
 
-    struct color
+void DemoTexturing::createQuadModel()
+{
+    struct vertex
     {
-        unsigned char rgb[3];
+        float         x, y;
+        unsigned char rgba[4]; // the shader reads rgb, alpha only pads the vertex to 4 bytes
+        float         s, t;
     };
 
-    constexpr std::array positions = {
-        position{ -0.5f, -0.5f }, // bottom-left
-        position{ -0.5f,  0.5f }, // top-left
-        position{  0.5f,  0.5f }, // top-right
-        position{  0.5f, -0.5f }  // bottom-right
-    };
-    constexpr std::array colors = {
-        color{ 255,   0,   0 }, // bottom-left
-        color{ 255,   0, 255 }, // top-left
-        color{   0,   0, 255 }, // top-right
-        color{   0, 255,   0 }  // bottom-right
-    };
-    constexpr std::array texture_coordinates = {
-        texture_coordinate{ 0.0f, 0.0f }, // bottom-left
-        texture_coordinate{ 0.0f, 1.0f }, // top-left
-        texture_coordinate{ 1.0f, 1.0f }, // top-right
-        texture_coordinate{ 1.0f, 0.0f }  // bottom-right
+    constexpr std::array vertices = {
+        vertex{ -0.5f, -0.5f, { 255,   0,   0, 255 }, 0.0f, 0.0f }, // bottom-left
+        vertex{ -0.5f,  0.5f, { 255,   0, 255, 255 }, 0.0f, 1.0f }, // top-left
+        vertex{  0.5f,  0.5f, {   0,   0, 255, 255 }, 1.0f, 1.0f }, // top-right
+        vertex{  0.5f, -0.5f, {   0, 255,   0, 255 }, 1.0f, 0.0f }  // bottom-right
     };
 
-    constexpr std::array<unsigned char, 6> indices = { 0, 3, 2, 0, 2, 1 };
-
-    quad.positionBufferHandle = OpenGL::CreateBuffer(OpenGL::BufferType::Vertices, std::as_bytes(std::span{ positions }));
-    quad.colorBufferHandle    = OpenGL::CreateBuffer(OpenGL::BufferType::Vertices, std::as_bytes(std::span{ colors }));
-    quad.texCoordBufferHandle = OpenGL::CreateBuffer(OpenGL::BufferType::Vertices, std::as_bytes(std::span{ texture_coordinates }));
-    quad.indexBufferHandle    = OpenGL::CreateBuffer(OpenGL::BufferType::Indices, std::as_bytes(std::span{ indices }));
-    quad.indicesCount         = static_cast<GLsizei>(indices.size());
-    const auto layout         = {
-        OpenGL::VertexBuffer{ quad.positionBufferHandle,             { OpenGL::Attribute::Float2 } },
-        OpenGL::VertexBuffer{    quad.colorBufferHandle, { OpenGL::Attribute::UByte3ToNormalized } },
-        OpenGL::VertexBuffer{ quad.texCoordBufferHandle,             { OpenGL::Attribute::Float2 } }
-    };
-    quad.modelHandle = OpenGL::CreateVertexArrayObject(layout, quad.indexBufferHandle);
+    constexpr std::array<std::uint32_t, 6> indices = { 0, 3, 2, 0, 2, 1 };
+
+    models = &OpenGL::GetSharedGeometryArena(OpenGL::BufferLayout{
+        { OpenGL::Attribute::Float2, OpenGL::Attribute::UByte4ToNormalized, OpenGL::Attribute::Float2 }
+    });
+    quad = models->Add(std::as_bytes(std::span{ vertices }), indices);
 }
 
 void DemoTexturing::imgui_pick_filtering()
 {
-    constexpr const char*       items[]             = { "NearestPixel", "Linear" };
-    constexpr OpenGL::Filtering types[]             = { OpenGL::Filtering::NearestPixel, OpenGL::Filtering::Linear };
+    constexpr const char*       items[]             = { "NearestPixel", "Linear", "NearestMipmapNearest", "LinearMipmapNearest", "NearestMipmapLinear", "LinearMipmapLinear" };
+    constexpr OpenGL::Filtering types[]             = { OpenGL::Filtering::NearestPixel,        OpenGL::Filtering::Linear,
+                                                        OpenGL::Filtering::NearestMipmapNearest, OpenGL::Filtering::LinearMipmapNearest,
+                                                        OpenGL::Filtering::NearestMipmapLinear,  OpenGL::Filtering::LinearMipmapLinear };
     const char* const           combo_preview_value = items[settings.FilteringIndex];
     if (ImGui::BeginCombo("Texture Filtering", combo_preview_value, 0))
     {
@@ -315,7 +318,12 @@ void DemoTexturing::createNoiseTexture()
     constexpr Math::ivec2 texture_size{ 128, 128 };
     noiseTextureHandle = OpenGL::CreateRGBATexture(texture_size, OpenGL::Filtering::NearestPixel, OpenGL::Wrapping::Repeat);
 
-    std::vector<CS200::RGBA> pixels(128 * 128);
+    // Write the texels straight into a pixel unpack buffer when one is free, no copy is made afterwards
+    constexpr std::size_t    pixel_count = 128 * 128;
+    OpenGL::TextureUploader& uploader    = Engine::GetTextureManager().GetUploader();
+    const auto               staging     = uploader.Reserve(pixel_count * sizeof(CS200::RGBA));
+    std::vector<CS200::RGBA> fallback(staging ? 0 : pixel_count);
+    const std::span          pixels = staging ? std::span{ reinterpret_cast<CS200::RGBA*>(staging.Memory.data()), pixel_count } : std::span{ fallback };
 
     constexpr static float NoiseLacunarity = 2.0f;
     constexpr static float NoiseGain       = 0.5f;
@@ -352,9 +360,15 @@ void DemoTexturing::createNoiseTexture()
     }
 
     // Upload the pixel data to the texture
-    GL::BindTexture(GL_TEXTURE_2D, noiseTextureHandle);
-    GL::TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texture_size.x, texture_size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
-    GL::BindTexture(GL_TEXTURE_2D, 0);
+    if (staging)
+    {
+        uploader.Submit(staging, noiseTextureHandle, 0, { 0, 0 }, texture_size);
+    }
+    else
+    {
+        GL::BindTexture(GL_TEXTURE_2D, noiseTextureHandle);
+        GL::TexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, texture_size.x, texture_size.y, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+    }
 }
 
 void DemoTexturing::createLogoTexture()
@@ -8,11 +8,11 @@
 #include "CS200/NDC.hpp"
 #include "CS200/RGBA.hpp"
 #include "Engine/GameState.hpp"
-#include "OpenGL/Buffer.hpp"
+#include "OpenGL/GeometryArena.hpp"
 #include "OpenGL/Shader.hpp"
 #include "OpenGL/Texture.hpp"
-#include "OpenGL/VertexArray.hpp"
 #include <array>
+#include <unordered_map>
 #include <vector>
 
 class DemoTexturing : public CS230::GameState
@@ -26,17 +26,36 @@ public:
     gsl::czstring GetName() const override;
 
 private:
-    OpenGL::CompiledShader texturingCombineShader{};
+    // one program per combination of the effect toggles, Draw() builds the ones it needs on first use
+    mutable OpenGL::ShaderVariants combineShaders{};
 
-    struct object
+    struct CombineFeatures
     {
-        OpenGL::BufferHandle      positionBufferHandle{};
-        OpenGL::BufferHandle      colorBufferHandle{};
-        OpenGL::BufferHandle      texCoordBufferHandle{};
-        OpenGL::BufferHandle      indexBufferHandle{};
-        GLsizei                   indicesCount{};
-        OpenGL::VertexArrayHandle modelHandle{};
-    } quad{};
+        OpenGL::ShaderVariants::FeatureMask ModulateColor     = 0;
+        OpenGL::ShaderVariants::FeatureMask ProceduralTexture = 0;
+        OpenGL::ShaderVariants::FeatureMask UseImage          = 0;
+        OpenGL::ShaderVariants::FeatureMask UseTextureAlpha   = 0;
+    } combineFeatures;
+
+    enum CombineUniform : std::size_t
+    {
+        Tex2d,
+        TexCoordScale,
+        TileSize,
+        Model,
+        CombineUniformCount
+    };
+
+    struct CombineLocations
+    {
+        OpenGL::ShaderHandle                   Program = 0; // resolved again when a hot reload replaced the variant
+        std::array<GLint, CombineUniformCount> Uniforms{};  // indexed by CombineUniform, -1 for what a variant compiled out
+    };
+
+    mutable std::unordered_map<OpenGL::ShaderVariants::FeatureMask, CombineLocations> combineUniforms{};
+
+    OpenGL::GeometryArena*      models = nullptr; // shared arena for position, color and texture coordinate interleaved
+    OpenGL::GeometryArena::Mesh quad{};
 
     constexpr static int QuadSize = 256;
 
@@ -72,6 +91,8 @@ private:
 
 private:
     void loadShaders();
+    [[nodiscard]] OpenGL::ShaderVariants::FeatureMask selectedFeatures() const noexcept;
+    const std::array<GLint, CombineUniformCount>& useCombineShader() const;
     void createQuadModel();
     void createNoiseTexture();
     void createLogoTexture();
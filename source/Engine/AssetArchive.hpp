@@ -0,0 +1,65 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Hash.hpp"
+#include <array>
+#include <cstdint>
+#include <string_view>
+
+/**
+ * \brief Layout of Assets.pak, shared by the engine loader in Path.cpp and the asset_packer tool
+ *
+ * An archive is a Header, SlotCount uint32 hash slots, EntryCount Entry records, the entry names one
+ * after the other, then the file contents. Every blob starts at a multiple of BlobAlignment so the
+ * mapped bytes can be read as any type the file format calls for.
+ *
+ * Entries are named by their path relative to the project folder with '/' separators, exactly as
+ * the code spells them: "Assets/images/duck.png". A slot holds an entry index + 1, 0 when empty;
+ * a lookup starts at hash_path(name) & (SlotCount - 1) and probes linearly.
+ *
+ * Everything is little-endian, the archive is only read on the kind of machine that wrote it.
+ */
+namespace assets::archive
+{
+    constexpr std::array<char, 4> Magic         = { 'C', 'S', 'P', 'K' };
+    constexpr std::uint32_t       Version       = 1;
+    constexpr std::uint64_t       BlobAlignment = 16;
+    constexpr std::string_view    FileName      = "Assets.pak";
+
+    // part of the file format, the packer and the loader must agree on it
+    constexpr std::uint64_t hash_path(std::string_view path) noexcept
+    {
+        return util::hash_bytes(path);
+    }
+
+    struct Header
+    {
+        std::array<char, 4> Magic{};
+        std::uint32_t       Version       = 0;
+        std::uint32_t       EntryCount    = 0;
+        std::uint32_t       SlotCount     = 0; ///< power of two, at least twice EntryCount
+        std::uint64_t       SlotsOffset   = 0;
+        std::uint64_t       EntriesOffset = 0;
+        std::uint64_t       NamesOffset   = 0;
+        std::uint64_t       FileSize      = 0; ///< lets the loader reject a truncated copy
+    };
+
+    static_assert(sizeof(Header) == 48);
+
+    struct Entry
+    {
+        std::uint64_t PathHash   = 0;
+        std::uint64_t Offset     = 0; ///< from the start of the archive, a multiple of BlobAlignment
+        std::uint64_t Size       = 0;
+        std::uint32_t NameOffset = 0; ///< from Header::NamesOffset
+        std::uint32_t NameLength = 0;
+    };
+
+    static_assert(sizeof(Entry) == 32);
+}
@@ -0,0 +1,138 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#include "AssetId.hpp"
+#include "Hash.hpp"
+
+#include <deque>
+#include <string>
+#include <type_traits>
+
+namespace
+{
+    // the paths are short and this runs once per lookup, both halves are folded into the 32 bit slot hash
+    constexpr std::uint32_t hash_path(std::string_view path) noexcept
+    {
+        const std::uint64_t hash = util::hash_bytes(path);
+        return static_cast<std::uint32_t>(hash ^ (hash >> 32));
+    }
+
+    class Registry
+    {
+    public:
+        assets::AssetId Find(std::string_view path, std::uint32_t hash) const noexcept
+        {
+            if (slots.empty())
+            {
+                return assets::AssetId::Invalid;
+            }
+            for (std::size_t index = hash & mask();; index = (index + 1) & mask())
+            {
+                const std::uint32_t id = slots[index];
+                if (id == 0)
+                {
+                    return assets::AssetId::Invalid;
+                }
+                if (hashes[id - 1] == hash && paths[id - 1] == path)
+                {
+                    return static_cast<assets::AssetId>(id);
+                }
+            }
+        }
+
+        assets::AssetId Add(std::string_view path, std::uint32_t hash)
+        {
+            if ((paths.size() + 1) * 4 > slots.size() * 3)
+            {
+                grow();
+            }
+            // a deque never moves its strings, views returned by Path() stay valid
+            paths.emplace_back(path);
+            hashes.push_back(hash);
+            const auto id = static_cast<std::uint32_t>(paths.size());
+            place(id);
+            return static_cast<assets::AssetId>(id);
+        }
+
+        std::string_view Path(assets::AssetId id) const noexcept
+        {
+            const auto index = static_cast<std::size_t>(id);
+            return index == 0 || index > paths.size() ? std::string_view{} : std::string_view{ paths[index - 1] };
+        }
+
+    private:
+        std::size_t mask() const noexcept
+        {
+            return slots.size() - 1;
+        }
+
+        void place(std::uint32_t id)
+        {
+            std::size_t index = hashes[id - 1] & mask();
+            while (slots[index] != 0)
+            {
+                index = (index + 1) & mask();
+            }
+            slots[index] = id;
+        }
+
+        void grow()
+        {
+            slots.assign(slots.empty() ? 64 : slots.size() * 2, 0);
+            for (std::uint32_t id = 1; id <= paths.size(); ++id)
+            {
+                place(id);
+            }
+        }
+
+        std::vector<std::uint32_t> slots{};  // IDs, 0 marks an empty slot
+        std::vector<std::uint32_t> hashes{}; // by ID - 1, spares rehashing the strings when growing
+        std::deque<std::string>    paths{};  // by ID - 1
+    };
+
+    Registry& registry()
+    {
+        static Registry instance;
+        return instance;
+    }
+}
+
+namespace assets
+{
+    AssetId intern(std::string_view path)
+    {
+        const std::uint32_t hash = hash_path(path);
+        if (const AssetId id = registry().Find(path, hash); id != AssetId::Invalid)
+        {
+            return id;
+        }
+        return registry().Add(path, hash);
+    }
+
+    AssetId intern(const std::filesystem::path& path)
+    {
+        if constexpr (std::is_same_v<std::filesystem::path::value_type, char>)
+        {
+            return intern(std::string_view{ path.native() });
+        }
+        else
+        {
+            return intern(std::string_view{ path.string() });
+        }
+    }
+
+    AssetId find_id(std::string_view path) noexcept
+    {
+        return registry().Find(path, hash_path(path));
+    }
+
+    std::string_view get_path(AssetId id) noexcept
+    {
+        return registry().Path(id);
+    }
+}
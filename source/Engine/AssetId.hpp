@@ -0,0 +1,234 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <bit>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace assets
+{
+    /**
+     * \brief Interned asset path, the same path string always gets the same ID
+     *
+     * IDs are handed out from 1 in the order paths are first interned and stay valid for the
+     * whole run, 0 (Invalid) never names a path. Comparing or hashing an ID is a single integer
+     * operation, so caches keyed by it need neither a string nor an allocation per lookup.
+     *
+     * Paths are compared as written, "Assets/a.png" and "./Assets/a.png" are different assets.
+     *
+     * Example Usage:
+     * \code
+     * const assets::AssetId ship = assets::intern("Assets/ship.png"); // once, hashes and copies the path
+     * ...
+     * auto texture = Engine::GetTextureManager().Load(ship);          // every frame, no string work at all
+     * \endcode
+     *
+     * The registry is not synchronized, intern and look up IDs on the main thread.
+     */
+    enum class AssetId : std::uint32_t
+    {
+        Invalid = 0
+    };
+
+    /**
+     * \brief ID of a path, registering it when it was never seen
+     *
+     * Only the first call for a path allocates, later ones hash the view and probe the table.
+     */
+    AssetId intern(std::string_view path);
+
+    inline AssetId intern(const char* path)
+    {
+        return intern(std::string_view{ path });
+    }
+
+    inline AssetId intern(const std::string& path)
+    {
+        return intern(std::string_view{ path });
+    }
+
+    /**
+     * \brief ID of a path, without a copy when the native path encoding is char
+     */
+    AssetId intern(const std::filesystem::path& path);
+
+    /**
+     * \brief ID of an already interned path, AssetId::Invalid otherwise
+     */
+    [[nodiscard]] AssetId find_id(std::string_view path) noexcept;
+
+    /**
+     * \brief Path an ID was interned from, empty for AssetId::Invalid
+     */
+    [[nodiscard]] std::string_view get_path(AssetId id) noexcept;
+
+    /**
+     * \brief Open addressing hash map from AssetId to Value
+     *
+     * Slots live in one array probed linearly, so a lookup is a multiply, a mask and usually one
+     * comparison. Meant for the caches of the asset managers, any asset type can use it.
+     *
+     * Pointers and references to values are invalidated when the map grows or an entry is erased,
+     * store values behind a std::unique_ptr when they must stay put.
+     */
+    template <typename Value>
+    class IdMap
+    {
+    public:
+        [[nodiscard]] Value* Find(AssetId id) noexcept
+        {
+            if (id == AssetId::Invalid || slots.empty())
+            {
+                return nullptr;
+            }
+            for (std::size_t index = home(id);; index = (index + 1) & mask())
+            {
+                if (slots[index].Id == id)
+                {
+                    return &slots[index].Stored;
+                }
+                if (slots[index].Id == AssetId::Invalid)
+                {
+                    return nullptr;
+                }
+            }
+        }
+
+        [[nodiscard]] const Value* Find(AssetId id) const noexcept
+        {
+            return const_cast<IdMap*>(this)->Find(id);
+        }
+
+        /**
+         * \brief Value of id, default constructed when it is not in the map yet
+         */
+        Value& operator[](AssetId id)
+        {
+            if (Value* existing = Find(id); existing != nullptr)
+            {
+                return *existing;
+            }
+            // keep at least a quarter of the slots empty so probe sequences stay short
+            if ((count + 1) * 4 > slots.size() * 3)
+            {
+                rehash(slots.empty() ? MinimumCapacity : slots.size() * 2);
+            }
+            std::size_t index = home(id);
+            while (slots[index].Id != AssetId::Invalid)
+            {
+                index = (index + 1) & mask();
+            }
+            slots[index].Id = id;
+            ++count;
+            return slots[index].Stored;
+        }
+
+        /**
+         * \brief Remove id, returns false when it was not in the map
+         */
+        bool Erase(AssetId id)
+        {
+            if (Find(id) == nullptr)
+            {
+                return false;
+            }
+            std::size_t hole = home(id);
+            while (slots[hole].Id != id)
+            {
+                hole = (hole + 1) & mask();
+            }
+            // backward shift deletion, move later entries of the probe sequence into the hole so no tombstones are needed
+            for (std::size_t next = (hole + 1) & mask(); slots[next].Id != AssetId::Invalid; next = (next + 1) & mask())
+            {
+                const std::size_t wanted = home(slots[next].Id);
+                // next may move into hole unless its home lies cyclically in (hole, next]
+                if (((next - wanted) & mask()) >= ((next - hole) & mask()))
+                {
+                    slots[hole] = std::move(slots[next]);
+                    hole        = next;
+                }
+            }
+            slots[hole] = Slot{};
+            --count;
+            return true;
+        }
+
+        void Clear()
+        {
+            slots.clear();
+            count = 0;
+        }
+
+        [[nodiscard]] std::size_t Size() const noexcept
+        {
+            return count;
+        }
+
+        /**
+         * \brief Call function(AssetId, Value&) for every entry, in no particular order
+         */
+        template <typename Function>
+        void ForEach(Function&& function)
+        {
+            for (Slot& slot : slots)
+            {
+                if (slot.Id != AssetId::Invalid)
+                {
+                    function(slot.Id, slot.Stored);
+                }
+            }
+        }
+
+    private:
+        static constexpr std::size_t MinimumCapacity = 16;
+
+        struct Slot
+        {
+            AssetId Id = AssetId::Invalid;
+            Value   Stored{};
+        };
+
+        [[nodiscard]] std::size_t mask() const noexcept
+        {
+            return slots.size() - 1;
+        }
+
+        [[nodiscard]] std::size_t home(AssetId id) const noexcept
+        {
+            // IDs are sequential, Fibonacci hashing spreads neighbours over the table
+            const std::uint32_t scrambled = static_cast<std::uint32_t>(id) * 0x9E3779B9u;
+            return static_cast<std::size_t>(scrambled >> (32 - std::countr_zero(slots.size())));
+        }
+
+        void rehash(std::size_t capacity)
+        {
+            std::vector<Slot> old = std::exchange(slots, std::vector<Slot>(capacity));
+            for (Slot& slot : old)
+            {
+                if (slot.Id == AssetId::Invalid)
+                {
+                    continue;
+                }
+                std::size_t index = home(slot.Id);
+                while (slots[index].Id != AssetId::Invalid)
+                {
+                    index = (index + 1) & mask();
+                }
+                slots[index] = std::move(slot);
+            }
+        }
+
+        std::vector<Slot> slots{};
+        std::size_t       count = 0;
+    };
+}
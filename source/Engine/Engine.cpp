@@ -8,14 +8,20 @@
  */
 #include "Engine.hpp"
 #include "CS200/ImGuiHelper.hpp"
-#include "CS200/ImmediateRenderer2D.hpp"
+#include "CS200/BatchRenderer2D.hpp"
 #include "CS200/NDC.hpp"
+#include "CS200/RenderQueue2D.hpp"
+#include "CS200/Renderer2DUtils.hpp"
 #include "CS200/RenderingAPI.hpp"
 #include "FPS.hpp"
+#include "FileWatcher.hpp"
 #include "GameState.hpp"
 #include "GameStateManager.hpp"
 #include "Input.hpp"
 #include "Logger.hpp"
+#include "OpenGL/GL.hpp"
+#include "OpenGL/GeometryArena.hpp"
+#include "OpenGL/Shader.hpp"
 #include "TextureManager.hpp"
 #include "Timer.hpp"
 #include "Window.hpp"
@@ -45,8 +51,10 @@ public:
     util::FPS                  fps{};
     util::Timer                timer{};
     WindowEnvironment          environment{};
+    util::FileWatcher          fileWatcher{}; // before everything that watches files, so it is destroyed last
     CS230::GameStateManager    gameStateManager{};
-    CS200::ImmediateRenderer2D renderer2D{};
+    CS200::BatchRenderer2D     renderer2D{ CS200::BatchRenderer2D::Mode::Instanced };
+    CS200::RenderQueue2D       renderQueue2D{ renderer2D };
     CS230::TextureManager      textureManager{};
 };
 
@@ -83,7 +91,12 @@ CS230::GameStateManager& Engine::GetGameStateManager()
 
 CS200::IRenderer2D& Engine::GetRenderer2D()
 {
-    return Instance().impl->renderer2D;
+    return Instance().impl->renderQueue2D;
+}
+
+CS200::RenderQueue2D& Engine::GetRenderQueue2D()
+{
+    return Instance().impl->renderQueue2D;
 }
 
 CS230::TextureManager& Engine::GetTextureManager()
@@ -91,11 +104,19 @@ CS230::TextureManager& Engine::GetTextureManager()
     return Instance().impl->textureManager;
 }
 
+util::FileWatcher& Engine::GetFileWatcher()
+{
+    return Instance().impl->fileWatcher;
+}
+
 void Engine::Start(std::string_view window_title)
 {
     impl->logger.LogEvent("Engine Started");
 #if defined(DEVELOPER_VERSION)
     impl->logger.LogEvent("Developer Build");
+#    if !defined(__EMSCRIPTEN__)
+    impl->fileWatcher.SetEnabled(true);
+#    endif
 #endif
     impl->window.Start(window_title);
     auto& window = impl->window;
@@ -106,23 +127,29 @@ void Engine::Start(std::string_view window_title)
     impl->environment.DisplaySize = { static_cast<double>(window_size.x), static_cast<double>(window_size.y) };
     ImGuiHelper::Initialize(window.GetSDLWindow(), window.GetGLContext());
     window.SetEventCallback(ImGuiHelper::FeedEvent);
-    impl->renderer2D.Init();
+    impl->renderQueue2D.Init();
     impl->timer.ResetTimeStamp();
 }
 
 void Engine::Stop()
 {
-    impl->renderer2D.Shutdown();
+    impl->renderQueue2D.Shutdown();
     impl->gameStateManager.Clear();
+    OpenGL::ShutdownSharedGeometryArenas();
+    CS200::Renderer2DUtils::DestroyCameraBuffer();
     ImGuiHelper::Shutdown();
     impl->logger.LogEvent("Engine Stopped");
 }
 
 void Engine::Update()
 {
+    GL::ResetStateCacheStats();
     updateEnvironment();
     impl->window.Update();
     impl->input.Update();
+    impl->fileWatcher.Update();
+    OpenGL::UpdateShaderReloads();
+    impl->textureManager.Update();
     auto& state_manager = impl->gameStateManager;
     state_manager.Update();
     const auto        viewport      = impl->viewport;
@@ -132,6 +159,8 @@ void Engine::Update()
     impl->viewport = ImGuiHelper::Begin();
     state_manager.DrawImGui();
     ImGuiHelper::End();
+    // the ImGui backend talks to OpenGL directly
+    GL::InvalidateStateCache();
 }
 
 bool Engine::HasGameEnded()
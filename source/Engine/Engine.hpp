@@ -23,9 +23,15 @@ namespace CS230
     class TextureManager;
 }
 
+namespace util
+{
+    class FileWatcher;
+}
+
 namespace CS200
 {
     class IRenderer2D;
+    class RenderQueue2D;
 }
 
 /**
@@ -218,6 +224,15 @@ public:
      */
     static CS200::IRenderer2D& GetRenderer2D();
 
+    /**
+     * \brief Access the render queue behind GetRenderer2D()
+     * \return Reference to the RenderQueue2D that sorts 2D commands before they reach the batch renderer
+     *
+     * Draw calls made through GetRenderer2D() are recorded by this queue. Use it to pick the
+     * layer of the following draws and whether a layer may be reordered to batch by texture.
+     */
+    static CS200::RenderQueue2D& GetRenderQueue2D();
+
     /**
      * \brief Access the texture resource management system
      * \return Reference to TextureManager for texture loading and caching
@@ -236,6 +251,16 @@ public:
      */
     static CS230::TextureManager& GetTextureManager();
 
+    /**
+     * \brief Access the watcher behind asset hot reloading
+     * \return Reference to the FileWatcher that Update() polls every frame
+     *
+     * Enabled in developer builds outside the browser, disabled (ignoring every Watch()) otherwise.
+     * The TextureManager watches the images it loaded and uploads edited ones again, shaders
+     * registered with OpenGL::WatchShader() and OpenGL::ShaderVariants are rebuilt after an edit.
+     */
+    static util::FileWatcher& GetFileWatcher();
+
 
 public:
     /**
@@ -276,6 +301,7 @@ public:
      * Shutdown sequence:
      * - Cleans up 2D renderer and graphics resources
      * - Clears all game states and their resources
+     * - Deletes the buffers of the shared geometry arenas and the camera uniform buffer
      * - Shuts down ImGui and development tools
      * - Releases OpenGL context and window resources
      * - Performs final logging and cleanup
@@ -297,6 +323,8 @@ public:
      * Frame processing sequence:
      * - Updates timing information and frame statistics
      * - Processes window events and input state
+     * - Reloads assets edited on disk, see GetFileWatcher()
+     * - Uploads textures decoded by TextureManager::LoadAsync() within a time budget
      * - Updates the current game state logic
      * - Sets up rendering viewport and coordinate systems
      * - Renders the current game state with 2D graphics
@@ -0,0 +1,217 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "FileWatcher.hpp"
+
+#include <algorithm>
+#include <array>
+
+#if defined(__linux__) && !defined(__EMSCRIPTEN__)
+#    define HAS_INOTIFY
+#    include <sys/inotify.h>
+#    include <unistd.h>
+#endif
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    fs::file_time_type write_time(const fs::path& file_path) noexcept
+    {
+        std::error_code ignored;
+        return fs::last_write_time(file_path, ignored);
+    }
+}
+
+namespace util
+{
+    FileWatcher::~FileWatcher()
+    {
+        SetEnabled(false);
+    }
+
+    void FileWatcher::SetEnabled(bool enable)
+    {
+        if (enable == enabled)
+        {
+            return;
+        }
+        enabled = enable;
+        if (enabled)
+        {
+#if defined(HAS_INOTIFY)
+            // no inotify (the per user instance limit was reached for example) falls back to polling
+            notifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+#endif
+            lastPoll = clock_t::now();
+            return;
+        }
+#if defined(HAS_INOTIFY)
+        if (notifyDescriptor != -1)
+        {
+            close(notifyDescriptor); // drops every directory watch with it
+        }
+#endif
+        notifyDescriptor = -1;
+        directories.clear();
+        watched.clear();
+    }
+
+    FileWatcher::WatchId FileWatcher::Watch(const std::filesystem::path& file_path, Callback on_change)
+    {
+        if (!enabled)
+        {
+            return 0;
+        }
+        std::error_code error;
+        fs::path        canonical = fs::canonical(file_path, error);
+        if (error)
+        {
+            return 0;
+        }
+
+        Watched entry;
+#if defined(HAS_INOTIFY)
+        // directories rather than files, a save that replaces the file by renaming over it would end a file watch
+        fs::path directory = canonical.parent_path();
+        if (notifyDescriptor != -1 && std::none_of(directories.begin(), directories.end(), [&](const auto& watched_directory) { return watched_directory.second == directory; }))
+        {
+            const int descriptor = inotify_add_watch(notifyDescriptor, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO);
+            if (descriptor != -1)
+            {
+                directories.emplace_back(descriptor, std::move(directory));
+            }
+            else
+            {
+                // out of inotify watches (max_user_watches) or not allowed, this file is polled instead
+                entry.Polled = true;
+            }
+        }
+#endif
+
+        entry.Id        = nextId++;
+        entry.WriteTime = write_time(canonical);
+        entry.Path      = std::move(canonical);
+        entry.OnChange  = std::move(on_change);
+        watched.push_back(std::move(entry));
+        return watched.back().Id;
+    }
+
+    void FileWatcher::Unwatch(WatchId id) noexcept
+    {
+        // directory watches stay, there are only a handful of asset folders
+        std::erase_if(watched, [id](const Watched& entry) { return entry.Id == id; });
+    }
+
+    void FileWatcher::Update()
+    {
+        if (!enabled || watched.empty())
+        {
+            return;
+        }
+        const clock_t::time_point now = clock_t::now();
+        if (notifyDescriptor != -1)
+        {
+            readNotifications(now);
+        }
+        const bool needs_polling = notifyDescriptor == -1 || std::any_of(watched.begin(), watched.end(), [](const Watched& entry) { return entry.Polled; });
+        if (needs_polling && std::chrono::duration<double>(now - lastPoll).count() >= PollInterval)
+        {
+            lastPoll = now;
+            pollWriteTimes(now);
+        }
+
+        // the IDs are collected first, a callback may watch or unwatch files
+        std::vector<WatchId> settled;
+        for (const Watched& entry : watched)
+        {
+            if (entry.Changed && std::chrono::duration<double>(now - entry.ChangedAt).count() >= SettleTime)
+            {
+                settled.push_back(entry.Id);
+            }
+        }
+        for (const WatchId id : settled)
+        {
+            const auto found = std::find_if(watched.begin(), watched.end(), [id](const Watched& entry) { return entry.Id == id; });
+            if (found == watched.end())
+            {
+                continue;
+            }
+            found->Changed              = false;
+            const Callback callback     = found->OnChange;
+            const fs::path changed_file = found->Path;
+            ++changes;
+            callback(changed_file);
+        }
+    }
+
+    void FileWatcher::readNotifications([[maybe_unused]] clock_t::time_point now)
+    {
+#if defined(HAS_INOTIFY)
+        alignas(inotify_event) std::array<char, 4096> buffer;
+        for (;;)
+        {
+            const ssize_t length = read(notifyDescriptor, buffer.data(), buffer.size());
+            if (length <= 0)
+            {
+                return; // EAGAIN, nothing left to read
+            }
+            for (std::size_t offset = 0; offset < static_cast<std::size_t>(length);)
+            {
+                const auto* event = reinterpret_cast<const inotify_event*>(buffer.data() + offset);
+                offset += sizeof(inotify_event) + event->len;
+                if ((event->mask & IN_Q_OVERFLOW) != 0)
+                {
+                    // events were lost, treat everything as changed rather than miss a save
+                    for (Watched& entry : watched)
+                    {
+                        entry.Changed   = true;
+                        entry.ChangedAt = now;
+                    }
+                    continue;
+                }
+                const auto directory = std::find_if(directories.begin(), directories.end(), [&](const auto& entry) { return entry.first == event->wd; });
+                if (directory != directories.end() && event->len > 0)
+                {
+                    markChanged(directory->second / event->name, now);
+                }
+            }
+        }
+#endif
+    }
+
+    void FileWatcher::pollWriteTimes(clock_t::time_point now)
+    {
+        for (Watched& entry : watched)
+        {
+            if (notifyDescriptor != -1 && !entry.Polled)
+            {
+                continue; // inotify reports this one
+            }
+            // a file missing halfway through a save reads as min(), it is picked up once it is back
+            const fs::file_time_type current = write_time(entry.Path);
+            if (current != entry.WriteTime && current != fs::file_time_type::min())
+            {
+                entry.WriteTime = current;
+                entry.Changed   = true;
+                entry.ChangedAt = now;
+            }
+        }
+    }
+
+    void FileWatcher::markChanged(const std::filesystem::path& file_path, clock_t::time_point now)
+    {
+        for (Watched& entry : watched)
+        {
+            if (entry.Path == file_path)
+            {
+                entry.Changed   = true;
+                entry.ChangedAt = now;
+            }
+        }
+    }
+}
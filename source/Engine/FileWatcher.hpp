@@ -0,0 +1,128 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <utility>
+#include <vector>
+
+namespace util
+{
+    /**
+     * \brief Calls back when watched files change on disk, used to hot reload assets while developing
+     *
+     * On Linux the directories of the watched files are registered with inotify, Update() only drains
+     * the pending events and costs nothing while no file changes. Elsewhere Update() compares the
+     * modification time of every watched file once per PollInterval. A file whose directory inotify
+     * refuses to watch, at the max_user_watches limit for example, is polled that way as well.
+     *
+     * Editors often save in several steps (truncate, write, rename), so a change is reported once
+     * the file stayed quiet for SettleTime. Callbacks run on the thread calling Update(), the main
+     * thread, and may call Watch() and Unwatch().
+     *
+     * A disabled watcher ignores Watch() and returns 0, the engine only enables it in developer builds.
+     *
+     * Example Usage:
+     * \code
+     * const auto id = watcher.Watch("Assets/shaders/a.frag", [](const std::filesystem::path& file) { rebuild(file); });
+     * ...
+     * watcher.Update();                                          // every frame
+     * ...
+     * watcher.Unwatch(id);
+     * \endcode
+     */
+    class FileWatcher
+    {
+    public:
+        using WatchId  = std::uint32_t;
+        using Callback = std::function<void(const std::filesystem::path& changed_file)>;
+
+        /**
+         * \brief Seconds between two modification time checks when inotify is not available
+         */
+        static constexpr double PollInterval = 0.5;
+
+        /**
+         * \brief Seconds a file must stay unchanged before its callback runs
+         */
+        static constexpr double SettleTime = 0.1;
+
+        FileWatcher() = default;
+
+        FileWatcher(const FileWatcher& other)            = delete;
+        FileWatcher(FileWatcher&& other)                 = delete;
+        FileWatcher& operator=(const FileWatcher& other) = delete;
+        FileWatcher& operator=(FileWatcher&& other)      = delete;
+
+        ~FileWatcher();
+
+        /**
+         * \brief Start or stop watching, stopping forgets every watch
+         */
+        void SetEnabled(bool enable);
+
+        [[nodiscard]] bool IsEnabled() const noexcept
+        {
+            return enabled;
+        }
+
+        /**
+         * \brief Call on_change whenever file_path is modified
+         * \param file_path Existing file, watched by its canonical path so different spellings match
+         * \return ID for Unwatch(), 0 when the watcher is disabled or the file does not exist
+         */
+        WatchId Watch(const std::filesystem::path& file_path, Callback on_change);
+
+        /**
+         * \brief Stop calling back for a watch, 0 is ignored
+         */
+        void Unwatch(WatchId id) noexcept;
+
+        /**
+         * \brief Collect changes and run the callbacks of the files that settled
+         */
+        void Update();
+
+        /**
+         * \brief Number of callbacks run so far
+         */
+        [[nodiscard]] std::size_t GetChangeCount() const noexcept
+        {
+            return changes;
+        }
+
+    private:
+        using clock_t = std::chrono::steady_clock;
+
+        struct Watched
+        {
+            WatchId                         Id = 0;
+            std::filesystem::path           Path{};
+            std::filesystem::file_time_type WriteTime{};
+            Callback                        OnChange{};
+            bool                            Changed = false;
+            bool                            Polled  = false; // inotify refused its directory, checked every PollInterval
+            clock_t::time_point             ChangedAt{};     // last event, the callback waits for SettleTime after it
+        };
+
+        void readNotifications(clock_t::time_point now);
+        void pollWriteTimes(clock_t::time_point now);
+        void markChanged(const std::filesystem::path& file_path, clock_t::time_point now);
+
+        std::vector<Watched>                               watched{};
+        std::vector<std::pair<int, std::filesystem::path>> directories{};       // inotify watch descriptor of each directory
+        int                                                notifyDescriptor = -1; // -1 without inotify, files are polled then
+        clock_t::time_point                                lastPoll{};
+        WatchId                                            nextId  = 1;
+        std::size_t                                        changes = 0;
+        bool                                               enabled = false;
+    };
+}
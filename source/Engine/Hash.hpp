@@ -0,0 +1,33 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+
+namespace util
+{
+    /**
+     * \brief 64 bit FNV-1a of a byte string
+     * \param bytes Bytes to hash, e.g. a path or shader source
+     * \param seed Result of a previous call to chain several strings into one hash
+     *
+     * Unlike std::hash the value is the same on every run, compiler and machine, so it can name cache
+     * files and fill the tables of Assets.pak.
+     */
+    constexpr std::uint64_t hash_bytes(std::string_view bytes, std::uint64_t seed = 14695981039346656037ull) noexcept
+    {
+        std::uint64_t hash = seed;
+        for (const char c : bytes)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+}
@@ -0,0 +1,120 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "MappedFile.hpp"
+#include <utility>
+
+#if defined(_WIN32)
+#    ifndef WIN32_LEAN_AND_MEAN
+#        define WIN32_LEAN_AND_MEAN
+#    endif
+#    ifndef NOMINMAX
+#        define NOMINMAX
+#    endif
+#    include <windows.h>
+#else
+#    include <fcntl.h>
+#    include <sys/mman.h>
+#    include <sys/stat.h>
+#    include <unistd.h>
+#endif
+
+namespace util
+{
+    MappedFile::MappedFile(MappedFile&& other) noexcept : view(other.view), size(other.size)
+    {
+        other.view = nullptr;
+        other.size = 0;
+    }
+
+    MappedFile& MappedFile::operator=(MappedFile&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(view, other.view);
+            std::swap(size, other.size);
+        }
+        return *this;
+    }
+
+    MappedFile::~MappedFile()
+    {
+        Close();
+    }
+
+    bool MappedFile::Open(const std::filesystem::path& file_path)
+    {
+        Close();
+
+#if defined(_WIN32)
+        const HANDLE file = CreateFileW(file_path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+        LARGE_INTEGER file_size{};
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart == 0)
+        {
+            CloseHandle(file);
+            return false;
+        }
+        // PAGE_WRITECOPY + FILE_MAP_COPY is the copy-on-write equivalent of MAP_PRIVATE
+        const HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+        CloseHandle(file);
+        if (mapping == nullptr)
+        {
+            return false;
+        }
+        void* address = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, 0);
+        CloseHandle(mapping);
+        if (address == nullptr)
+        {
+            return false;
+        }
+        view = static_cast<std::byte*>(address);
+        size = static_cast<std::size_t>(file_size.QuadPart);
+#else
+        const int file = ::open(file_path.c_str(), O_RDONLY);
+        if (file < 0)
+        {
+            return false;
+        }
+        struct stat file_status{};
+        if (::fstat(file, &file_status) != 0 || file_status.st_size <= 0)
+        {
+            ::close(file);
+            return false;
+        }
+        const auto file_size = static_cast<std::size_t>(file_status.st_size);
+        void*      address   = ::mmap(nullptr, file_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, 0);
+        // the mapping keeps its own reference to the file
+        ::close(file);
+        if (address == MAP_FAILED)
+        {
+            return false;
+        }
+        view = static_cast<std::byte*>(address);
+        size = file_size;
+#endif
+        return true;
+    }
+
+    void MappedFile::Close() noexcept
+    {
+        if (view == nullptr)
+        {
+            return;
+        }
+#if defined(_WIN32)
+        UnmapViewOfFile(view);
+#else
+        ::munmap(view, size);
+#endif
+        view = nullptr;
+        size = 0;
+    }
+}
@@ -0,0 +1,68 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <cstddef>
+#include <filesystem>
+#include <span>
+
+namespace util
+{
+    /**
+     * \brief Read-only view of a whole file through the virtual memory system
+     *
+     * The file is mapped copy-on-write (MAP_PRIVATE / FILE_MAP_COPY): pages are only read from disk when
+     * they are touched, and writing through the view changes this process' copy, never the file.
+     * That lets a mapped file stand in for a heap buffer without copying it first.
+     *
+     * Example Usage:
+     * \code
+     * util::MappedFile file;
+     * if (file.Open(path))
+     *     parse(file.GetBytes());                                 // no read() into a buffer
+     * \endcode
+     */
+    class MappedFile
+    {
+    public:
+        MappedFile() noexcept = default;
+
+        MappedFile(const MappedFile& other)            = delete;
+        MappedFile& operator=(const MappedFile& other) = delete;
+
+        MappedFile(MappedFile&& other) noexcept;
+        MappedFile& operator=(MappedFile&& other) noexcept;
+
+        ~MappedFile();
+
+        /**
+         * \brief Map a file, replacing any file mapped before
+         * \return false when the file does not exist, is empty or cannot be mapped
+         */
+        bool Open(const std::filesystem::path& file_path);
+
+        /**
+         * \brief Unmap the file, safe to call multiple times
+         */
+        void Close() noexcept;
+
+        [[nodiscard]] std::span<std::byte> GetBytes() const noexcept
+        {
+            return { view, size };
+        }
+
+        [[nodiscard]] explicit operator bool() const noexcept
+        {
+            return view != nullptr;
+        }
+
+    private:
+        std::byte*  view = nullptr;
+        std::size_t size = 0;
+    };
+}
@@ -7,14 +7,20 @@
  */
 #include "Path.hpp"
 
+#include "AssetArchive.hpp"
+#include "MappedFile.hpp"
 #include <SDL.h>
+#include <cstring>
 #include <optional>
+#include <string>
+#include <unordered_set>
 
 namespace
 {
+    namespace fs = std::filesystem;
+
     std::optional<std::filesystem::path> try_get_asset_path(const std::filesystem::path& starting_directory)
     {
-        namespace fs                 = std::filesystem;
         fs::path       assets_parent = fs::absolute(starting_directory);
         const fs::path root          = assets_parent.root_path();
 
@@ -22,7 +28,7 @@ namespace
         do
         {
             const fs::path assets_folder = assets_parent / "Assets";
-            if (fs::is_directory(assets_folder))
+            if (fs::is_directory(assets_folder) || fs::is_regular_file(assets_parent / assets::archive::FileName))
             {
                 return assets_parent;
             }
@@ -32,6 +38,174 @@ namespace
 
         return std::nullopt;
     }
+
+    // "Assets/images/duck.png" for any spelling of a file under Assets/, std::nullopt for files elsewhere
+    std::optional<std::string> asset_key(const fs::path& asset_path)
+    {
+        const fs::path relative = (asset_path.is_absolute() ? asset_path.lexically_relative(assets::get_base_path()) : asset_path).lexically_normal();
+        std::string    key      = relative.generic_string();
+        if (!key.starts_with("Assets/"))
+        {
+            return std::nullopt;
+        }
+        return key;
+    }
+
+    // every file of the loose Assets folder, built once so lookups need no stat() and no exists()
+    class LooseIndex
+    {
+    public:
+        LooseIndex()
+        {
+            const fs::path  folder = assets::get_base_path() / "Assets";
+            std::error_code error;
+            present = fs::is_directory(folder, error);
+            if (!present)
+            {
+                return;
+            }
+            for (auto it = fs::recursive_directory_iterator(folder, error); !error && it != fs::recursive_directory_iterator(); it.increment(error))
+            {
+                if (it->is_regular_file(error))
+                {
+                    files.insert(it->path().lexically_relative(assets::get_base_path()).generic_string());
+                }
+            }
+        }
+
+        [[nodiscard]] bool IsPresent() const noexcept
+        {
+            return present;
+        }
+
+        [[nodiscard]] bool Contains(const std::string& key) const
+        {
+            return files.contains(key);
+        }
+
+    private:
+        std::unordered_set<std::string> files{};
+        bool                            present = false;
+    };
+
+    const LooseIndex& loose_index()
+    {
+        // built on first use, magic statics make that safe from the texture decoding workers too
+        static const LooseIndex index;
+        return index;
+    }
+
+    class Archive
+    {
+    public:
+        bool Open(const fs::path& archive_path)
+        {
+            namespace archive = assets::archive;
+            if (!file.Open(archive_path))
+            {
+                return false;
+            }
+            const auto bytes = file.GetBytes();
+            if (bytes.size() < sizeof(archive::Header))
+            {
+                return invalid();
+            }
+            std::memcpy(&header, bytes.data(), sizeof(header));
+            const std::uint64_t slots_end   = header.SlotsOffset + std::uint64_t{ header.SlotCount } * sizeof(std::uint32_t);
+            const std::uint64_t entries_end = header.EntriesOffset + std::uint64_t{ header.EntryCount } * sizeof(archive::Entry);
+            if (header.Magic != archive::Magic || header.Version != archive::Version || header.FileSize != bytes.size() || header.SlotCount == 0 ||
+                (header.SlotCount & (header.SlotCount - 1)) != 0 || header.SlotCount / 2 < header.EntryCount || slots_end > bytes.size() || entries_end > bytes.size() ||
+                header.NamesOffset > bytes.size() || header.SlotsOffset % alignof(std::uint32_t) != 0 || header.EntriesOffset % alignof(archive::Entry) != 0)
+            {
+                return invalid();
+            }
+            // the offsets are aligned and the mapping is page aligned, the tables can be read in place
+            slots   = { reinterpret_cast<const std::uint32_t*>(bytes.data() + header.SlotsOffset), header.SlotCount };
+            entries = { reinterpret_cast<const archive::Entry*>(bytes.data() + header.EntriesOffset), header.EntryCount };
+            for (const archive::Entry& entry : entries)
+            {
+                if (entry.Offset + entry.Size > bytes.size() || header.NamesOffset + entry.NameOffset + entry.NameLength > bytes.size())
+                {
+                    return invalid();
+                }
+            }
+            return true;
+        }
+
+        [[nodiscard]] bool IsOpen() const noexcept
+        {
+            return !entries.empty();
+        }
+
+        [[nodiscard]] std::optional<std::span<const std::byte>> Find(std::string_view key) const noexcept
+        {
+            if (!IsOpen())
+            {
+                return std::nullopt;
+            }
+            const std::uint64_t hash  = assets::archive::hash_path(key);
+            const auto          bytes = file.GetBytes();
+            const std::size_t   mask  = slots.size() - 1;
+            std::size_t         slot  = static_cast<std::size_t>(hash) & mask;
+            // bounded, a damaged table without an empty slot must not hang the lookup of a missing asset
+            for (std::size_t probe = 0; probe < slots.size(); ++probe, slot = (slot + 1) & mask)
+            {
+                const std::uint32_t index = slots[slot];
+                if (index == 0 || index > entries.size())
+                {
+                    return std::nullopt;
+                }
+                const assets::archive::Entry& entry = entries[index - 1];
+                const std::string_view        name{ reinterpret_cast<const char*>(bytes.data() + header.NamesOffset + entry.NameOffset), entry.NameLength };
+                if (entry.PathHash == hash && name == key)
+                {
+                    return std::span<const std::byte>{ bytes.data() + entry.Offset, static_cast<std::size_t>(entry.Size) };
+                }
+            }
+            return std::nullopt;
+        }
+
+    private:
+        bool invalid()
+        {
+            file.Close();
+            entries = {};
+            slots   = {};
+            return false;
+        }
+
+        util::MappedFile                        file{};
+        assets::archive::Header                 header{};
+        std::span<const std::uint32_t>          slots{};
+        std::span<const assets::archive::Entry> entries{};
+    };
+
+    const Archive& packed_assets()
+    {
+        static const Archive mounted = []
+        {
+            Archive result;
+#if defined(DEVELOPER_VERSION)
+            // loose files win while developing, edits and hot reloading work without repacking
+            if (loose_index().IsPresent())
+            {
+                return result;
+            }
+#endif
+            if (result.Open(assets::get_base_path() / assets::archive::FileName))
+            {
+                return result;
+            }
+            if (char* const exe_folder = SDL_GetBasePath(); exe_folder != nullptr)
+            {
+                const fs::path beside_exe = fs::path{ exe_folder } / assets::archive::FileName;
+                SDL_free(exe_folder);
+                static_cast<void>(result.Open(beside_exe));
+            }
+            return result;
+        }();
+        return mounted;
+    }
 }
 
 namespace assets
@@ -39,7 +213,6 @@ namespace assets
 
     std::filesystem::path get_base_path()
     {
-        namespace fs                  = std::filesystem;
         static fs::path assets_folder = []()
         {
             auto result = try_get_asset_path(fs::current_path());
@@ -58,6 +231,15 @@ namespace assets
 
     std::filesystem::path locate_asset(const std::filesystem::path& asset_path)
     {
+        if (const auto key = asset_key(asset_path); key && loose_index().IsPresent())
+        {
+            if (!loose_index().Contains(*key))
+            {
+                throw std::runtime_error("Failed to locate asset: " + asset_path.string());
+            }
+            return get_base_path() / *key;
+        }
+
         auto asset_filepath = asset_path;
         if (!std::filesystem::exists(asset_filepath))
         {
@@ -70,4 +252,53 @@ namespace assets
         }
         return asset_filepath;
     }
+
+    bool asset_exists(const std::filesystem::path& asset_path)
+    {
+        if (const auto key = asset_key(asset_path); key)
+        {
+            if (packed_assets().Find(*key))
+            {
+                return true;
+            }
+            if (loose_index().IsPresent())
+            {
+                return loose_index().Contains(*key);
+            }
+        }
+        std::error_code ignored;
+        return fs::exists(asset_path, ignored) || fs::exists(get_base_path() / asset_path, ignored);
+    }
+
+    std::optional<std::span<const std::byte>> find_packed(const std::filesystem::path& asset_path)
+    {
+        if (!packed_assets().IsOpen())
+        {
+            return std::nullopt;
+        }
+        const auto key = asset_key(asset_path);
+        return key ? packed_assets().Find(*key) : std::nullopt;
+    }
+
+    std::filesystem::path get_cache_path()
+    {
+        static fs::path cache_folder = []()
+        {
+            fs::path   result;
+            const auto pref_path = SDL_GetPrefPath("DigiPen", "CS200");
+            if (pref_path != nullptr)
+            {
+                result = fs::path{ pref_path } / "cache";
+                SDL_free(pref_path);
+            }
+            else
+            {
+                result = fs::temp_directory_path() / "CS200" / "cache";
+            }
+            std::error_code ignored;
+            fs::create_directories(result, ignored);
+            return result;
+        }();
+        return cache_folder;
+    }
 }
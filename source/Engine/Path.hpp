@@ -8,11 +8,29 @@
  */
 #pragma once
 
+#include <cstddef>
 #include <filesystem>
+#include <optional>
+#include <span>
 
 namespace assets
 {
-
+    // Folder holding Assets/ or Assets.pak, found once by walking up from the working directory, then the executable's
     std::filesystem::path get_base_path();
+
+    // Assets/... paths are answered from an index of the Assets folder built on first use, no filesystem query per
+    // lookup, so files added while the program runs are only found after a restart. Other paths are checked on disk.
+    // Throws std::runtime_error when the file does not exist or only exists inside Assets.pak.
     std::filesystem::path locate_asset(const std::filesystem::path& asset_path);
+
+    // true when find_packed() or locate_asset() would find the asset, from the index as well
+    [[nodiscard]] bool asset_exists(const std::filesystem::path& asset_path);
+
+    // Contents of an asset stored in Assets.pak (see asset_packer), std::nullopt when it is not packed. The archive is
+    // mapped once and never unmapped, views stay valid for the whole run. It is looked for next to Assets/ and next to
+    // the executable; developer builds ignore it while a loose Assets folder exists, so edits show up without repacking.
+    [[nodiscard]] std::optional<std::span<const std::byte>> find_packed(const std::filesystem::path& asset_path);
+
+    // writable per-user folder for files derived from the assets, like decoded images
+    std::filesystem::path get_cache_path();
 }
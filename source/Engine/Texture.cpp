@@ -26,12 +26,12 @@ namespace CS230
         return mat[0][0] == 1.0 && mat[0][1] == 0.0 && mat[0][2] == 0.0 && mat[1][0] == 0.0 && mat[1][1] == 1.0 && mat[1][2] == 0.0 && mat[2][0] == 0.0 && mat[2][1] == 0.0 && mat[2][2] == 1.0;
     }
 
-    void CS230::Texture::Draw(const Math::TransformationMatrix& display_matrix, unsigned int color)
+    void CS230::Texture::Draw(const Math::TransformationMatrix& display_matrix, unsigned int color, double depth)
     {
-        Draw(display_matrix, { 0, 0 }, GetSize(), color);
+        Draw(display_matrix, { 0, 0 }, GetSize(), color, depth);
     }
 
-    void CS230::Texture::Draw(const Math::TransformationMatrix& display_matrix, Math::ivec2 texel_position, Math::ivec2 frame_size, unsigned int color)
+    void CS230::Texture::Draw(const Math::TransformationMatrix& display_matrix, Math::ivec2 texel_position, Math::ivec2 frame_size, unsigned int color, double depth)
     {
         if (textureHandle == 0)
         {
@@ -40,8 +40,11 @@ namespace CS230
 
         Math::TransformationMatrix transform_matrix = display_matrix;
 
-        const Math::vec2 st_min{ static_cast<float>(texel_position.x) / static_cast<float>(size.x), 1.0f - static_cast<float>(texel_position.y + frame_size.y) / static_cast<float>(size.y) };
-        const Math::vec2 st_max{ static_cast<float>(texel_position.x + frame_size.x) / static_cast<float>(size.x), 1.0f - static_cast<float>(texel_position.y) / static_cast<float>(size.y) };
+        // texel_position is top-left based in the image, the texture is stored bottom row first at pageOffset
+        const float      left   = static_cast<float>(pageOffset.x + texel_position.x);
+        const float      top    = static_cast<float>(pageOffset.y + size.y - texel_position.y);
+        const Math::vec2 st_min{ left / static_cast<float>(pageSize.x), (top - static_cast<float>(frame_size.y)) / static_cast<float>(pageSize.y) };
+        const Math::vec2 st_max{ (left + static_cast<float>(frame_size.x)) / static_cast<float>(pageSize.x), top / static_cast<float>(pageSize.y) };
 
         const Math::ScaleMatrix scale_matrix{
             { static_cast<double>(frame_size.x), static_cast<double>(frame_size.y) }
@@ -56,13 +59,13 @@ namespace CS230
                 transform_matrix = Math::TranslationMatrix(Math::vec2{ static_cast<double>(frame_size.x) / 2.0, static_cast<double>(frame_size.y) / 2.0 });
             }
             const Math::TransformationMatrix final_transform = transform_matrix * scale_matrix;
-            Engine::GetRenderer2D().DrawQuad(final_transform, textureHandle, st_min, st_max, tintColor);
+            Engine::GetRenderer2D().DrawQuad(final_transform, textureHandle, st_min, st_max, tintColor, depth);
         }
         else // cat, robot
         {
             const Math::TranslationMatrix    toCenter(Math::vec2{ 0.5, 0.5 });
             const Math::TransformationMatrix final_transform = display_matrix * scale_matrix * toCenter;
-            Engine::GetRenderer2D().DrawQuad(final_transform, textureHandle, st_min, st_max, tintColor);
+            Engine::GetRenderer2D().DrawQuad(final_transform, textureHandle, st_min, st_max, tintColor, depth);
         }
     }
 
@@ -73,13 +76,14 @@ namespace CS230
 
     CS230::Texture::~Texture()
     {
-        if (textureHandle != 0)
+        if (textureHandle != 0 && ownsHandle)
         {
             GL::DeleteTextures(1, &textureHandle);
         }
     }
 
-    CS230::Texture::Texture(Texture&& temporary) noexcept : textureHandle(temporary.textureHandle), size(temporary.size)
+    CS230::Texture::Texture(Texture&& temporary) noexcept
+        : textureHandle(temporary.textureHandle), size(temporary.size), pageSize(temporary.pageSize), pageOffset(temporary.pageOffset), ownsHandle(temporary.ownsHandle)
     {
         temporary.textureHandle = 0;
         temporary.size          = { 0, 0 };
@@ -89,13 +93,16 @@ namespace CS230
     {
         if (this != &temporary)
         {
-            if (textureHandle != 0)
+            if (textureHandle != 0 && ownsHandle)
             {
                 GL::DeleteTextures(1, &textureHandle);
             }
 
             textureHandle = temporary.textureHandle;
             size          = temporary.size;
+            pageSize      = temporary.pageSize;
+            pageOffset    = temporary.pageOffset;
+            ownsHandle    = temporary.ownsHandle;
 
             temporary.textureHandle = 0;
             temporary.size          = { 0, 0 };
@@ -111,6 +118,7 @@ namespace CS230
         {
             textureHandle = OpenGL::CreateTextureFromImage(image);
             size          = image.GetSize();
+            pageSize      = size;
         }
         else
         {
@@ -118,7 +126,12 @@ namespace CS230
         }
     }
 
-    Texture::Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size) : textureHandle(given_texture), size(the_size)
+    Texture::Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size) : textureHandle(given_texture), size(the_size), pageSize(the_size)
+    {
+    }
+
+    Texture::Texture(OpenGL::TextureHandle atlas_page, Math::ivec2 page_size, Math::ivec2 page_offset, Math::ivec2 the_size)
+        : textureHandle(atlas_page), size(the_size), pageSize(page_size), pageOffset(page_offset), ownsHandle(false)
     {
     }
 
@@ -65,6 +65,7 @@ namespace CS230
          * \brief Draw the entire texture with transformation and color tinting
          * \param display_matrix Transformation matrix for positioning, scaling, and rotation
          * \param color RGBA color value for tinting the texture (default: white/no tint)
+         * \param depth Draw depth in [0,1], 0 is the front, used by the render queue's depth passes
          *
          * Renders the complete texture to the screen using the provided transformation
          * matrix to control positioning, scaling, and rotation. This is the primary
@@ -89,7 +90,7 @@ namespace CS230
          * rendering, automatically managing texture binding and shader state for
          * optimal performance when drawing multiple textures.
          */
-        void Draw(const Math::TransformationMatrix& display_matrix, unsigned int color = 0xFFFFFFFF);
+        void Draw(const Math::TransformationMatrix& display_matrix, unsigned int color = 0xFFFFFFFF, double depth = 0.0);
 
         /**
          * \brief Draw a rectangular region of the texture (sprite sheet support)
@@ -97,6 +98,7 @@ namespace CS230
          * \param texel_position Top-left corner position in pixel coordinates within the texture
          * \param frame_size Size of the region to draw in pixels
          * \param color RGBA color value for tinting the texture (default: white/no tint)
+         * \param depth Draw depth in [0,1], 0 is the front, used by the render queue's depth passes
          *
          * Renders a specific rectangular region of the texture, enabling sprite sheet
          * functionality, texture atlases, and animation frame rendering. This method
@@ -123,8 +125,13 @@ namespace CS230
          *
          * The transformation matrix affects the final rendered size and position,
          * while frame_size determines which portion of the texture is sampled.
+         *
+         * Atlas Textures:
+         * A texture loaded while TextureManager's atlas mode is on is a sub-rectangle of a
+         * shared page. texel_position and frame_size stay relative to the original image,
+         * the texture coordinates are remapped into the page here.
          */
-        void Draw(const Math::TransformationMatrix& display_matrix, Math::ivec2 texel_position, Math::ivec2 frame_size, unsigned int color = 0xFFFFFFFF);
+        void Draw(const Math::TransformationMatrix& display_matrix, Math::ivec2 texel_position, Math::ivec2 frame_size, unsigned int color = 0xFFFFFFFF, double depth = 0.0);
 
         /**
          * \brief Get the dimensions of the texture in pixels
@@ -175,7 +182,8 @@ namespace CS230
          * Handle Ownership:
          * The returned handle remains owned by the Texture object and should not
          * be manually deleted or modified. The handle becomes invalid when the
-         * Texture object is destroyed.
+         * Texture object is destroyed. For an atlas texture it is the shared page,
+         * owned by the TextureManager and shared with other textures.
          */
         [[nodiscard]] OpenGL::TextureHandle GetHandle() const
         {
@@ -187,6 +195,8 @@ namespace CS230
         // This ensures proper resource management and prevents accidental texture duplication
         explicit Texture(const std::filesystem::path& file_name);
         Texture(OpenGL::TextureHandle given_texture, Math::ivec2 the_size);
+        // Sub-rectangle of a texture owned by the TextureManager (atlas page, loading placeholder)
+        Texture(OpenGL::TextureHandle atlas_page, Math::ivec2 page_size, Math::ivec2 page_offset, Math::ivec2 the_size);
 
     public:
         /**
@@ -235,5 +245,8 @@ namespace CS230
     private:
         OpenGL::TextureHandle textureHandle;
         Math::ivec2           size{};
+        Math::ivec2           pageSize{};   // size of the GL texture, larger than size inside an atlas
+        Math::ivec2           pageOffset{}; // bottom-left texel of this image inside the GL texture
+        bool                  ownsHandle = true;
     };
 }
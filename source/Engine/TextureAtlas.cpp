@@ -0,0 +1,181 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#include "TextureAtlas.hpp"
+#include "CS200/Image.hpp"
+#include "OpenGL/Environment.hpp"
+#include "OpenGL/GL.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace CS230
+{
+    TextureAtlas::TextureAtlas(int page_size) noexcept : pageSize(page_size)
+    {
+    }
+
+    TextureAtlas::~TextureAtlas()
+    {
+        Clear();
+    }
+
+    std::optional<TextureAtlas::Region> TextureAtlas::Insert(const CS200::Image& image, OpenGL::TextureUploader* uploader)
+    {
+        if (pages.empty())
+        {
+            pageSize = std::min(pageSize, OpenGL::MaxTextureSize);
+        }
+
+        const Math::ivec2 image_size = image.GetSize();
+        const Math::ivec2 padded{ image_size.x + 2 * Padding, image_size.y + 2 * Padding };
+        if (image.data() == nullptr || padded.x > pageSize || padded.y > pageSize)
+        {
+            return std::nullopt;
+        }
+
+        Page*                      page     = nullptr;
+        std::optional<Math::ivec2> position = std::nullopt;
+        for (Page& candidate : pages)
+        {
+            position = findPosition(candidate, padded);
+            if (position)
+            {
+                page = &candidate;
+                break;
+            }
+        }
+        if (page == nullptr)
+        {
+            page     = &addPage();
+            position = findPosition(*page, padded);
+        }
+        place(*page, *position, padded);
+        write(page->Handle, *position, image, uploader);
+
+        return Region{ page->Handle, Math::ivec2{ pageSize, pageSize }, Math::ivec2{ position->x + Padding, position->y + Padding }, image_size };
+    }
+
+    bool TextureAtlas::Replace(const Region& region, const CS200::Image& image, OpenGL::TextureUploader* uploader)
+    {
+        if (image.data() == nullptr || image.GetSize() != region.Size)
+        {
+            return false;
+        }
+        write(region.Page, Math::ivec2{ region.Offset.x - Padding, region.Offset.y - Padding }, image, uploader);
+        return true;
+    }
+
+    void TextureAtlas::Clear()
+    {
+        for (Page& page : pages)
+        {
+            GL::DeleteTextures(1, &page.Handle);
+        }
+        pages.clear();
+    }
+
+    std::optional<Math::ivec2> TextureAtlas::findPosition(const Page& page, Math::ivec2 size) const
+    {
+        std::optional<Math::ivec2> best       = std::nullopt;
+        int                        best_width = std::numeric_limits<int>::max();
+
+        for (std::size_t i = 0; i < page.Skyline.size(); ++i)
+        {
+            const int x = page.Skyline[i].X;
+            if (x + size.x > pageSize)
+            {
+                break;
+            }
+
+            // the image rests on the highest segment it spans
+            int y         = 0;
+            int remaining = size.x;
+            for (std::size_t j = i; remaining > 0; ++j)
+            {
+                y = std::max(y, page.Skyline[j].Y);
+                remaining -= page.Skyline[j].Width;
+            }
+            if (y + size.y > pageSize)
+            {
+                continue;
+            }
+
+            if (!best || y < best->y || (y == best->y && page.Skyline[i].Width < best_width))
+            {
+                best       = Math::ivec2{ x, y };
+                best_width = page.Skyline[i].Width;
+            }
+        }
+        return best;
+    }
+
+    void TextureAtlas::place(Page& page, Math::ivec2 position, Math::ivec2 size) const
+    {
+        auto& skyline = page.Skyline;
+        auto  node    = std::find_if(skyline.begin(), skyline.end(), [&](const SkylineNode& n) { return n.X == position.x; });
+        node          = skyline.insert(node, SkylineNode{ position.x, position.y + size.y, size.x });
+
+        // trim the segments now covered by the new one
+        const int right = position.x + size.x;
+        for (auto next = node + 1; next != skyline.end() && next->X < right;)
+        {
+            const int covered = right - next->X;
+            if (next->Width <= covered)
+            {
+                next = skyline.erase(next);
+                continue;
+            }
+            next->X += covered;
+            next->Width -= covered;
+            break;
+        }
+
+        // neighbours at the same height become one segment
+        for (std::size_t i = 0; i + 1 < skyline.size();)
+        {
+            if (skyline[i].Y == skyline[i + 1].Y)
+            {
+                skyline[i].Width += skyline[i + 1].Width;
+                skyline.erase(skyline.begin() + static_cast<std::ptrdiff_t>(i + 1));
+                continue;
+            }
+            ++i;
+        }
+    }
+
+    void TextureAtlas::write(OpenGL::TextureHandle page, Math::ivec2 position, const CS200::Image& image, OpenGL::TextureUploader* uploader)
+    {
+        // copy the image with its edge rows and columns repeated Padding times on every side
+        const Math::ivec2        image_size = image.GetSize();
+        const Math::ivec2        padded{ image_size.x + 2 * Padding, image_size.y + 2 * Padding };
+        std::vector<CS200::RGBA> texels(static_cast<std::size_t>(padded.x) * static_cast<std::size_t>(padded.y));
+        const CS200::RGBA*       source = image.data();
+        auto                     texel  = texels.begin();
+        for (int y = 0; y < padded.y; ++y)
+        {
+            const CS200::RGBA* source_row = source + std::clamp(y - Padding, 0, image_size.y - 1) * image_size.x;
+            for (int x = 0; x < padded.x; ++x)
+            {
+                *texel++ = source_row[std::clamp(x - Padding, 0, image_size.x - 1)];
+            }
+        }
+        OpenGL::UpdateTextureRegion(page, position, padded, texels, uploader);
+    }
+
+    TextureAtlas::Page& TextureAtlas::addPage()
+    {
+        // start fully transparent, so unused space does not keep the page from counting as opaque cutout
+        const std::vector<CS200::RGBA> clear(static_cast<std::size_t>(pageSize) * static_cast<std::size_t>(pageSize), 0u);
+
+        Page page;
+        page.Handle = OpenGL::CreateTextureFromMemory(Math::ivec2{ pageSize, pageSize }, clear, OpenGL::Filtering::NearestPixel, OpenGL::Wrapping::ClampToEdge);
+        page.Skyline.push_back(SkylineNode{ 0, 0, pageSize });
+        pages.push_back(std::move(page));
+        return pages.back();
+    }
+}
@@ -0,0 +1,134 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+
+#pragma once
+#include "OpenGL/Texture.hpp"
+#include "Vec2.hpp"
+#include <optional>
+#include <vector>
+
+namespace CS200
+{
+    class Image;
+}
+
+namespace CS230
+{
+    /**
+     * \brief Packs many images into a few large texture pages
+     *
+     * Every texture switch between two sprites ends a batch. TextureAtlas copies images into shared
+     * square pages so sprites loaded from different files end up on the same OpenGL texture.
+     *
+     * Packing uses the skyline bottom-left heuristic: each page remembers the top edge of everything
+     * placed so far as a list of horizontal segments, a new image goes where its bottom edge is lowest,
+     * leftmost on ties. Pages are never repacked, images stay where they were put until Clear().
+     * Regions cannot be freed one by one, Replace() reuses one for an image of the same size.
+     *
+     * Every image is surrounded by Padding texels that repeat its edge texels (extrusion), so linear
+     * filtering at the border of a sprite samples its own edge color instead of a neighbour.
+     *
+     * Pages are always sampled with OpenGL::Filtering::NearestPixel. Images that need another filtering
+     * mode and images larger than a page are kept out by the caller as standalone textures.
+     */
+    class TextureAtlas
+    {
+    public:
+        /**
+         * \brief Page size used when the OpenGL implementation allows it
+         */
+        static constexpr int DefaultPageSize = 2048;
+
+        /**
+         * \brief Extruded texels on every side of an image
+         */
+        static constexpr int Padding = 2;
+
+        /**
+         * \brief Where an image was placed
+         */
+        struct Region
+        {
+            OpenGL::TextureHandle Page = 0;
+            Math::ivec2           PageSize{};
+            Math::ivec2           Offset{}; ///< texel of the image's bottom-left corner inside the page
+            Math::ivec2           Size{};   ///< dimensions of the image, without the padding
+        };
+
+        /**
+         * \param page_size Requested page width and height, clamped to OpenGL::MaxTextureSize when the first page is created
+         */
+        explicit TextureAtlas(int page_size = DefaultPageSize) noexcept;
+
+        TextureAtlas(const TextureAtlas& other)            = delete;
+        TextureAtlas(TextureAtlas&& other)                 = delete;
+        TextureAtlas& operator=(const TextureAtlas& other) = delete;
+        TextureAtlas& operator=(TextureAtlas&& other)      = delete;
+
+        ~TextureAtlas();
+
+        /**
+         * \brief Copy an image into the first page with room for it, creating a page when none has
+         * \param image RGBA image loaded bottom row first, like TextureManager does
+         * \param uploader Optional pixel buffer ring the texels are staged through
+         * \return Location of the image, or std::nullopt when it is larger than a page
+         */
+        [[nodiscard]] std::optional<Region> Insert(const CS200::Image& image, OpenGL::TextureUploader* uploader = nullptr);
+
+        /**
+         * \brief Overwrite the texels of a region returned by Insert(), padding included
+         * \param region Where the old image was placed
+         * \param image Replacement of exactly region.Size
+         * \param uploader Optional pixel buffer ring the texels are staged through
+         * \return false when the sizes differ, the region is left untouched then
+         *
+         * Used when an atlas image is hot reloaded, so saving it again does not take a new region every time.
+         */
+        bool Replace(const Region& region, const CS200::Image& image, OpenGL::TextureUploader* uploader = nullptr);
+
+        /**
+         * \brief Delete every page, all previously returned regions become invalid
+         */
+        void Clear();
+
+        [[nodiscard]] std::size_t GetPageCount() const noexcept
+        {
+            return pages.size();
+        }
+
+        /**
+         * \brief GPU memory of all pages in bytes, every page is a full RGBA8 texture
+         */
+        [[nodiscard]] std::size_t GetByteSize() const noexcept
+        {
+            return pages.size() * static_cast<std::size_t>(pageSize) * static_cast<std::size_t>(pageSize) * sizeof(CS200::RGBA);
+        }
+
+    private:
+        struct SkylineNode
+        {
+            int X     = 0;
+            int Y     = 0; ///< top edge of what is already placed below this segment
+            int Width = 0;
+        };
+
+        struct Page
+        {
+            OpenGL::TextureHandle    Handle = 0;
+            std::vector<SkylineNode> Skyline{};
+        };
+
+        std::optional<Math::ivec2> findPosition(const Page& page, Math::ivec2 size) const;
+        void                       place(Page& page, Math::ivec2 position, Math::ivec2 size) const;
+        Page&                      addPage();
+        static void                write(OpenGL::TextureHandle page, Math::ivec2 position, const CS200::Image& image, OpenGL::TextureUploader* uploader);
+
+        int               pageSize = DefaultPageSize;
+        std::vector<Page> pages{};
+    };
+}
@@ -11,47 +11,565 @@
 #include "TextureManager.hpp"
 #include "CS200/IRenderer2D.hpp"
 #include "CS200/Image.hpp"
+#include "CS200/KTX.hpp"
+#include "CS200/Mipmap.hpp"
 #include "CS200/NDC.hpp"
 #include "Engine.hpp"
 #include "Logger.hpp"
 #include "OpenGL/GL.hpp"
+#include "Path.hpp"
+#include "Timer.hpp"
+#include <algorithm>
+#include <cstring>
 #include <iostream>
 
+namespace
+{
+    constexpr std::string_view CompressedSuffixes[] = { CS200::ktx::BPTCSuffix, CS200::ktx::S3TCSuffix, CS200::ktx::ETC2Suffix };
+
+    // prefers a block compressed variant the driver can use, runs on worker threads
+    std::variant<CS200::Image, CS200::CompressedImage> decode(const std::filesystem::path& file_name, bool mipmapped)
+    {
+        for (const std::string_view suffix : CompressedSuffixes)
+        {
+            std::filesystem::path variant = file_name;
+            variant.replace_extension(suffix);
+            if (!assets::asset_exists(variant))
+            {
+                continue;
+            }
+            CS200::CompressedImage compressed(variant);
+            if (OpenGL::IsCompressedFormatSupported(compressed.GetFormat(), compressed.GetSize()))
+            {
+                return compressed;
+            }
+        }
+        // the mip chain is filtered here rather than on the main thread during the upload, and cached with the texels
+        return CS200::Image(file_name, true, mipmapped);
+    }
+
+    bool has_compressed_variant(const std::filesystem::path& file_name)
+    {
+        return std::any_of(
+            std::begin(CompressedSuffixes), std::end(CompressedSuffixes),
+            [&](std::string_view suffix)
+            {
+                std::filesystem::path variant = file_name;
+                variant.replace_extension(suffix);
+                return assets::asset_exists(variant);
+            });
+    }
+
+    std::size_t texel_count(Math::ivec2 size, bool mipmapped) noexcept
+    {
+        const std::size_t level0 = static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y);
+        return mipmapped ? level0 + CS200::mip_chain_texel_count(size) : level0;
+    }
+
+    std::filesystem::path asset_path(assets::AssetId id)
+    {
+        return std::filesystem::path{ assets::get_path(id) };
+    }
+}
+
 namespace CS230
 {
 
-    Texture* TextureManager::Load(const std::filesystem::path& file_name)
+    TextureManager::~TextureManager()
+    {
+        Unload();
+    }
+
+    TextureRef TextureManager::Load(const std::filesystem::path& file_name)
     {
-        const std::string key = file_name.string();
+        return Load(assets::intern(file_name));
+    }
 
-        auto it = texture_cache.find(key);
-        if (it != texture_cache.end())
+    TextureRef TextureManager::Load(assets::AssetId id)
+    {
+        if (std::unique_ptr<CacheEntry>* cached = texture_cache.Find(id); cached != nullptr)
+        {
+            CacheEntry& entry = **cached;
+            // still decoding in the background, the caller expects the real image now
+            if (auto in_flight = std::find_if(pending.begin(), pending.end(), [&](const PendingTexture& pending_texture) { return pending_texture.Target == &entry; }); in_flight != pending.end())
+            {
+                finish(*in_flight);
+                pending.erase(in_flight);
+            }
+            TextureRef reference(this, &entry);
+            if (entry.Evicted)
+            {
+                try
+                {
+                    upload(entry, decodeImage(asset_path(id), OpenGL::UsesMipmaps(entry.Filtering), {}));
+                }
+                catch (const std::exception& e)
+                {
+                    Engine::GetLogger().LogError("Failed to reload texture: " + std::string(e.what()));
+                }
+            }
+            return reference;
+        }
+        if (id == assets::AssetId::Invalid)
         {
-            return it->second.get();
+            return TextureRef{};
         }
 
         try
         {
-            CS200::Image image(file_name, true);
-            const OpenGL::TextureHandle handle = OpenGL::CreateTextureFromImage(image, OpenGL::Filtering::NearestPixel, OpenGL::Wrapping::ClampToEdge);
+            const auto decoded = decodeImage(asset_path(id), OpenGL::UsesMipmaps(filtering), {});
 
-            Texture*                 raw_ptr = new Texture(handle, image.GetSize());
-            std::unique_ptr<Texture> new_texture(raw_ptr);
-            Texture*                 texture_ptr = new_texture.get();
-            texture_cache[key]                   = std::move(new_texture);
-
-            return texture_ptr;
+            CacheEntry& entry = newEntry(id);
+            TextureRef  reference(this, &entry);
+            upload(entry, decoded);
+            return reference;
         }
-        catch (const std::runtime_error& e)
+        catch (const std::exception& e)
         {
+            if (const std::unique_ptr<CacheEntry>* failed = texture_cache.Find(id); failed != nullptr)
+            {
+                Engine::GetFileWatcher().Unwatch((*failed)->Watch);
+            }
+            texture_cache.Erase(id);
             Engine::GetLogger().LogError("Failed to load texture: " + std::string(e.what()));
-            return nullptr;
+            return TextureRef{};
+        }
+    }
+
+    TextureRef TextureManager::LoadAsync(const std::filesystem::path& file_name)
+    {
+        return LoadAsync(assets::intern(file_name));
+    }
+
+    TextureRef TextureManager::LoadAsync(assets::AssetId id)
+    {
+        CacheEntry* entry = nullptr;
+        if (std::unique_ptr<CacheEntry>* cached = texture_cache.Find(id); cached != nullptr)
+        {
+            entry = cached->get();
+            if (!entry->Evicted)
+            {
+                return TextureRef(this, entry);
+            }
+        }
+        if (id == assets::AssetId::Invalid)
+        {
+            return TextureRef{};
+        }
+
+        if (placeholder == 0)
+        {
+            const CS200::RGBA transparent = 0x00000000;
+            placeholder                   = OpenGL::CreateTextureFromMemory({ 1, 1 }, std::span{ &transparent, 1 }, OpenGL::Filtering::NearestPixel, OpenGL::Wrapping::ClampToEdge);
+        }
+        if (entry == nullptr)
+        {
+            entry         = &newEntry(id);
+            entry->Loaded = std::unique_ptr<Texture>(new Texture(placeholder, { 1, 1 }, { 0, 0 }, { 1, 1 }));
+        }
+        else
+        {
+            // evicted, show the placeholder again until the reload is uploaded
+            *entry->Loaded   = Texture(placeholder, { 1, 1 }, { 0, 0 }, { 1, 1 });
+            entry->Evicted   = false;
+            entry->Evictable = false;
+        }
+        TextureRef reference(this, entry);
+        schedule(*entry);
+        return reference;
+    }
+
+    void TextureManager::Update(double upload_budget_seconds)
+    {
+        const util::Timer timer;
+        while (!pending.empty())
+        {
+            auto ready = std::find_if(pending.begin(), pending.end(), [](const PendingTexture& entry) { return util::ThreadPool::IsReady(entry.Decoded); });
+            if (ready == pending.end())
+            {
+                return;
+            }
+
+            finish(*ready);
+            pending.erase(ready);
+            if (timer.GetElapsedSeconds() >= upload_budget_seconds)
+            {
+                return;
+            }
         }
     }
 
     void TextureManager::Unload()
     {
-        texture_cache.clear();
+        // decodes still running finish into futures nobody reads, unless they write into staging memory
+        for (PendingTexture& pending_texture : pending)
+        {
+            if (pending_texture.Staging)
+            {
+                pending_texture.Decoded.wait();
+                uploader.Cancel(pending_texture.Staging);
+            }
+        }
+        pending.clear();
+        texture_cache.ForEach(
+            [this](assets::AssetId, std::unique_ptr<CacheEntry>& entry)
+            {
+                Engine::GetFileWatcher().Unwatch(std::exchange(entry->Watch, 0));
+                if (entry->References > 0)
+                {
+                    *entry->Loaded  = Texture(0, entry->Loaded->GetSize());
+                    entry->Unloaded = true;
+                    unloaded.push_back(std::move(entry));
+                }
+            });
+        texture_cache.Clear();
+        lru.clear();
+        textureBytes = 0;
+        atlas.Clear();
+        if (placeholder != 0)
+        {
+            GL::DeleteTextures(1, &placeholder);
+            placeholder = 0;
+        }
+    }
+
+    void TextureManager::SetBudget(std::size_t bytes)
+    {
+        budget = bytes;
+        trim();
+    }
+
+    Texture TextureManager::createTexture(const CS200::Image& image, CacheEntry& entry)
+    {
+        if (entry.AtlasRegion)
+        {
+            // a reload, the atlas cannot free the old region so the new texels go into it when they fit
+            if (atlas.Replace(*entry.AtlasRegion, image, &uploader))
+            {
+                return Texture(entry.AtlasRegion->Page, entry.AtlasRegion->PageSize, entry.AtlasRegion->Offset, image.GetSize());
+            }
+            // inserting every new size again would take another region on each save
+            entry.AtlasRegion.reset();
+            entry.Packable = false;
+        }
+
+        if (const auto region = entry.Packable ? atlas.Insert(image, &uploader) : std::nullopt; region)
+        {
+            entry.Bytes       = 0;
+            entry.Evictable   = false;
+            entry.AtlasRegion = region;
+            return Texture(region->Page, region->PageSize, region->Offset, image.GetSize());
+        }
+        const OpenGL::TextureHandle handle = OpenGL::CreateTextureFromImage(image, entry.Filtering, OpenGL::Wrapping::ClampToEdge, &uploader);
+        OpenGL::SetAnisotropy(handle, entry.Anisotropy);
+
+        entry.Bytes     = texel_count(image.GetSize(), OpenGL::UsesMipmaps(entry.Filtering)) * sizeof(CS200::RGBA);
+        entry.Evictable = true;
+        return Texture(handle, image.GetSize());
+    }
+
+    Texture TextureManager::createTexture(const CS200::CompressedImage& image, CacheEntry& entry)
+    {
+        const OpenGL::TextureHandle handle = OpenGL::CreateTextureFromCompressedImage(image, entry.Filtering, OpenGL::Wrapping::ClampToEdge);
+        OpenGL::SetAnisotropy(handle, entry.Anisotropy);
+
+        // a variant that appeared since an atlas upload, later reloads must not take another region
+        entry.AtlasRegion.reset();
+        entry.Packable = false;
+
+        entry.Bytes = 0;
+        for (const auto& level : image.GetLevels())
+        {
+            entry.Bytes += level.Blocks.size();
+        }
+        entry.Evictable = true;
+        return Texture(handle, image.GetSize());
+    }
+
+    Texture TextureManager::createTexture(const StagedImage& image, CacheEntry& entry)
+    {
+        // the worker wrote every level already, only the copy out of the staging buffer is issued here
+        const bool                  mipmapped = OpenGL::UsesMipmaps(entry.Filtering);
+        const OpenGL::TextureHandle handle    = OpenGL::CreateRGBATexture(image.Size, entry.Filtering, OpenGL::Wrapping::ClampToEdge);
+        uploader.SubmitMipChain(image.Staging, handle, image.Size, mipmapped);
+        OpenGL::SetAlphaContent(handle, image.Alpha);
+        OpenGL::SetAnisotropy(handle, entry.Anisotropy);
+
+        entry.Bytes     = texel_count(image.Size, mipmapped) * sizeof(CS200::RGBA);
+        entry.Evictable = true;
+        return Texture(handle, image.Size);
+    }
+
+    TextureManager::DecodedImage TextureManager::decodeImage(const std::filesystem::path& file_name, bool mipmapped, OpenGL::TextureUploader::Staging staging)
+    {
+        auto decoded = decode(file_name, mipmapped);
+        if (auto* image = std::get_if<CS200::Image>(&decoded); image != nullptr && staging)
+        {
+            const auto level0 = std::span(image->data(), texel_count(image->GetSize(), false));
+            const auto chain  = image->GetMipChain();
+            // the file may have changed since its size was read, the main thread then uploads the image itself
+            if (level0.size_bytes() + chain.size_bytes() == staging.Memory.size())
+            {
+                std::memcpy(staging.Memory.data(), level0.data(), level0.size_bytes());
+                if (!chain.empty())
+                {
+                    std::memcpy(staging.Memory.data() + level0.size_bytes(), chain.data(), chain.size_bytes());
+                }
+                // classified here, reading the write-combined staging memory back would be slow
+                return StagedImage{ staging, image->GetSize(), OpenGL::ClassifyAlpha(level0) };
+            }
+        }
+        return std::visit([](auto&& result) { return DecodedImage{ std::move(result) }; }, std::move(decoded));
+    }
+
+    OpenGL::TextureUploader::Staging TextureManager::reserveStaging(const CacheEntry& entry)
+    {
+        // atlas pages are filled with the edges extruded, and compressed variants are uploaded from their mapping
+        if (entry.Packable || has_compressed_variant(asset_path(entry.Id)))
+        {
+            return {};
+        }
+        const auto size = CS200::Image::ReadSize(asset_path(entry.Id));
+        if (!size || size->x <= 0 || size->y <= 0)
+        {
+            return {};
+        }
+        return uploader.Reserve(texel_count(*size, OpenGL::UsesMipmaps(entry.Filtering)) * sizeof(CS200::RGBA));
+    }
+
+    void TextureManager::schedule(CacheEntry& entry)
+    {
+        if (!workers)
+        {
+            workers = std::make_unique<util::ThreadPool>();
+        }
+
+        // only the decode runs on a worker, GL calls must stay on the thread owning the context. The worker
+        // also copies the texels into staging memory when a slot was free, Update() then just submits it
+        const OpenGL::TextureUploader::Staging staging = reserveStaging(entry);
+
+        auto decoded = workers->Submit([file_name = asset_path(entry.Id), mipmapped = OpenGL::UsesMipmaps(entry.Filtering), staging] { return decodeImage(file_name, mipmapped, staging); });
+        pending.push_back(PendingTexture{ &entry, std::move(decoded), staging });
+    }
+
+    void TextureManager::finish(PendingTexture& pending_texture)
+    {
+        try
+        {
+            const DecodedImage decoded = pending_texture.Decoded.get();
+            // a staged result owns the reservation from here on, anything else leaves it unused
+            const auto staging = std::exchange(pending_texture.Staging, {});
+            const bool unused  = pending_texture.Target == nullptr || !std::holds_alternative<StagedImage>(decoded);
+            if (staging && unused)
+            {
+                uploader.Cancel(staging);
+            }
+            if (pending_texture.Target != nullptr)
+            {
+                upload(*pending_texture.Target, decoded);
+            }
+        }
+        catch (const std::exception& e)
+        {
+            if (pending_texture.Staging)
+            {
+                uploader.Cancel(std::exchange(pending_texture.Staging, {}));
+            }
+            if (pending_texture.Target != nullptr)
+            {
+                Engine::GetLogger().LogError("Failed to load texture " + std::string(assets::get_path(pending_texture.Target->Id)) + ": " + std::string(e.what()));
+            }
+        }
+    }
+
+    void TextureManager::upload(CacheEntry& entry, const DecodedImage& decoded)
+    {
+        // a reload replaces a resident texture, take the old one out of the accounting first
+        textureBytes -= entry.Bytes;
+        if (entry.Queued)
+        {
+            lru.erase(entry.LruPosition);
+            entry.Queued = false;
+        }
+        Texture texture = std::visit([&](const auto& image) { return createTexture(image, entry); }, decoded);
+        if (entry.Loaded)
+        {
+            *entry.Loaded = std::move(texture);
+        }
+        else
+        {
+            entry.Loaded = std::make_unique<Texture>(std::move(texture));
+        }
+        entry.Evicted = false;
+        textureBytes += entry.Bytes;
+
+        // a texture whose references were all dropped while it was decoding can go right away
+        if (entry.References == 0 && entry.Evictable)
+        {
+            entry.LruPosition = lru.insert(lru.end(), &entry);
+            entry.Queued      = true;
+        }
+        trim();
+    }
+
+    TextureManager::CacheEntry& TextureManager::newEntry(assets::AssetId id)
+    {
+        auto entry        = std::make_unique<CacheEntry>();
+        entry->Id         = id;
+        entry->Filtering  = filtering;
+        entry->Anisotropy = anisotropy;
+        // atlas pages are sampled with nearest filtering only, and smaller mip levels would blend neighbouring images together
+        entry->Packable   = atlasMode && filtering == OpenGL::Filtering::NearestPixel;
+        CacheEntry& added = *(texture_cache[id] = std::move(entry));
+        watch(added);
+        return added;
+    }
+
+    void TextureManager::watch(CacheEntry& entry)
+    {
+        util::FileWatcher& watcher = Engine::GetFileWatcher();
+        if (!watcher.IsEnabled() || assets::find_packed(asset_path(entry.Id)))
+        {
+            return;
+        }
+        try
+        {
+            // entries never move, the unique_ptr in the cache keeps them in place
+            entry.Watch = watcher.Watch(assets::locate_asset(asset_path(entry.Id)), [this, &entry](const std::filesystem::path&) { reload(entry); });
+        }
+        catch (const std::runtime_error&)
+        {
+            // the file is missing, loading it reports that
+        }
+    }
+
+    void TextureManager::reload(CacheEntry& entry)
+    {
+        // an evicted texture is decoded from the new file by its next Load() anyway
+        if (entry.Evicted)
+        {
+            return;
+        }
+        Engine::GetLogger().LogEvent("Reloading texture " + std::string(assets::get_path(entry.Id)));
+
+        if (auto in_flight = std::find_if(pending.begin(), pending.end(), [&](const PendingTexture& pending_texture) { return pending_texture.Target == &entry; }); in_flight != pending.end())
+        {
+            // that decode may have read the file halfway through the save. It keeps running, and may still be
+            // writing into its staging memory, so Update() drops its result instead of it being waited for here
+            in_flight->Target = nullptr;
+        }
+        // the old texture keeps drawing until Update() uploads the new one
+        schedule(entry);
+    }
+
+    void TextureManager::retain(CacheEntry& entry)
+    {
+        if (entry.References++ == 0 && entry.Queued)
+        {
+            lru.erase(entry.LruPosition);
+            entry.Queued = false;
+        }
+    }
+
+    void TextureManager::release(CacheEntry& entry)
+    {
+        if (--entry.References > 0)
+        {
+            return;
+        }
+        if (entry.Unloaded)
+        {
+            std::erase_if(unloaded, [&](const std::unique_ptr<CacheEntry>& candidate) { return candidate.get() == &entry; });
+            return;
+        }
+        // still pending or never uploaded, upload() queues it once it is resident
+        if (entry.Evictable && !entry.Evicted)
+        {
+            entry.LruPosition = lru.insert(lru.end(), &entry);
+            entry.Queued      = true;
+            trim();
+        }
+    }
+
+    void TextureManager::evict(CacheEntry& entry)
+    {
+        lru.erase(entry.LruPosition);
+        entry.Queued  = false;
+        textureBytes -= entry.Bytes;
+        entry.Bytes   = 0;
+        entry.Evicted = true;
+        // keep the object, pointers handed out earlier draw nothing until the next Load()
+        *entry.Loaded = Texture(0, entry.Loaded->GetSize());
+        ++evictions;
+        Engine::GetLogger().LogDebug("Evicted texture " + std::string(assets::get_path(entry.Id)));
+    }
+
+    void TextureManager::trim()
+    {
+        while (GetResidentBytes() > budget && !lru.empty())
+        {
+            evict(*lru.front());
+        }
+    }
+
+    TextureRef::TextureRef(TextureManager* owner, TextureManager::CacheEntry* cache_entry) noexcept : manager(owner), entry(cache_entry)
+    {
+        manager->retain(*entry);
+    }
+
+    TextureRef::TextureRef(const TextureRef& other) noexcept : manager(other.manager), entry(other.entry)
+    {
+        if (entry != nullptr)
+        {
+            manager->retain(*entry);
+        }
+    }
+
+    TextureRef::TextureRef(TextureRef&& temporary) noexcept : manager(temporary.manager), entry(temporary.entry)
+    {
+        temporary.manager = nullptr;
+        temporary.entry   = nullptr;
+    }
+
+    TextureRef& TextureRef::operator=(const TextureRef& other) noexcept
+    {
+        if (this != &other)
+        {
+            TextureRef copy(other);
+            *this = std::move(copy);
+        }
+        return *this;
+    }
+
+    TextureRef& TextureRef::operator=(TextureRef&& temporary) noexcept
+    {
+        if (this != &temporary)
+        {
+            Reset();
+            std::swap(manager, temporary.manager);
+            std::swap(entry, temporary.entry);
+        }
+        return *this;
+    }
+
+    TextureRef::~TextureRef()
+    {
+        Reset();
+    }
+
+    void TextureRef::Reset() noexcept
+    {
+        if (entry != nullptr)
+        {
+            manager->release(*entry);
+        }
+        manager = nullptr;
+        entry   = nullptr;
+    }
+
+    Texture* TextureRef::Get() const noexcept
+    {
+        return entry != nullptr ? entry->Loaded.get() : nullptr;
     }
 
 }
@@ -9,15 +9,27 @@
  */
 
 #pragma once
+#include "CS200/CompressedImage.hpp"
+#include "CS200/Image.hpp"
+#include "Engine/AssetId.hpp"
+#include "Engine/FileWatcher.hpp"
 #include "Engine/Texture.hpp"
+#include "Engine/TextureAtlas.hpp"
+#include "Engine/ThreadPool.hpp"
+#include "OpenGL/TextureUploader.hpp"
+#include <algorithm>
 #include <filesystem>
+#include <future>
+#include <list>
 #include <memory>
-#include <unordered_map>
+#include <optional>
+#include <variant>
 #include <vector>
 
 namespace CS230
 {
     class Texture;
+    class TextureRef;
 
     /**
      * \brief Centralized texture resource management system with caching and render-to-texture capabilities
@@ -53,6 +65,52 @@ namespace CS230
      * The manager handles both file-loaded textures and runtime-generated textures
      * through a unified interface.
      *
+     * Atlas Mode:
+     * With SetAtlasMode(true) every image loaded afterwards is packed into a shared
+     * TextureAtlas page instead of getting its own GL texture. The returned Texture
+     * references its sub-rectangle and draws exactly like a standalone texture, but
+     * sprites from different files now share a texture and therefore a batch. Images
+     * too large for a page still get their own texture, and so do images loaded while
+     * SetFiltering() selects anything but OpenGL::Filtering::NearestPixel: a page has one
+     * filtering mode, NearestPixel, for every image on it.
+     *
+     * Asynchronous Loading:
+     * LoadAsync() returns at once with a texture showing a transparent 1×1 placeholder.
+     * The file is decoded on a worker thread, Update() (called by the engine every frame)
+     * uploads finished images on the main thread until a small time budget is used up
+     * and swaps them into the returned textures, so the pointers stay valid.
+     *
+     * Uploads:
+     * Texels reach the GPU through an OpenGL::TextureUploader, a ring of pixel unpack buffers, so
+     * creating a texture does not stall on the driver copying the image out of client memory.
+     * LoadAsync() reads the image size from the file header and reserves a staging buffer before
+     * the decode starts, the worker copies level 0 and the mip chain into it and Update() only
+     * issues the GPU copy. When all buffers are reserved already, the image is an atlas candidate
+     * or a compressed variant exists, Update() stages the decoded texels itself.
+     *
+     * Residency:
+     * Load() and LoadAsync() return a TextureRef, a reference counted handle. A texture nobody
+     * references any more stays cached, but once the bytes of all textures exceed the budget
+     * set with SetBudget() the least recently released ones are evicted: their GL texture is
+     * deleted while the Texture object stays, so old pointers draw nothing instead of dangling.
+     * The next Load() of the file uploads it again with the settings it was first loaded with.
+     * Referenced textures are never evicted, the budget can be exceeded while they are in use.
+     * Atlas pages count towards the budget but are only freed by Unload().
+     *
+     * Compressed Textures:
+     * Before decoding "ship.png" both loaders look for "ship.bptc.ktx", "ship.s3tc.ktx" and
+     * "ship.etc2.ktx" next to it, written by the texture_compressor tool. The first one the
+     * driver supports is uploaded as is with glCompressedTexImage2D, otherwise the PNG is
+     * used. Compressed textures are never packed into the atlas.
+     *
+     * Hot Reloading:
+     * While Engine::GetFileWatcher() is enabled every loaded image file is watched. Saving it decodes
+     * it again on a worker thread and Update() swaps the new GL texture into the same Texture object,
+     * the rest of the cache is untouched. An atlas image of unchanged size is written over its old
+     * region. One whose size changed gets its own texture from then on, its old region stays
+     * allocated until Unload(). Only the file that was loaded is watched, an edited PNG next to a
+     * compressed .ktx variant changes nothing until the variant is rebuilt.
+     *
      * Integration with Engine:
      * The TextureManager integrates seamlessly with the 2D renderer and coordinate
      * system, automatically handling viewport management and coordinate transformations
@@ -61,10 +119,25 @@ namespace CS230
     class TextureManager
     {
     public:
+        TextureManager() = default;
+
+        TextureManager(const TextureManager& other)            = delete;
+        TextureManager(TextureManager&& other)                 = delete;
+        TextureManager& operator=(const TextureManager& other) = delete;
+        TextureManager& operator=(TextureManager&& other)      = delete;
+
+        /**
+         * \brief Calls Unload(), the OpenGL context must still exist
+         *
+         * Deletes the placeholder texture and the atlas pages and waits for decodes that write
+         * into staging memory, so none of them outlive the manager.
+         */
+        ~TextureManager();
+
         /**
          * \brief Load a texture from file with automatic caching
          * \param file_name Path to the image file to load
-         * \return Pointer to the loaded texture (cached if previously loaded)
+         * \return Reference to the loaded texture (cached if previously loaded), empty when loading failed
          *
          * Loads a texture from the specified image file, utilizing an internal cache
          * to ensure that the same file is never loaded multiple times. If the texture
@@ -79,13 +152,15 @@ namespace CS230
          * Caching Behavior:
          * - First load: Reads file, creates GPU texture, stores in cache
          * - Subsequent loads: Returns cached texture immediately
-         * - Cache key: Full file path (different paths to same file create separate entries)
+         * - Cache key: The path's interned assets::AssetId (different paths to same file create separate entries)
          * - Memory efficiency: Prevents duplicate GPU resources for same image
          *
          * Resource Ownership:
          * The returned texture remains owned by the TextureManager and will be
          * automatically cleaned up when Unload() is called or the manager is
          * destroyed. Callers should not manually delete the returned texture.
+         * It stays resident while a TextureRef to it exists, dropping the last
+         * one makes it a candidate for eviction.
          *
          * Error Handling:
          * If the file cannot be loaded (missing file, unsupported format, etc.),
@@ -95,9 +170,18 @@ namespace CS230
          * Performance Characteristics:
          * - First load: File I/O + GPU texture creation overhead
          * - Cached loads: Very fast hash table lookup with no I/O
-         * - Memory usage: One GPU texture per unique file path
+         * - Memory usage: One GPU texture per unique file path, or a share of an atlas page in atlas mode
+         */
+        TextureRef Load(const std::filesystem::path& file_name);
+
+        /**
+         * \brief Load a texture by its interned path
+         * \param id ID from assets::intern(), AssetId::Invalid gives an empty reference
+         *
+         * A cache hit is a flat map probe with no string work or allocation, intern the path
+         * once and use this overload for textures fetched every frame.
          */
-        Texture* Load(const std::filesystem::path& file_name);
+        TextureRef Load(assets::AssetId id);
 
         /**
          * \brief Unload and clean up all managed textures
@@ -121,12 +205,243 @@ namespace CS230
          * Post-Cleanup State:
          * After calling Unload(), all previously returned texture pointers become
          * invalid and should not be used. The manager returns to its initial empty
-         * state and is ready to load new textures.
+         * state and is ready to load new textures. TextureRefs still alive keep an
+         * empty texture until they are released.
+         *
+         * Game states do not need to call it, releasing their TextureRefs lets the
+         * budget decide what stays cached for the next state.
          *
          */
         void Unload();
 
+        /**
+         * \brief Start loading a texture in the background
+         * \param file_name Path to the image file to load
+         * \return Texture that draws a transparent placeholder until the image is uploaded
+         *
+         * Shares the cache with Load(). Calling Load() for a file still in flight waits for
+         * it and uploads it immediately. If decoding fails the error is logged and the
+         * texture keeps the placeholder.
+         *
+         * GetSize() reports 1×1 until the upload, size-dependent layout should wait for
+         * GetPendingCount() to reach 0.
+         */
+        TextureRef LoadAsync(const std::filesystem::path& file_name);
+        TextureRef LoadAsync(assets::AssetId id);
+
+        /**
+         * \brief Upload images decoded since the last call
+         * \param upload_budget_seconds Stop once this much time was spent, at least one image is uploaded
+         */
+        void Update(double upload_budget_seconds = DefaultUploadBudget);
+
+        /**
+         * \brief Number of LoadAsync() textures still showing the placeholder, plus reloads not uploaded yet
+         */
+        [[nodiscard]] std::size_t GetPendingCount() const noexcept
+        {
+            return static_cast<std::size_t>(std::count_if(pending.begin(), pending.end(), [](const PendingTexture& pending_texture) { return pending_texture.Target != nullptr; }));
+        }
+
+        /**
+         * \brief Main thread time per frame Update() may spend uploading, in seconds
+         */
+        static constexpr double DefaultUploadBudget = 0.002;
+
+        /**
+         * \brief Pack the images of following Load() calls into shared atlas pages
+         * \param enabled true to pack, false to create one texture per image again
+         *
+         * Only affects images that are not cached yet. Pages are deleted by Unload().
+         */
+        void SetAtlasMode(bool enabled) noexcept
+        {
+            atlasMode = enabled;
+        }
+
+        /**
+         * \brief Sampling of the textures created by following Load() calls
+         * \param new_filtering Filtering mode, mipmapped modes get their chain built where the image is decoded and cached with its texels
+         * \param max_anisotropy Passed to OpenGL::SetAnisotropy(), 1 disables anisotropic filtering
+         *
+         * Defaults to OpenGL::Filtering::NearestPixel. Use a mipmapped mode for sprites that are drawn
+         * much smaller than their image. Only NearestPixel images are packed into the atlas, its pages
+         * are sampled that way and smaller mip levels would mix neighbouring images together.
+         */
+        void SetFiltering(OpenGL::Filtering new_filtering, float max_anisotropy = 1.0f) noexcept
+        {
+            filtering  = new_filtering;
+            anisotropy = max_anisotropy;
+        }
+
+        /**
+         * \brief Number of atlas pages currently allocated
+         */
+        [[nodiscard]] std::size_t GetAtlasPageCount() const noexcept
+        {
+            return atlas.GetPageCount();
+        }
+
+        /**
+         * \brief Limit for the GPU memory of all cached textures, in bytes
+         * \param bytes New budget, unreferenced textures are evicted at once until it is met
+         */
+        void SetBudget(std::size_t bytes);
+
+        [[nodiscard]] std::size_t GetBudget() const noexcept
+        {
+            return budget;
+        }
+
+        /**
+         * \brief Estimated GPU memory of the resident textures and atlas pages, in bytes
+         */
+        [[nodiscard]] std::size_t GetResidentBytes() const noexcept
+        {
+            return textureBytes + atlas.GetByteSize();
+        }
+
+        /**
+         * \brief Number of textures evicted since the manager was created
+         */
+        [[nodiscard]] std::size_t GetEvictionCount() const noexcept
+        {
+            return evictions;
+        }
+
+        /**
+         * \brief Budget of a new manager, in bytes
+         */
+        static constexpr std::size_t DefaultBudget = std::size_t{ 256 } << 20;
+
+        /**
+         * \brief Pixel buffer ring every texture created by the manager is uploaded through
+         *
+         * Also available for textures made elsewhere, see OpenGL::TextureUploader.
+         */
+        [[nodiscard]] OpenGL::TextureUploader& GetUploader() noexcept
+        {
+            return uploader;
+        }
+
+    private:
+        friend class TextureRef;
+
+        // level 0 and, for a mipmapped entry, the smaller levels, already copied into staging memory by a worker
+        struct StagedImage
+        {
+            OpenGL::TextureUploader::Staging Staging{};
+            Math::ivec2                      Size{};
+            OpenGL::AlphaContent             Alpha = OpenGL::AlphaContent::Unknown;
+        };
+
+        using DecodedImage = std::variant<CS200::Image, CS200::CompressedImage, StagedImage>;
+
+        struct CacheEntry
+        {
+            assets::AssetId                     Id = assets::AssetId::Invalid;
+            std::unique_ptr<Texture>            Loaded;
+            std::size_t                         Bytes      = 0; // GPU memory of a standalone texture, 0 inside the atlas
+            int                                 References = 0;
+            OpenGL::Filtering                   Filtering  = OpenGL::Filtering::NearestPixel;
+            float                               Anisotropy = 1.0f;
+            bool                                Packable   = false; // atlas mode was on and filtering was NearestPixel when it was first loaded
+            std::optional<TextureAtlas::Region> AtlasRegion{}; // set while the texture lives in an atlas page
+            bool                                Evictable  = false; // uploaded into its own GL texture
+            bool                                Evicted    = false;
+            bool                                Unloaded   = false; // removed by Unload() while still referenced
+            bool                                Queued     = false; // LruPosition is valid
+            std::list<CacheEntry*>::iterator    LruPosition{};
+            util::FileWatcher::WatchId          Watch = 0; // 0 when hot reloading is off
+        };
+
+        struct PendingTexture
+        {
+            CacheEntry*                      Target = nullptr; // nullptr once a newer decode of the same file replaced this one
+            std::future<DecodedImage>        Decoded;
+            OpenGL::TextureUploader::Staging Staging{}; // written by the worker until Decoded is ready
+        };
+
+        static DecodedImage decodeImage(const std::filesystem::path& file_name, bool mipmapped, OpenGL::TextureUploader::Staging staging);
+
+        Texture                          createTexture(const CS200::Image& image, CacheEntry& entry);
+        Texture                          createTexture(const CS200::CompressedImage& image, CacheEntry& entry);
+        Texture                          createTexture(const StagedImage& image, CacheEntry& entry);
+        OpenGL::TextureUploader::Staging reserveStaging(const CacheEntry& entry);
+        void                             schedule(CacheEntry& entry);
+        void                             finish(PendingTexture& pending_texture);
+        void                             upload(CacheEntry& entry, const DecodedImage& decoded);
+        CacheEntry&                      newEntry(assets::AssetId id);
+        void                             watch(CacheEntry& entry);
+        void                             reload(CacheEntry& entry);
+        void                             retain(CacheEntry& entry);
+        void                             release(CacheEntry& entry);
+        void                             evict(CacheEntry& entry);
+        void                             trim();
+
+        assets::IdMap<std::unique_ptr<CacheEntry>> texture_cache{};
+        std::list<CacheEntry*>                     lru{};      // unreferenced evictable entries, least recently released first
+        std::vector<std::unique_ptr<CacheEntry>>   unloaded{}; // kept until their last TextureRef is gone
+        std::size_t                                budget       = DefaultBudget;
+        std::size_t                                textureBytes = 0;
+        std::size_t                                evictions    = 0;
+        TextureAtlas                               atlas{};
+        bool                                       atlasMode  = false;
+        OpenGL::Filtering                          filtering  = OpenGL::Filtering::NearestPixel;
+        float                                      anisotropy = 1.0f;
+        std::vector<PendingTexture>                pending{};
+        OpenGL::TextureHandle                      placeholder = 0;
+        std::unique_ptr<util::ThreadPool>          workers{}; // started by the first LoadAsync()
+        OpenGL::TextureUploader                    uploader{};
+    };
+
+    /**
+     * \brief Reference counted handle to a texture cached by the TextureManager
+     *
+     * While at least one TextureRef to a texture exists the manager keeps it resident. Copying
+     * adds a reference, destroying or Reset() removes one. A default constructed TextureRef,
+     * or the result of a failed Load(), is empty and converts to false.
+     *
+     * The Texture pointer stays the same for the lifetime of the manager, an asynchronously
+     * loaded texture is swapped into it when its upload finishes.
+     */
+    class TextureRef
+    {
+    public:
+        TextureRef() = default;
+        TextureRef(const TextureRef& other) noexcept;
+        TextureRef(TextureRef&& temporary) noexcept;
+        TextureRef& operator=(const TextureRef& other) noexcept;
+        TextureRef& operator=(TextureRef&& temporary) noexcept;
+        ~TextureRef();
+
+        /**
+         * \brief Drop the reference, the texture becomes a candidate for eviction when it was the last one
+         */
+        void Reset() noexcept;
+
+        [[nodiscard]] Texture* Get() const noexcept;
+
+        Texture* operator->() const noexcept
+        {
+            return Get();
+        }
+
+        Texture& operator*() const noexcept
+        {
+            return *Get();
+        }
+
+        explicit operator bool() const noexcept
+        {
+            return Get() != nullptr;
+        }
+
     private:
-        std::unordered_map<std::string, std::unique_ptr<Texture>> texture_cache;
+        friend class TextureManager;
+        TextureRef(TextureManager* owner, TextureManager::CacheEntry* cache_entry) noexcept;
+
+        TextureManager*             manager = nullptr;
+        TextureManager::CacheEntry* entry   = nullptr;
     };
 }
@@ -0,0 +1,74 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ThreadPool.hpp"
+#include <algorithm>
+
+namespace
+{
+#if defined(__EMSCRIPTEN__) && !defined(__EMSCRIPTEN_PTHREADS__)
+    constexpr bool HAS_THREADS = false;
+#else
+    constexpr bool HAS_THREADS = true;
+#endif
+}
+
+namespace util
+{
+    ThreadPool::ThreadPool(unsigned worker_count)
+    {
+        if constexpr (!HAS_THREADS)
+        {
+            return;
+        }
+
+        if (worker_count == 0)
+        {
+            const unsigned hardware_threads = std::thread::hardware_concurrency();
+            worker_count                    = std::clamp(hardware_threads > 1 ? hardware_threads - 1 : 1u, 1u, MaxDefaultWorkers);
+        }
+        workers.reserve(worker_count);
+        for (unsigned i = 0; i < worker_count; ++i)
+        {
+            workers.emplace_back([this] { workerLoop(); });
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            const std::lock_guard lock{ mutex };
+            stopping = true;
+            // abandoned packaged tasks report std::future_error(broken_promise) to whoever still waits
+            jobs.clear();
+        }
+        wakeUp.notify_all();
+        for (std::thread& worker : workers)
+        {
+            worker.join();
+        }
+    }
+
+    void ThreadPool::workerLoop()
+    {
+        while (true)
+        {
+            std::function<void()> job;
+            {
+                std::unique_lock lock{ mutex };
+                wakeUp.wait(lock, [this] { return stopping || !jobs.empty(); });
+                if (stopping)
+                {
+                    return;
+                }
+                job = std::move(jobs.front());
+                jobs.pop_front();
+            }
+            job();
+        }
+    }
+}
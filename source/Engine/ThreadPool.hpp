@@ -0,0 +1,110 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace util
+{
+    /**
+     * \brief Fixed set of worker threads running queued jobs in submission order
+     *
+     * Meant for CPU work that must stay off the main thread, like decoding images. Jobs must not touch
+     * OpenGL, the context belongs to the main thread, hand the result back through the returned future.
+     *
+     * Builds without thread support (Emscripten without pthreads) get no workers. Submit() then returns
+     * a deferred future, the job runs on the main thread when the result is first asked for.
+     *
+     * Example Usage:
+     * \code
+     * util::ThreadPool pool;
+     * std::future<CS200::Image> image = pool.Submit([] { return CS200::Image{ "Assets/ship.png", true }; });
+     * ...
+     * if (util::ThreadPool::IsReady(image))
+     *     use(image.get());                                       // rethrows what the job threw
+     * \endcode
+     */
+    class ThreadPool
+    {
+    public:
+        /**
+         * \brief Upper bound of the default worker count, decoding more files at once mostly competes for the disk
+         */
+        static constexpr unsigned MaxDefaultWorkers = 4;
+
+        /**
+         * \brief Start the workers
+         * \param worker_count Number of threads, 0 picks hardware threads - 1 clamped to [1, MaxDefaultWorkers]
+         */
+        explicit ThreadPool(unsigned worker_count = 0);
+
+        ThreadPool(const ThreadPool& other)            = delete;
+        ThreadPool(ThreadPool&& other)                 = delete;
+        ThreadPool& operator=(const ThreadPool& other) = delete;
+        ThreadPool& operator=(ThreadPool&& other)      = delete;
+
+        /**
+         * \brief Drop the jobs nobody started yet and join the workers
+         */
+        ~ThreadPool();
+
+        /**
+         * \brief Queue a job
+         * \param job Callable taking no argument, its return value or exception ends up in the future
+         */
+        template <typename Job>
+        [[nodiscard]] std::future<std::invoke_result_t<Job>> Submit(Job&& job)
+        {
+            using Result = std::invoke_result_t<Job>;
+            if (workers.empty())
+            {
+                return std::async(std::launch::deferred, std::forward<Job>(job));
+            }
+
+            auto                task   = std::make_shared<std::packaged_task<Result()>>(std::forward<Job>(job));
+            std::future<Result> result = task->get_future();
+            {
+                const std::lock_guard lock{ mutex };
+                jobs.emplace_back([task] { (*task)(); });
+            }
+            wakeUp.notify_one();
+            return result;
+        }
+
+        /**
+         * \brief true when get() will not block on a worker, deferred jobs count as ready
+         */
+        template <typename Result>
+        [[nodiscard]] static bool IsReady(const std::future<Result>& future)
+        {
+            return future.wait_for(std::chrono::seconds(0)) != std::future_status::timeout;
+        }
+
+        [[nodiscard]] std::size_t GetWorkerCount() const noexcept
+        {
+            return workers.size();
+        }
+
+    private:
+        void workerLoop();
+
+        std::vector<std::thread>          workers{};
+        std::deque<std::function<void()>> jobs{};
+        std::mutex                        mutex{};
+        std::condition_variable           wakeUp{};
+        bool                              stopping = false;
+    };
+}
@@ -9,6 +9,21 @@
 #include "Buffer.hpp"
 #include "GL.hpp"
 
+namespace
+{
+    // Buffers are left bound after an update, the GL state cache makes rebinding them free.
+    // The element array binding belongs to the bound vertex array object though, so leave
+    // whatever VAO is bound alone before touching it.
+    void bind_for_update(GLenum target, GLuint buffer)
+    {
+        if (target == GL_ELEMENT_ARRAY_BUFFER)
+        {
+            GL::BindVertexArray(0);
+        }
+        GL::BindBuffer(target, buffer);
+    }
+}
+
 namespace OpenGL
 {
     BufferHandle CreateBuffer(BufferType type, GLsizeiptr size_in_bytes) noexcept
@@ -16,7 +31,7 @@ namespace OpenGL
     GLenum bufferType    = static_cast<GLenum>(type);
     GLuint buffer_handle = 0;
     GL::GenBuffers(1, &buffer_handle);
-    GL::BindBuffer(bufferType, buffer_handle);
+    bind_for_update(bufferType, buffer_handle);
     GL::BufferData(bufferType, size_in_bytes, nullptr, GL_DYNAMIC_DRAW);
 
     GLint size = 0;
@@ -26,7 +41,6 @@ namespace OpenGL
         GL::DeleteBuffers(1, &buffer_handle);
         return 0;
     }
-    GL::BindBuffer(bufferType, 0);
     return buffer_handle;
 }
 
@@ -36,7 +50,7 @@ BufferHandle CreateBuffer(BufferType type, std::span<const std::byte> static_buf
     const GLsizeiptr size_bytes    = static_buffer_data.size_bytes();
     GLuint           buffer_handle = 0;
     GL::GenBuffers(1, &buffer_handle);
-    GL::BindBuffer(bufferType, buffer_handle);
+    bind_for_update(bufferType, buffer_handle);
     GL::BufferData(bufferType, size_bytes, static_buffer_data.data(), GL_STATIC_DRAW);
 
     GLint size = 0;
@@ -46,16 +60,14 @@ BufferHandle CreateBuffer(BufferType type, std::span<const std::byte> static_buf
         GL::DeleteBuffers(1, &buffer_handle);
         return 0;
     }
-    GL::BindBuffer(bufferType, 0);
     return buffer_handle;
 }
 
     void UpdateBufferData(BufferType type, BufferHandle buffer, std::span<const std::byte> data_to_copy, GLsizei starting_offset) noexcept
     {
         GLenum bufferType = static_cast<GLenum>(type);
-        GL::BindBuffer(bufferType, buffer);
+        bind_for_update(bufferType, buffer);
 
         GL::BufferSubData(bufferType, starting_offset, data_to_copy.size_bytes(), data_to_copy.data());
-        GL::BindBuffer(bufferType, 0);
     }
 }
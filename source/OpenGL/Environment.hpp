@@ -7,6 +7,8 @@
  */
 #pragma once
 
+#include <cstdint>
+
 namespace OpenGL
 {
     inline int MajorVersion         = 0;
@@ -14,6 +16,26 @@ namespace OpenGL
     inline int MaxTextureImageUnits = 2;
     inline int MaxTextureSize       = 64;
 
+    // GL 4.4 or GL_ARB_buffer_storage, enables persistent mapped buffers
+    inline bool HasBufferStorage = false;
+
+    // block compressed texture formats the driver accepts in glCompressedTexImage2D
+    inline bool HasETC2 = false; // GL 4.3, GL_ARB_ES3_compatibility, WEBGL_compressed_texture_etc
+    inline bool HasS3TC = false; // GL_EXT_texture_compression_s3tc, WEBGL_compressed_texture_s3tc
+    inline bool HasBPTC = false; // GL 4.2, GL_ARB_texture_compression_bptc, EXT_texture_compression_bptc
+
+    // GL 4.6, GL_ARB_texture_filter_anisotropic, GL_EXT_texture_filter_anisotropic, 1 when unsupported
+    inline float MaxAnisotropy = 1.0f;
+
+    // GL 4.1 or GL_ARB_get_program_binary with at least one binary format, never on WebGL
+    inline bool HasProgramBinary = false;
+
+    // GL_KHR_parallel_shader_compile or GL_ARB_parallel_shader_compile, programs can be polled with GL_COMPLETION_STATUS_KHR
+    inline bool HasParallelShaderCompile = false;
+
+    // hash of GL_VENDOR, GL_RENDERER and GL_VERSION, program binaries are only valid for the driver that made them
+    inline std::uint64_t DriverHash = 0;
+
     constexpr int version(int major, int minor) noexcept
     {
         return major * 100 + minor * 10;
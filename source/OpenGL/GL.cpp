@@ -12,10 +12,15 @@
 #include "Engine/Logger.hpp"
 #include "GL.hpp"
 
+#include <algorithm>
+#include <array>
 #include <cassert>
 #include <iostream>
+#include <limits>
+#include <span>
 #include <sstream>
 #include <string>
+#include <utility>
 
 
 #if defined(DEVELOPER_VERSION)
@@ -110,6 +115,89 @@ namespace
 #    define glCheck(expression)  expression
 #endif
 
+namespace
+{
+    /**
+     * Shadow copy of the driver state touched by the GL:: wrappers.
+     *
+     * Binding and enable calls compare against the cached value first and only reach the driver when
+     * the value actually changes. Every entry starts as UNKNOWN so the first call always goes through,
+     * and InvalidateStateCache() puts everything back to UNKNOWN after code outside of GL:: (ImGui)
+     * has changed the state behind our back.
+     */
+    constexpr GLuint UNKNOWN = std::numeric_limits<GLuint>::max();
+
+    struct StateCache
+    {
+        static constexpr GLuint MaxTextureUnits = 32;
+
+        GLuint                                    program       = UNKNOWN;
+        GLuint                                    vertexArray   = UNKNOWN;
+        GLuint                                    activeTexture = UNKNOWN; // unit index, not GL_TEXTUREi
+        std::array<GLuint, MaxTextureUnits>       textures2D{};
+        std::array<std::pair<GLenum, GLuint>, 7>  buffers{};
+        std::array<std::pair<GLenum, GLuint>, 5>  capabilities{};
+        std::array<GLuint, 2>                     blendFunc{};
+        std::array<GLint, 4>                      viewport{};
+        bool                                      viewportKnown = false;
+        GL::StateCacheStats                       stats{};
+
+        StateCache() noexcept
+        {
+            Invalidate();
+        }
+
+        void Invalidate() noexcept
+        {
+            program       = UNKNOWN;
+            vertexArray   = UNKNOWN;
+            activeTexture = UNKNOWN;
+            textures2D.fill(UNKNOWN);
+            buffers      = { { { GL_ARRAY_BUFFER, UNKNOWN },
+                               { GL_ELEMENT_ARRAY_BUFFER, UNKNOWN },
+                               { GL_UNIFORM_BUFFER, UNKNOWN },
+                               { GL_PIXEL_PACK_BUFFER, UNKNOWN },
+                               { GL_PIXEL_UNPACK_BUFFER, UNKNOWN },
+                               { GL_COPY_READ_BUFFER, UNKNOWN },
+                               { GL_COPY_WRITE_BUFFER, UNKNOWN } } };
+            capabilities = { { { GL_BLEND, UNKNOWN }, { GL_DEPTH_TEST, UNKNOWN }, { GL_CULL_FACE, UNKNOWN }, { GL_SCISSOR_TEST, UNKNOWN }, { GL_STENCIL_TEST, UNKNOWN } } };
+            blendFunc.fill(UNKNOWN);
+            viewportKnown = false;
+        }
+
+        template <std::size_t N>
+        static GLuint* Find(std::array<std::pair<GLenum, GLuint>, N>& table, GLenum key) noexcept
+        {
+            const auto found = std::find_if(table.begin(), table.end(), [key](const auto& entry) { return entry.first == key; });
+            return found == table.end() ? nullptr : &found->second;
+        }
+
+        // true when the driver has to be called
+        bool Update(GLuint& cached, GLuint value) noexcept
+        {
+            if (cached == value)
+            {
+                ++stats.Skipped;
+                return false;
+            }
+            cached = value;
+            ++stats.Issued;
+            return true;
+        }
+
+        GLuint* BoundTexture2D() noexcept
+        {
+            return activeTexture < MaxTextureUnits ? &textures2D[activeTexture] : nullptr;
+        }
+    };
+
+    StateCache& state_cache() noexcept
+    {
+        static StateCache cache;
+        return cache;
+    }
+}
+
 
 namespace GL
 {
@@ -181,6 +269,11 @@ namespace GL
 
     void ActiveTexture(GLenum texture SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        if (!cache.Update(cache.activeTexture, texture - GL_TEXTURE0))
+        {
+            return;
+        }
         glCheck(glActiveTexture(texture));
     }
 
@@ -191,16 +284,35 @@ namespace GL
 
     void BindBuffer(GLenum target, GLuint buffer SOURCE_LOCATION)
     {
+        auto& cache   = state_cache();
+        auto* binding = StateCache::Find(cache.buffers, target);
+        if (binding != nullptr && !cache.Update(*binding, buffer))
+        {
+            return;
+        }
         glCheck(glBindBuffer(target, buffer));
     }
 
     void BindBufferBase(GLenum target, GLuint index, GLuint buffer SOURCE_LOCATION)
     {
         glCheck(glBindBufferBase(target, index, buffer));
+        // also binds the generic target
+        if (auto* binding = StateCache::Find(state_cache().buffers, target); binding != nullptr)
+        {
+            *binding = buffer;
+        }
     }
 
     void BindTexture(GLenum target, GLuint texture SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        if (target == GL_TEXTURE_2D)
+        {
+            if (auto* binding = cache.BoundTexture2D(); binding != nullptr && !cache.Update(*binding, texture))
+            {
+                return;
+            }
+        }
         glCheck(glBindTexture(target, texture));
     }
 
@@ -211,6 +323,14 @@ namespace GL
 
     void BlendFunc(GLenum sfactor, GLenum dfactor SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        if (cache.blendFunc[0] == sfactor && cache.blendFunc[1] == dfactor)
+        {
+            ++cache.stats.Skipped;
+            return;
+        }
+        cache.blendFunc = { sfactor, dfactor };
+        ++cache.stats.Issued;
         glCheck(glBlendFunc(sfactor, dfactor));
     }
 
@@ -247,6 +367,17 @@ namespace GL
     void DeleteBuffers(GLsizei n, const GLuint* buffers SOURCE_LOCATION)
     {
         glCheck(glDeleteBuffers(n, buffers));
+        // deleting a bound buffer reverts that binding to zero
+        for (const GLuint buffer : std::span{ buffers, static_cast<std::size_t>(n) })
+        {
+            for (auto& binding : state_cache().buffers)
+            {
+                if (buffer != 0 && binding.second == buffer)
+                {
+                    binding.second = 0;
+                }
+            }
+        }
     }
 
     void DeleteProgram(GLuint program SOURCE_LOCATION)
@@ -262,6 +393,16 @@ namespace GL
     void DeleteTextures(GLsizei n, const GLuint* textures SOURCE_LOCATION)
     {
         glCheck(glDeleteTextures(n, textures));
+        // deleting a bound texture reverts that binding to zero
+        for (const GLuint texture : std::span{ textures, static_cast<std::size_t>(n) })
+        {
+            std::replace_if(state_cache().textures2D.begin(), state_cache().textures2D.end(), [texture](GLuint bound) { return texture != 0 && bound == texture; }, 0u);
+        }
+    }
+
+    void DepthFunc(GLenum func SOURCE_LOCATION)
+    {
+        glCheck(glDepthFunc(func));
     }
 
     void DepthMask(GLboolean flag SOURCE_LOCATION)
@@ -271,6 +412,12 @@ namespace GL
 
     void Disable(GLenum cap SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        auto* state = StateCache::Find(cache.capabilities, cap);
+        if (state != nullptr && !cache.Update(*state, GL_FALSE))
+        {
+            return;
+        }
         glCheck(glDisable(cap));
     }
 
@@ -291,6 +438,12 @@ namespace GL
 
     void Enable(GLenum cap SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        auto* state = StateCache::Find(cache.capabilities, cap);
+        if (state != nullptr && !cache.Update(*state, GL_TRUE))
+        {
+            return;
+        }
         glCheck(glEnable(cap));
     }
 
@@ -546,6 +699,11 @@ namespace GL
 
     void UseProgram(GLuint program SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        if (!cache.Update(cache.program, program))
+        {
+            return;
+        }
         glCheck(glUseProgram(program));
     }
 
@@ -761,6 +919,16 @@ namespace GL
 
     void Viewport(GLint x, GLint y, GLsizei width, GLsizei height SOURCE_LOCATION)
     {
+        auto&                      cache    = state_cache();
+        const std::array<GLint, 4> viewport = { x, y, width, height };
+        if (cache.viewportKnown && cache.viewport == viewport)
+        {
+            ++cache.stats.Skipped;
+            return;
+        }
+        cache.viewport      = viewport;
+        cache.viewportKnown = true;
+        ++cache.stats.Issued;
         glCheck(glViewport(x, y, width, height));
     }
 
@@ -782,7 +950,14 @@ namespace GL
 
     void BindVertexArray(GLuint array SOURCE_LOCATION)
     {
+        auto& cache = state_cache();
+        if (!cache.Update(cache.vertexArray, array))
+        {
+            return;
+        }
         glCheck(glBindVertexArray(array));
+        // the element array binding is part of the vertex array object
+        *StateCache::Find(cache.buffers, GL_ELEMENT_ARRAY_BUFFER) = UNKNOWN;
     }
 
     void DeleteFramebuffers(GLsizei n, GLuint* framebuffers SOURCE_LOCATION)
@@ -793,6 +968,15 @@ namespace GL
     void DeleteVertexArrays(GLsizei n, const GLuint* arrays SOURCE_LOCATION)
     {
         glCheck(glDeleteVertexArrays(n, arrays));
+        auto& cache = state_cache();
+        for (const GLuint array : std::span{ arrays, static_cast<std::size_t>(n) })
+        {
+            if (array != 0 && cache.vertexArray == array)
+            {
+                cache.vertexArray                                          = 0;
+                *StateCache::Find(cache.buffers, GL_ELEMENT_ARRAY_BUFFER) = UNKNOWN;
+            }
+        }
     }
 
     void FramebufferTexture2D(GLenum target, GLenum attachment, GLenum textarget, GLuint texture, GLint level SOURCE_LOCATION)
@@ -810,6 +994,12 @@ namespace GL
         glCheck(glGenVertexArrays(n, arrays));
     }
 
+    const GLubyte* GetStringi(GLenum name, GLuint index SOURCE_LOCATION)
+    {
+        glCheck(const auto result = glGetStringi(name, index));
+        return result;
+    }
+
     GLboolean IsFramebuffer(GLuint framebuffer SOURCE_LOCATION)
     {
         glCheck(const auto result = glIsFramebuffer(framebuffer));
@@ -846,6 +1036,12 @@ namespace GL
         return result;
     }
 
+    GLboolean UnmapBuffer(GLenum target SOURCE_LOCATION)
+    {
+        glCheck(const auto result = glUnmapBuffer(target));
+        return result;
+    }
+
     GLenum ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout SOURCE_LOCATION)
     {
         glCheck(const auto result = glClientWaitSync(sync, flags, timeout));
@@ -870,6 +1066,12 @@ namespace GL
         return index;
     }
 
+    void* MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access SOURCE_LOCATION)
+    {
+        glCheck(const auto pointer = glMapBufferRange(target, offset, length, access));
+        return pointer;
+    }
+
     void BeginQuery(GLenum target, GLuint id SOURCE_LOCATION)
     {
         glCheck(glBeginQuery(target, id));
@@ -1234,6 +1436,34 @@ namespace GL
 
 #if !defined(IS_WEBGL2)
 
+    // OpenGL 3.2
+    void DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLint basevertex SOURCE_LOCATION)
+    {
+        glCheck(glDrawElementsBaseVertex(mode, count, type, indices, basevertex));
+    }
+
+    // OpenGL 4.4 / GL_ARB_buffer_storage
+    void BufferStorage(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags SOURCE_LOCATION)
+    {
+        glCheck(glBufferStorage(target, size, data, flags));
+    }
+
+    // OpenGL 4.1 / GL_ARB_get_program_binary
+    void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary SOURCE_LOCATION)
+    {
+        glCheck(glGetProgramBinary(program, bufSize, length, binaryFormat, binary));
+    }
+
+    void ProgramBinary(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLsizei length SOURCE_LOCATION)
+    {
+        glCheck(glProgramBinary(program, binaryFormat, binary, length));
+    }
+
+    void ProgramParameteri(GLuint program, GLenum pname, GLint value SOURCE_LOCATION)
+    {
+        glCheck(glProgramParameteri(program, pname, value));
+    }
+
     // OpenGL 4.3+ Debug functions
     void DebugMessageCallback(DEBUGPROC callback, const void* userParam SOURCE_LOCATION)
     {
@@ -1247,4 +1477,19 @@ namespace GL
 
 #endif
 
+    // Shadow state cache
+    StateCacheStats GetStateCacheStats() noexcept
+    {
+        return state_cache().stats;
+    }
+
+    void ResetStateCacheStats() noexcept
+    {
+        state_cache().stats = {};
+    }
+
+    void InvalidateStateCache() noexcept
+    {
+        state_cache().Invalidate();
+    }
 }
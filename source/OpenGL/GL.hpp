@@ -56,6 +56,7 @@ namespace GL
     void           DeleteProgram(GLuint program SOURCE_LOCATION);
     void           DeleteShader(GLuint shader SOURCE_LOCATION);
     void           DeleteTextures(GLsizei n, const GLuint* textures SOURCE_LOCATION);
+    void           DepthFunc(GLenum func SOURCE_LOCATION);
     void           DepthMask(GLboolean flag SOURCE_LOCATION);
     void           DepthRange(GLdouble nearVal, GLdouble farVal SOURCE_LOCATION);
     void           DetachShader(GLuint program, GLuint shader SOURCE_LOCATION);
@@ -159,11 +160,13 @@ namespace GL
     GLboolean IsSampler(GLuint id SOURCE_LOCATION);
     GLboolean IsSync(GLsync sync SOURCE_LOCATION);
     GLboolean IsTransformFeedback(GLuint id SOURCE_LOCATION);
+    GLboolean UnmapBuffer(GLenum target SOURCE_LOCATION);
     GLenum    CheckFramebufferStatus(GLenum target SOURCE_LOCATION);
     GLenum    ClientWaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout SOURCE_LOCATION);
     GLint     GetFragDataLocation(GLuint program, const char* name SOURCE_LOCATION);
     GLsync    FenceSync(GLenum condition, GLbitfield flags SOURCE_LOCATION);
     GLuint    GetUniformBlockIndex(GLuint program, const GLchar* uniformBlockName SOURCE_LOCATION);
+    void*     MapBufferRange(GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access SOURCE_LOCATION);
     void      BeginQuery(GLenum target, GLuint id SOURCE_LOCATION);
     void      BeginTransformFeedback(GLenum primitiveMode SOURCE_LOCATION);
     void      BindFramebuffer(GLenum target, GLuint framebuffer SOURCE_LOCATION);
@@ -246,18 +249,43 @@ namespace GL
     void VertexAttribIPointer(GLuint index, GLint size, GLenum type, GLsizei stride, const GLvoid* pointer SOURCE_LOCATION);
     void WaitSync(GLsync sync, GLbitfield flags, GLuint64 timeout SOURCE_LOCATION);
 
+    const GLubyte* GetStringi(GLenum name, GLuint index SOURCE_LOCATION);
+
     // Opengl Version 3.2
+    void DrawElementsBaseVertex(GLenum mode, GLsizei count, GLenum type, const GLvoid* indices, GLint basevertex SOURCE_LOCATION);
     void TexImage2DMultisample(GLenum target, GLsizei samples, GLenum internalformat, GLsizei width, GLsizei height, GLboolean fixedsamplelocations SOURCE_LOCATION);
 
     // Opengl ES 3.0 or Opengl Version 4.2
     void TexStorage2D(GLenum target, GLsizei levels, GLenum internalformat, GLsizei width, GLsizei height SOURCE_LOCATION);
 
 
+    // Opengl 4.4 or GL_ARB_buffer_storage
+    void BufferStorage(GLenum target, GLsizeiptr size, const GLvoid* data, GLbitfield flags SOURCE_LOCATION);
+
+    // Opengl 4.1 or GL_ARB_get_program_binary
+    void GetProgramBinary(GLuint program, GLsizei bufSize, GLsizei* length, GLenum* binaryFormat, GLvoid* binary SOURCE_LOCATION);
+    void ProgramBinary(GLuint program, GLenum binaryFormat, const GLvoid* binary, GLsizei length SOURCE_LOCATION);
+    void ProgramParameteri(GLuint program, GLenum pname, GLint value SOURCE_LOCATION);
+
     // Opengl 4.3
     void DebugMessageCallback(DEBUGPROC callback, const void* userParam SOURCE_LOCATION);
     void DebugMessageControl(GLenum source, GLenum type, GLenum severity, GLsizei count, const GLuint* ids, GLboolean enabled SOURCE_LOCATION);
 
 
+    // Shadow state cache
+    // Program, vertex array, active texture unit, 2D texture per unit, buffer per target, blend/depth/cull/scissor/stencil
+    // enables, blend function and viewport are mirrored on the CPU, and wrapper calls that would not change them are skipped.
+    struct StateCacheStats
+    {
+        unsigned Issued  = 0; // tracked calls that reached the driver
+        unsigned Skipped = 0; // tracked calls dropped because the driver already had that state
+    };
+
+    [[nodiscard]] StateCacheStats GetStateCacheStats() noexcept;
+    void                          ResetStateCacheStats() noexcept;
+    // call after code that talks to OpenGL directly (e.g. the ImGui backend) so the next calls are not skipped by mistake
+    void                          InvalidateStateCache() noexcept;
+
 }
 
 #undef SOURCE_LOCATION
@@ -1271,3 +1271,29 @@
 #    define GL_TRANSFORM_FEEDBACK_STREAM_OVERFLOW 0x82ED
 
 #endif // GL_DEPTH_BUFFER_BIT
+
+// Texture extensions, defined by GLEW but missing from the WebGL2 / ES 3.0 headers
+#ifndef GL_COMPRESSED_RGB_S3TC_DXT1_EXT
+// EXT_texture_compression_s3tc, WEBGL_compressed_texture_s3tc
+#    define GL_COMPRESSED_RGB_S3TC_DXT1_EXT  0x83F0
+#    define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#    define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#    define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+// OpenGL 4.2, ARB_texture_compression_bptc, EXT_texture_compression_bptc
+#    define GL_COMPRESSED_RGBA_BPTC_UNORM       0x8E8C
+#    define GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM 0x8E8D
+#endif
+
+#ifndef GL_TEXTURE_MAX_ANISOTROPY
+// OpenGL 4.6, ARB_texture_filter_anisotropic, EXT_texture_filter_anisotropic (same values as the _EXT names)
+#    define GL_TEXTURE_MAX_ANISOTROPY     0x84FE
+#    define GL_MAX_TEXTURE_MAX_ANISOTROPY 0x84FF
+#endif
+
+#ifndef GL_COMPLETION_STATUS_KHR
+// KHR_parallel_shader_compile, ARB_parallel_shader_compile uses the same value
+#    define GL_COMPLETION_STATUS_KHR 0x91B1
+#endif
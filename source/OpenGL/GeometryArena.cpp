@@ -0,0 +1,260 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "GeometryArena.hpp"
+#include "GL.hpp"
+#include <algorithm>
+#include <iterator>
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    GLintptr align_up(GLintptr offset, GLsizeiptr alignment) noexcept
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    // a plain buffer of fixed size, no GL_BUFFER_SIZE read back like CreateBuffer() does
+    OpenGL::BufferHandle create_static_storage(OpenGL::BufferType type, GLsizeiptr size_in_bytes)
+    {
+        const auto target = static_cast<GLenum>(type);
+        GLuint     buffer = 0;
+        GL::GenBuffers(1, &buffer);
+        if (type == OpenGL::BufferType::Indices)
+        {
+            GL::BindVertexArray(0);
+        }
+        GL::BindBuffer(target, buffer);
+        GL::BufferData(target, size_in_bytes, nullptr, GL_STATIC_DRAW);
+        return buffer;
+    }
+
+    struct SharedArena
+    {
+        OpenGL::BufferLayout                   Layout{};
+        std::unique_ptr<OpenGL::GeometryArena> Arena{}; // behind a pointer, references handed out stay valid
+    };
+
+    std::vector<SharedArena> shared_arenas;
+}
+
+namespace OpenGL
+{
+    GeometryArena::GeometryArena(GeometryArena&& other) noexcept
+        : vao(other.vao), vertexBuffer(other.vertexBuffer), indexBuffer(other.indexBuffer), vertexStride(other.vertexStride), freeVertices(std::move(other.freeVertices)),
+          freeIndices(std::move(other.freeIndices))
+    {
+        other.vao          = 0;
+        other.vertexBuffer = 0;
+        other.indexBuffer  = 0;
+    }
+
+    GeometryArena& GeometryArena::operator=(GeometryArena&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(vao, other.vao);
+            std::swap(vertexBuffer, other.vertexBuffer);
+            std::swap(indexBuffer, other.indexBuffer);
+            std::swap(vertexStride, other.vertexStride);
+            std::swap(freeVertices, other.freeVertices);
+            std::swap(freeIndices, other.freeIndices);
+        }
+        return *this;
+    }
+
+    GeometryArena::~GeometryArena()
+    {
+        Shutdown();
+    }
+
+    void GeometryArena::Init(const BufferLayout& layout, GLsizeiptr vertex_capacity, GLsizeiptr index_capacity)
+    {
+        Shutdown();
+
+        vertexStride = 0;
+        for (Attribute::Type type : layout.Attributes)
+        {
+            vertexStride += type.SizeBytes;
+        }
+
+        vertexBuffer = create_static_storage(BufferType::Vertices, vertex_capacity);
+        indexBuffer  = create_static_storage(BufferType::Indices, index_capacity);
+        vao          = CreateVertexArrayObject(VertexBuffer{ vertexBuffer, layout }, indexBuffer);
+
+        freeVertices.Reset(vertex_capacity);
+        freeIndices.Reset(index_capacity);
+    }
+
+    void GeometryArena::Shutdown()
+    {
+        if (vao == 0 && vertexBuffer == 0 && indexBuffer == 0)
+        {
+            // nothing to delete, shared arenas reach their destructor after the context is gone
+            return;
+        }
+        GL::DeleteVertexArrays(1, &vao);
+        GL::DeleteBuffers(1, &vertexBuffer);
+        GL::DeleteBuffers(1, &indexBuffer);
+        vao          = 0;
+        vertexBuffer = 0;
+        indexBuffer  = 0;
+        freeVertices.Reset(0);
+        freeIndices.Reset(0);
+    }
+
+    GeometryArena::Mesh GeometryArena::Add(std::span<const std::byte> vertices, std::span<const std::uint32_t> indices)
+    {
+        const auto vertex_bytes = static_cast<GLsizeiptr>(vertices.size_bytes());
+        const auto index_bytes  = static_cast<GLsizeiptr>(indices.size_bytes());
+        if (vertexStride == 0 || vertex_bytes % vertexStride != 0)
+        {
+            throw std::runtime_error("GeometryArena: vertex data is not a whole number of vertices");
+        }
+
+        // vertex ranges are aligned to the stride so the base vertex is a whole vertex index
+        const GLintptr vertex_offset = freeVertices.Allocate(vertex_bytes, vertexStride);
+        if (vertex_offset < 0)
+        {
+            throw std::runtime_error("GeometryArena: no room for " + std::to_string(vertex_bytes) + " bytes of vertices");
+        }
+        const GLintptr index_offset = freeIndices.Allocate(index_bytes, static_cast<GLsizeiptr>(sizeof(std::uint32_t)));
+        if (index_offset < 0)
+        {
+            freeVertices.Release(vertex_offset, vertex_bytes);
+            throw std::runtime_error("GeometryArena: no room for " + std::to_string(indices.size()) + " indices");
+        }
+
+        const Mesh mesh{ vertex_offset, vertex_bytes, index_offset, static_cast<GLsizei>(indices.size()), static_cast<GLint>(vertex_offset / vertexStride) };
+
+        UpdateBufferData(BufferType::Vertices, vertexBuffer, vertices, static_cast<GLsizei>(vertex_offset));
+#if defined(IS_WEBGL2)
+        std::vector<std::uint32_t> rebased(indices.begin(), indices.end());
+        for (std::uint32_t& index : rebased)
+        {
+            index += static_cast<std::uint32_t>(mesh.BaseVertex);
+        }
+        UpdateBufferData(BufferType::Indices, indexBuffer, std::as_bytes(std::span{ rebased }), static_cast<GLsizei>(index_offset));
+#else
+        UpdateBufferData(BufferType::Indices, indexBuffer, std::as_bytes(indices), static_cast<GLsizei>(index_offset));
+#endif
+        return mesh;
+    }
+
+    void GeometryArena::Remove(const Mesh& mesh)
+    {
+        if (mesh.VertexBytes == 0 || vertexBuffer == 0)
+        {
+            return;
+        }
+        freeVertices.Release(mesh.VertexOffset, mesh.VertexBytes);
+        freeIndices.Release(mesh.IndexOffset, static_cast<GLsizeiptr>(mesh.IndexCount) * static_cast<GLsizeiptr>(sizeof(std::uint32_t)));
+    }
+
+    void GeometryArena::Draw(const Mesh& mesh, GLenum primitive) const
+    {
+        GL::BindVertexArray(vao);
+        const auto* first_index = reinterpret_cast<const GLvoid*>(mesh.IndexOffset);
+#if defined(IS_WEBGL2)
+        GL::DrawElements(primitive, mesh.IndexCount, GL_UNSIGNED_INT, first_index);
+#else
+        GL::DrawElementsBaseVertex(primitive, mesh.IndexCount, GL_UNSIGNED_INT, first_index, mesh.BaseVertex);
+#endif
+    }
+
+    void GeometryArena::FreeList::Reset(GLsizeiptr capacity)
+    {
+        ranges.clear();
+        if (capacity > 0)
+        {
+            ranges.push_back(Range{ 0, capacity });
+        }
+    }
+
+    GLintptr GeometryArena::FreeList::Allocate(GLsizeiptr size, GLsizeiptr alignment)
+    {
+        for (auto range = ranges.begin(); range != ranges.end(); ++range)
+        {
+            const GLintptr   aligned = align_up(range->Offset, alignment);
+            const GLsizeiptr padding = aligned - range->Offset;
+            if (padding + size > range->Size)
+            {
+                continue;
+            }
+
+            const Range tail{ aligned + size, range->Size - padding - size };
+            if (padding > 0)
+            {
+                // the bytes skipped for alignment stay free and merge back once the allocation is released
+                range->Size = padding;
+                if (tail.Size > 0)
+                {
+                    ranges.insert(range + 1, tail);
+                }
+            }
+            else if (tail.Size > 0)
+            {
+                *range = tail;
+            }
+            else
+            {
+                ranges.erase(range);
+            }
+            return aligned;
+        }
+        return -1;
+    }
+
+    void GeometryArena::FreeList::Release(GLintptr offset, GLsizeiptr size)
+    {
+        auto next = std::lower_bound(ranges.begin(), ranges.end(), offset, [](const Range& range, GLintptr value) { return range.Offset < value; });
+        next      = ranges.insert(next, Range{ offset, size });
+
+        if (auto after = next + 1; after != ranges.end() && next->Offset + next->Size == after->Offset)
+        {
+            next->Size += after->Size;
+            ranges.erase(after);
+        }
+        if (next != ranges.begin())
+        {
+            if (auto before = next - 1; before->Offset + before->Size == next->Offset)
+            {
+                before->Size += next->Size;
+                ranges.erase(next);
+            }
+        }
+    }
+
+    GeometryArena& GetSharedGeometryArena(const BufferLayout& layout)
+    {
+        auto shared = std::find_if(
+            shared_arenas.begin(), shared_arenas.end(),
+            [&](const SharedArena& candidate)
+            { return candidate.Layout.BufferStartingByteOffset == layout.BufferStartingByteOffset && candidate.Layout.Attributes == layout.Attributes; });
+        if (shared == shared_arenas.end())
+        {
+            shared_arenas.push_back(SharedArena{ layout, std::make_unique<GeometryArena>() });
+            shared = std::prev(shared_arenas.end());
+        }
+        if (shared->Arena->GetVertexArray() == 0)
+        {
+            shared->Arena->Init(layout);
+        }
+        return *shared->Arena;
+    }
+
+    void ShutdownSharedGeometryArenas()
+    {
+        for (SharedArena& shared : shared_arenas)
+        {
+            shared.Arena->Shutdown();
+        }
+    }
+}
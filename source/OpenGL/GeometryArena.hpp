@@ -0,0 +1,166 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Buffer.hpp"
+#include "GLTypes.hpp"
+#include "VertexArray.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+namespace OpenGL
+{
+    /**
+     * \brief Packs many static meshes of one vertex format into a shared vertex and index buffer
+     *
+     * Creating a buffer per mesh costs a driver allocation each time, CreateBuffer() also reads the size
+     * back, and every mesh ends up with its own VAO. A GeometryArena allocates one large vertex buffer,
+     * one large index buffer and a single VAO in Init(). Add() copies a mesh into free ranges of both
+     * buffers with glBufferSubData and returns where it landed, Remove() gives the ranges back.
+     *
+     * Free ranges are kept sorted by offset. Allocation is first-fit and released ranges are merged with
+     * their neighbours, so meshes loaded and unloaded with a demo reuse the same space.
+     *
+     * Every mesh of an arena shares the VAO, Draw() only changes the index byte offset and the base
+     * vertex (glDrawElementsBaseVertex). WebGL2 has no base vertex, there the indices are rebased on the
+     * CPU in Add() and drawn with glDrawElements.
+     *
+     * Example Usage:
+     * \code
+     * OpenGL::GeometryArena arena;
+     * arena.Init(OpenGL::BufferLayout{ { OpenGL::Attribute::Float2, OpenGL::Attribute::Float2 } });
+     * const auto quad = arena.Add(std::as_bytes(std::span{ quad_vertices }), quad_indices);
+     * const auto ship = arena.Add(std::as_bytes(std::span{ ship_vertices }), ship_indices);
+     *
+     * arena.Draw(quad);                                           // same VAO, no rebinding in between
+     * arena.Draw(ship);
+     * \endcode
+     *
+     * Code that owns only a few small meshes should not create an arena of its own, it would get its
+     * own buffers and VAO again. GetSharedGeometryArena() hands out one arena per vertex layout that
+     * every such owner adds its meshes to.
+     */
+    class GeometryArena
+    {
+    public:
+        /**
+         * \brief Default capacity of the vertex buffer in bytes
+         */
+        static constexpr GLsizeiptr DefaultVertexCapacity = 1024 * 1024;
+
+        /**
+         * \brief Default capacity of the index buffer in bytes, indices are 32 bit
+         */
+        static constexpr GLsizeiptr DefaultIndexCapacity = 256 * 1024;
+
+        /**
+         * \brief Where a mesh lives inside the arena, returned by Add()
+         */
+        struct Mesh
+        {
+            GLintptr   VertexOffset = 0; ///< bytes, always a multiple of the vertex stride
+            GLsizeiptr VertexBytes  = 0;
+            GLintptr   IndexOffset  = 0; ///< bytes into the index buffer
+            GLsizei    IndexCount   = 0;
+            GLint      BaseVertex   = 0; ///< VertexOffset / stride, added to every index when drawing
+        };
+
+        GeometryArena() noexcept = default;
+
+        GeometryArena(const GeometryArena& other)            = delete;
+        GeometryArena& operator=(const GeometryArena& other) = delete;
+
+        GeometryArena(GeometryArena&& other) noexcept;
+        GeometryArena& operator=(GeometryArena&& other) noexcept;
+
+        ~GeometryArena();
+
+        /**
+         * \brief Create the shared buffers and the VAO
+         * \param layout Interleaved vertex format shared by every mesh of this arena
+         * \param vertex_capacity Size of the vertex buffer in bytes
+         * \param index_capacity Size of the index buffer in bytes
+         */
+        void Init(const BufferLayout& layout, GLsizeiptr vertex_capacity = DefaultVertexCapacity, GLsizeiptr index_capacity = DefaultIndexCapacity);
+
+        /**
+         * \brief Delete the buffers and the VAO, every Mesh becomes invalid, safe to call multiple times
+         */
+        void Shutdown();
+
+        /**
+         * \brief Copy a mesh into the arena
+         * \param vertices Interleaved vertices matching the layout given to Init()
+         * \param indices Triangle indices relative to the first vertex of this mesh
+         * \return Location of the mesh, pass it to Draw() and Remove()
+         *
+         * Throws std::runtime_error when there is no free range big enough.
+         */
+        [[nodiscard]] Mesh Add(std::span<const std::byte> vertices, std::span<const std::uint32_t> indices);
+
+        /**
+         * \brief Return the ranges of a mesh to the free lists, does nothing once the arena was shut down
+         */
+        void Remove(const Mesh& mesh);
+
+        /**
+         * \brief Bind the shared VAO and draw one mesh, the shader must already be in use
+         */
+        void Draw(const Mesh& mesh, GLenum primitive = GL_TRIANGLES) const;
+
+        [[nodiscard]] VertexArrayHandle GetVertexArray() const noexcept
+        {
+            return vao;
+        }
+
+    private:
+        struct Range
+        {
+            GLintptr   Offset = 0;
+            GLsizeiptr Size   = 0;
+        };
+
+        class FreeList
+        {
+        public:
+            void     Reset(GLsizeiptr capacity);
+            GLintptr Allocate(GLsizeiptr size, GLsizeiptr alignment); // -1 when nothing fits
+            void     Release(GLintptr offset, GLsizeiptr size);
+
+        private:
+            std::vector<Range> ranges{};
+        };
+
+        VertexArrayHandle vao          = 0;
+        BufferHandle      vertexBuffer = 0;
+        BufferHandle      indexBuffer  = 0;
+        GLsizei           vertexStride = 0;
+        FreeList          freeVertices{};
+        FreeList          freeIndices{};
+    };
+
+    /**
+     * \brief Arena shared by every mesh with this vertex layout
+     * \param layout Vertex format, arenas are told apart by their attributes and starting offset
+     * \return The arena, created with the default capacities on first use, main thread only
+     *
+     * The arena stays alive for the whole run, owners Add() their meshes in Init() and Remove() them
+     * in Shutdown(). Owners of different layouts each get their own arena, so buffers and VAOs are
+     * shared between all owners of one layout.
+     */
+    [[nodiscard]] GeometryArena& GetSharedGeometryArena(const BufferLayout& layout);
+
+    /**
+     * \brief Delete the buffers and VAOs of every shared arena, called by Engine::Stop() while the context exists
+     *
+     * The arenas themselves stay, the next GetSharedGeometryArena() creates their buffers again.
+     */
+    void ShutdownSharedGeometryArenas();
+}
@@ -0,0 +1,184 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "ProgramCache.hpp"
+
+#include "Engine/Engine.hpp"
+#include "Engine/Hash.hpp"
+#include "Engine/Logger.hpp"
+#include "Engine/MappedFile.hpp"
+#include "Engine/Path.hpp"
+#include "Environment.hpp"
+#include "GL.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+    namespace fs = std::filesystem;
+
+    constexpr std::array<char, 4> MAGIC   = { 'C', 'S', 'P', 'B' };
+    constexpr std::uint32_t       VERSION = 1;
+
+    struct Header
+    {
+        std::array<char, 4> Magic{};
+        std::uint32_t       Version = 0;
+        std::uint32_t       Format  = 0; // binaryFormat reported by glGetProgramBinary
+        std::uint32_t       Length  = 0; // bytes of binary following the header
+        std::uint64_t       Key     = 0;
+    };
+
+    static_assert(sizeof(Header) == 24);
+
+    [[maybe_unused]] fs::path entry_path(std::uint64_t key)
+    {
+        char name[32];
+        std::snprintf(name, sizeof(name), "%016llx.program", static_cast<unsigned long long>(key));
+        return assets::get_cache_path() / name;
+    }
+
+#if !defined(IS_WEBGL2)
+    // a driver update can drop formats, glProgramBinary with an unknown one is an error rather than a failed link
+    bool is_format_supported(GLenum format)
+    {
+        GLint format_count = 0;
+        GL::GetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &format_count);
+        std::vector<GLint> formats(static_cast<std::size_t>(std::max(format_count, 0)));
+        if (!formats.empty())
+        {
+            GL::GetIntegerv(GL_PROGRAM_BINARY_FORMATS, formats.data());
+        }
+        return std::find(formats.begin(), formats.end(), static_cast<GLint>(format)) != formats.end();
+    }
+#endif
+}
+
+namespace OpenGL
+{
+    std::uint64_t hash_program_sources(std::string_view vertex_source, std::string_view fragment_source) noexcept
+    {
+        // the stage lengths go in too, so moving text from one stage to the other changes the key
+        const std::string lengths = std::to_string(vertex_source.size()) + ':' + std::to_string(fragment_source.size());
+        return util::hash_bytes(fragment_source, util::hash_bytes(vertex_source, util::hash_bytes(lengths, DriverHash)));
+    }
+
+    ShaderHandle load_cached_program(std::uint64_t key)
+    {
+#if defined(IS_WEBGL2)
+        // WebGL has no program binaries
+        static_cast<void>(key);
+        return 0;
+#else
+        if (!HasProgramBinary)
+        {
+            return 0;
+        }
+
+        const fs::path   path = entry_path(key);
+        util::MappedFile file;
+        if (!file.Open(path))
+        {
+            return 0;
+        }
+        const auto bytes = file.GetBytes();
+        if (bytes.size() < sizeof(Header))
+        {
+            return 0;
+        }
+        Header header;
+        std::memcpy(&header, bytes.data(), sizeof(Header));
+        if (header.Magic != MAGIC || header.Version != VERSION || header.Key != key || bytes.size() != sizeof(Header) + header.Length || !is_format_supported(header.Format))
+        {
+            return 0;
+        }
+
+        const ShaderHandle program = GL::CreateProgram();
+        GL::ProgramBinary(program, header.Format, bytes.data() + sizeof(Header), static_cast<GLsizei>(header.Length));
+        GLint is_linked = 0;
+        GL::GetProgramiv(program, GL_LINK_STATUS, &is_linked);
+        if (is_linked == GL_FALSE)
+        {
+            GL::DeleteProgram(program);
+            file.Close();
+            std::error_code ignored;
+            fs::remove(path, ignored);
+            Engine::GetLogger().LogEvent("Driver rejected cached program " + path.filename().string() + ", compiling it again");
+            return 0;
+        }
+        return program;
+#endif
+    }
+
+    void store_cached_program(std::uint64_t key, ShaderHandle program) noexcept
+    {
+#if defined(IS_WEBGL2)
+        static_cast<void>(key);
+        static_cast<void>(program);
+#else
+        if (!HasProgramBinary || program == 0)
+        {
+            return;
+        }
+        try
+        {
+            GLint length = 0;
+            GL::GetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+            if (length <= 0)
+            {
+                return;
+            }
+            std::vector<char> binary(static_cast<std::size_t>(length));
+            GLenum            format  = 0;
+            GLsizei           written = 0;
+            GL::GetProgramBinary(program, length, &written, &format, binary.data());
+
+            Header header;
+            header.Magic   = MAGIC;
+            header.Version = VERSION;
+            header.Format  = format;
+            header.Length  = static_cast<std::uint32_t>(written);
+            header.Key     = key;
+
+            // written to a temporary file and renamed, another running copy never maps half an entry. The
+            // random part keeps two copies storing the same program from writing into one temporary
+            const fs::path final_path = entry_path(key);
+            fs::path       temporary  = final_path;
+            temporary += "." + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()) ^ std::random_device{}()) + ".tmp";
+            {
+                std::ofstream out(temporary, std::ios::binary | std::ios::trunc);
+                out.write(reinterpret_cast<const char*>(&header), sizeof(Header));
+                out.write(binary.data(), written);
+                if (!out)
+                {
+                    out.close();
+                    fs::remove(temporary);
+                    return;
+                }
+            }
+            std::error_code error;
+            fs::rename(temporary, final_path, error);
+            if (error)
+            {
+                fs::remove(temporary, error);
+            }
+        }
+        catch (const std::exception&)
+        {
+            // a missing cache entry only costs a compile
+        }
+#endif
+    }
+}
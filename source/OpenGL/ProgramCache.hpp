@@ -0,0 +1,43 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Shader.hpp"
+#include <cstdint>
+#include <string_view>
+
+namespace OpenGL
+{
+    /**
+     * \brief Cache key of a program built from these stage sources on the current driver
+     * \param vertex_source Vertex shader text exactly as it is given to the compiler, preamble included
+     * \param fragment_source Fragment shader text exactly as it is given to the compiler
+     */
+    [[nodiscard]] std::uint64_t hash_program_sources(std::string_view vertex_source, std::string_view fragment_source) noexcept;
+
+    /**
+     * \brief Create a linked program from its cached binary
+     * \param key Value of hash_program_sources()
+     * \return The program, or 0 when nothing is cached or the driver rejected the binary
+     *
+     * Cache files live in assets::get_cache_path(), one per key, holding the glGetProgramBinary()
+     * output and its format. A binary the driver refuses, after an update that kept the version
+     * string for example, is deleted so the next run does not try it again. Always 0 without
+     * OpenGL::HasProgramBinary, the caller then compiles and links as usual.
+     */
+    [[nodiscard]] ShaderHandle load_cached_program(std::uint64_t key);
+
+    /**
+     * \brief Write the binary of a freshly linked program to the cache
+     * \param key Value of hash_program_sources()
+     * \param program Program linked with GL_PROGRAM_BINARY_RETRIEVABLE_HINT set
+     *
+     * Failures are ignored, the program is simply compiled again next time.
+     */
+    void store_cached_program(std::uint64_t key, ShaderHandle program) noexcept;
+}
@@ -8,50 +8,433 @@
 #include "Shader.hpp"
 
 #include "Engine/Engine.hpp"
+#include "Engine/FileWatcher.hpp"
 #include "Engine/Logger.hpp"
 #include "Engine/Path.hpp"
+#include "Environment.hpp"
 #include "GL.hpp"
+#include "ProgramCache.hpp"
 #include <algorithm>
 
 namespace
 {
     void                                                 print_glsl_text(std::string_view source);
-    [[nodiscard]] OpenGL::Handle                         compile_shader_source(GLenum type, std::string_view glsl_text);
-    [[nodiscard]] OpenGL::Handle                         compile_shader_file(GLenum type, const std::filesystem::path& file_path);
-    [[nodiscard]] OpenGL::ShaderHandle                   link_shader_program(OpenGL::Handle vertex_handle, OpenGL::Handle fragment_handle);
-    [[nodiscard]] std::unordered_map<std::string, GLint> get_uniform_locations(OpenGL::ShaderHandle shader);
+    [[nodiscard]] OpenGL::Handle                         submit_shader_stage(GLenum type, std::string_view glsl_text);
+    [[nodiscard]] std::string                            shader_stage_error(OpenGL::Handle shader);
+    [[nodiscard]] std::string                            program_link_error(OpenGL::ShaderHandle program);
+    [[nodiscard]] std::string                            read_shader_file(const std::filesystem::path& file_path, std::string_view preamble = {});
+    void                                                 insert_preamble(std::string& glsl_text, std::string_view preamble);
+    void                                                 take_feature_pragmas(std::string& glsl_text, std::vector<std::string>& features);
+    [[nodiscard]] OpenGL::PendingShader                  start_shader_program(std::string vertex_text, std::string fragment_text);
+    void                                                 discard_pending(OpenGL::PendingShader& pending) noexcept;
+    [[nodiscard]] std::vector<std::pair<std::uint32_t, GLint>> get_uniform_locations(OpenGL::ShaderHandle shader);
+
+    struct WatchedShader
+    {
+        OpenGL::CompiledShader*                   Target = nullptr;
+        std::filesystem::path                     VertexPath{};
+        std::filesystem::path                     FragmentPath{};
+        std::string                               Preamble{};
+        OpenGL::ShaderReloadCallback              OnReload{};
+        std::array<util::FileWatcher::WatchId, 2> Watches{};
+        OpenGL::PendingShader                     Rebuild{}; // Program is 0 while no rebuild is in flight
+    };
+
+    // entries stay at their address, the watch callbacks point at them
+    std::vector<std::unique_ptr<WatchedShader>> watched_shaders;
+
+    void start_rebuild(WatchedShader& watched);
 }
 
 namespace OpenGL
 {
     CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath)
     {
-        const auto     vertex_handle   = compile_shader_file(GL_VERTEX_SHADER, vertex_filepath);
-        const auto     fragment_handle = compile_shader_file(GL_FRAGMENT_SHADER, fragment_filepath);
-        CompiledShader cs{};
-        cs.Shader           = link_shader_program(vertex_handle, fragment_handle);
-        cs.UniformLocations = get_uniform_locations(cs.Shader);
-        return cs;
+        return CreateShaderAsync(std::move(vertex_filepath), std::move(fragment_filepath)).Get();
     }
 
     CompiledShader CreateShader(std::string_view vertex_source, std::string_view fragment_source)
     {
-        const auto     vertex_handle   = compile_shader_source(GL_VERTEX_SHADER, vertex_source);
-        const auto     fragment_handle = compile_shader_source(GL_FRAGMENT_SHADER, fragment_source);
+        return CreateShaderAsync(vertex_source, fragment_source).Get();
+    }
+
+    CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, std::string_view preamble)
+    {
+        return CreateShaderAsync(std::move(vertex_filepath), std::move(fragment_filepath), preamble).Get();
+    }
+
+    PendingShader CreateShaderAsync(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath)
+    {
+        return start_shader_program(read_shader_file(vertex_filepath), read_shader_file(fragment_filepath));
+    }
+
+    PendingShader CreateShaderAsync(std::string_view vertex_source, std::string_view fragment_source)
+    {
+        return start_shader_program(std::string(vertex_source), std::string(fragment_source));
+    }
+
+    PendingShader CreateShaderAsync(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, std::string_view preamble)
+    {
+        return start_shader_program(read_shader_file(vertex_filepath, preamble), read_shader_file(fragment_filepath, preamble));
+    }
+
+    bool PendingShader::IsReady() const noexcept
+    {
+        if (Program == 0 || Vertex == 0 || !HasParallelShaderCompile)
+        {
+            return true;
+        }
+        // the link was issued right after the compiles, so the program finishing means everything did
+        GLint completed = GL_FALSE;
+        GL::GetProgramiv(Program, GL_COMPLETION_STATUS_KHR, &completed);
+        return completed == GL_TRUE;
+    }
+
+    CompiledShader PendingShader::Get()
+    {
+        const ShaderHandle program       = std::exchange(Program, 0);
+        const Handle       vertex        = std::exchange(Vertex, 0);
+        const Handle       fragment      = std::exchange(Fragment, 0);
+        const std::string  vertex_text   = std::move(VertexText);
+        const std::string  fragment_text = std::move(FragmentText);
+
+        // 0 stages mean the program came from the binary cache, it is already linked
+        if (vertex != 0)
+        {
+            // these queries are what waits for the driver, IsReady() tells whether they would
+            std::string error = shader_stage_error(vertex);
+            if (!error.empty())
+            {
+                print_glsl_text(vertex_text);
+            }
+            else if (error = shader_stage_error(fragment); !error.empty())
+            {
+                print_glsl_text(fragment_text);
+            }
+            if (error.empty())
+            {
+                error = program_link_error(program);
+            }
+
+            GL::DeleteShader(vertex);
+            GL::DeleteShader(fragment);
+            if (!error.empty())
+            {
+                GL::DeleteProgram(program);
+                Engine::GetLogger().LogError(error);
+                throw std::runtime_error(error);
+            }
+            store_cached_program(CacheKey, program);
+        }
+
         CompiledShader cs{};
-        cs.Shader           = link_shader_program(vertex_handle, fragment_handle);
-        cs.UniformLocations = get_uniform_locations(cs.Shader);
+        cs.Shader = program;
+        try
+        {
+            cs.UniformLocations = get_uniform_locations(cs.Shader);
+        }
+        catch (const std::exception& e)
+        {
+            // the program linked, nobody else holds its handle
+            GL::DeleteProgram(program);
+            Engine::GetLogger().LogError(e.what());
+            throw;
+        }
         return cs;
     }
 
     void DestroyShader(CompiledShader& shader) noexcept
     {
+        UnwatchShader(shader);
         GL::DeleteProgram(shader.Shader);
         shader.Shader = 0;
 
         shader.UniformLocations.clear();
     }
 
+    ShaderVariants::ShaderVariants(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath)
+        : vertexPath(std::move(vertex_filepath)), fragmentPath(std::move(fragment_filepath)), vertexText(read_shader_file(vertexPath)), fragmentText(read_shader_file(fragmentPath))
+    {
+        take_feature_pragmas(vertexText, features);
+        take_feature_pragmas(fragmentText, features);
+        if (features.size() > MaxFeatures)
+        {
+            const std::string error = fragmentPath.string() + " declares " + std::to_string(features.size()) + " shader features, at most " + std::to_string(MaxFeatures) + " fit a FeatureMask";
+            Engine::GetLogger().LogError(error);
+            throw std::runtime_error(error);
+        }
+
+        util::FileWatcher& watcher = Engine::GetFileWatcher();
+        if (watcher.IsEnabled() && !assets::find_packed(vertexPath) && !assets::find_packed(fragmentPath))
+        {
+            // the callbacks only raise a flag, Get() on the main thread does the GL work
+            sourcesChanged       = std::make_shared<bool>(false);
+            const auto on_change = [changed = sourcesChanged](const std::filesystem::path&) { *changed = true; };
+            watches              = { watcher.Watch(assets::locate_asset(vertexPath), on_change), watcher.Watch(assets::locate_asset(fragmentPath), on_change) };
+        }
+    }
+
+    ShaderVariants::ShaderVariants(ShaderVariants&& other) noexcept
+        : vertexPath(std::move(other.vertexPath)), fragmentPath(std::move(other.fragmentPath)), vertexText(std::move(other.vertexText)), fragmentText(std::move(other.fragmentText)),
+          features(std::move(other.features)), variants(std::move(other.variants)), watches(std::exchange(other.watches, {})), sourcesChanged(std::move(other.sourcesChanged))
+    {
+    }
+
+    ShaderVariants& ShaderVariants::operator=(ShaderVariants&& other) noexcept
+    {
+        if (this != &other)
+        {
+            Destroy();
+            vertexPath     = std::move(other.vertexPath);
+            fragmentPath   = std::move(other.fragmentPath);
+            vertexText     = std::move(other.vertexText);
+            fragmentText   = std::move(other.fragmentText);
+            features       = std::move(other.features);
+            variants       = std::move(other.variants);
+            watches        = std::exchange(other.watches, {}); // other's Destroy() must not unwatch them
+            sourcesChanged = std::move(other.sourcesChanged);
+            other.variants.clear();
+        }
+        return *this;
+    }
+
+    ShaderVariants::FeatureMask ShaderVariants::GetFeatureBit(std::string_view keyword) const
+    {
+        const auto found = std::find(features.begin(), features.end(), keyword);
+        if (found == features.end())
+        {
+            Engine::GetLogger().LogError("Shader feature '" + std::string(keyword) + "' is not declared by a #pragma shader_feature line");
+            return 0;
+        }
+        return FeatureMask{ 1 } << static_cast<unsigned>(found - features.begin());
+    }
+
+    void ShaderVariants::Prepare(FeatureMask features_to_enable)
+    {
+        static_cast<void>(start(features_to_enable));
+    }
+
+    const CompiledShader& ShaderVariants::Get(FeatureMask features_to_enable)
+    {
+        if (sourcesChanged && *sourcesChanged)
+        {
+            *sourcesChanged = false;
+            reloadSources();
+        }
+        Variant& variant = start(features_to_enable);
+        if (variant.Pending.Program != 0 && variant.Compiled.Shader != 0)
+        {
+            // a rebuild after an edit, keep drawing with the old program until the driver is done
+            if (variant.Pending.IsReady())
+            {
+                try
+                {
+                    CompiledShader rebuilt = variant.Pending.Get();
+                    DestroyShader(variant.Compiled);
+                    variant.Compiled = std::move(rebuilt);
+                    Engine::GetLogger().LogEvent("Reloaded shader variant " + std::to_string(features_to_enable) + " of " + fragmentPath.filename().string());
+                }
+                catch (const std::exception&)
+                {
+                    Engine::GetLogger().LogEvent("Keeping the previous program of variant " + std::to_string(features_to_enable));
+                }
+            }
+        }
+        else if (variant.Pending.Program != 0)
+        {
+            try
+            {
+                variant.Compiled = variant.Pending.Get();
+            }
+            catch (...)
+            {
+                // Get() already deleted the program, asking again compiles and reports the error again
+                variants.erase(features_to_enable);
+                throw;
+            }
+        }
+        return variant.Compiled;
+    }
+
+    void ShaderVariants::Destroy() noexcept
+    {
+        for (auto& [mask, variant] : variants)
+        {
+            // a variant that was prepared but never drawn still owns its unchecked program and stages
+            discard_pending(variant.Pending);
+            DestroyShader(variant.Compiled);
+        }
+        variants.clear();
+        for (std::uint32_t& id : watches)
+        {
+            Engine::GetFileWatcher().Unwatch(std::exchange(id, 0));
+        }
+        sourcesChanged.reset();
+    }
+
+    ShaderVariants::Variant& ShaderVariants::start(FeatureMask features_to_enable)
+    {
+        const auto [found, inserted] = variants.try_emplace(features_to_enable);
+        if (!inserted)
+        {
+            return found->second;
+        }
+
+        try
+        {
+            found->second.Pending = start_shader_program(variantText(vertexText, features_to_enable), variantText(fragmentText, features_to_enable));
+        }
+        catch (...)
+        {
+            variants.erase(found);
+            throw;
+        }
+        return found->second;
+    }
+
+    void ShaderVariants::reloadSources()
+    {
+        std::string              vertex_text;
+        std::string              fragment_text;
+        std::vector<std::string> reloaded_features;
+        try
+        {
+            vertex_text   = read_shader_file(vertexPath);
+            fragment_text = read_shader_file(fragmentPath);
+        }
+        catch (const std::exception&)
+        {
+            return; // read_shader_file() logged it, most likely the editor has not finished writing
+        }
+        take_feature_pragmas(vertex_text, reloaded_features);
+        take_feature_pragmas(fragment_text, reloaded_features);
+        if (reloaded_features != features)
+        {
+            Engine::GetLogger().LogError("Shader features of " + fragmentPath.string() + " changed, restart to use them");
+            return;
+        }
+        vertexText   = std::move(vertex_text);
+        fragmentText = std::move(fragment_text);
+
+        // only the variants in use are rebuilt, all of them at once so the driver can compile them in parallel
+        for (auto& [mask, variant] : variants)
+        {
+            discard_pending(variant.Pending);
+            try
+            {
+                variant.Pending = start_shader_program(variantText(vertexText, mask), variantText(fragmentText, mask));
+            }
+            catch (const std::exception& e)
+            {
+                Engine::GetLogger().LogError(e.what());
+            }
+        }
+    }
+
+    std::string ShaderVariants::variantText(const std::string& glsl_text, FeatureMask features_to_enable) const
+    {
+        std::string defines;
+        for (std::size_t bit = 0; bit < features.size(); ++bit)
+        {
+            if ((features_to_enable >> bit) & 1u)
+            {
+                defines += "#define " + features[bit] + " 1\n";
+            }
+        }
+        std::string text = glsl_text;
+        insert_preamble(text, defines);
+        return text;
+    }
+
+    void WatchShader(CompiledShader& shader, std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, std::string preamble, ShaderReloadCallback on_reload)
+    {
+        util::FileWatcher& watcher = Engine::GetFileWatcher();
+        // sources read from Assets.pak cannot change while the program runs
+        if (!watcher.IsEnabled() || assets::find_packed(vertex_filepath) || assets::find_packed(fragment_filepath))
+        {
+            return;
+        }
+        auto watched          = std::make_unique<WatchedShader>();
+        watched->Target       = &shader;
+        watched->VertexPath   = std::move(vertex_filepath);
+        watched->FragmentPath = std::move(fragment_filepath);
+        watched->Preamble     = std::move(preamble);
+        watched->OnReload     = std::move(on_reload);
+
+        std::filesystem::path vertex_file;
+        std::filesystem::path fragment_file;
+        try
+        {
+            vertex_file   = assets::locate_asset(watched->VertexPath);
+            fragment_file = assets::locate_asset(watched->FragmentPath);
+        }
+        catch (const std::exception& e)
+        {
+            Engine::GetLogger().LogError("Cannot watch shader: " + std::string(e.what()));
+            return;
+        }
+        WatchedShader& entry     = *watched;
+        const auto     on_change = [&entry](const std::filesystem::path&) { start_rebuild(entry); };
+        watched->Watches         = { watcher.Watch(vertex_file, on_change), watcher.Watch(fragment_file, on_change) };
+        watched_shaders.push_back(std::move(watched));
+    }
+
+    void UnwatchShader(CompiledShader& shader) noexcept
+    {
+        if (const auto watched = std::find_if(watched_shaders.begin(), watched_shaders.end(), [&](const auto& entry) { return entry->Target == &shader; });
+            watched != watched_shaders.end())
+        {
+            for (const util::FileWatcher::WatchId id : (*watched)->Watches)
+            {
+                Engine::GetFileWatcher().Unwatch(id);
+            }
+            discard_pending((*watched)->Rebuild);
+            watched_shaders.erase(watched);
+        }
+    }
+
+    void UpdateShaderReloads()
+    {
+        // indexed, an on_reload callback may watch another shader
+        for (std::size_t i = 0; i < watched_shaders.size(); ++i)
+        {
+            WatchedShader* const watched = watched_shaders[i].get();
+            PendingShader&       rebuild = watched->Rebuild;
+            if (rebuild.Program == 0 || !rebuild.IsReady())
+            {
+                continue;
+            }
+            const std::string name = watched->VertexPath.filename().string() + "/" + watched->FragmentPath.filename().string();
+            try
+            {
+                CompiledShader rebuilt = rebuild.Get();
+                GL::DeleteProgram(watched->Target->Shader);
+                *watched->Target = std::move(rebuilt);
+                Engine::GetLogger().LogEvent("Reloaded shader " + name);
+                if (watched->OnReload)
+                {
+                    watched->OnReload(*watched->Target);
+                }
+            }
+            catch (const std::exception&)
+            {
+                // Get() logged the compiler output
+                Engine::GetLogger().LogEvent("Keeping the previous program of " + name);
+            }
+        }
+    }
+
+    GLint CompiledShader::GetUniformLocation(UniformName name) const noexcept
+    {
+        const auto found = std::lower_bound(UniformLocations.begin(), UniformLocations.end(), name.Hash, [](const auto& entry, std::uint32_t hash) { return entry.first < hash; });
+        return found != UniformLocations.end() && found->first == name.Hash ? found->second : -1;
+    }
+
+    void LogMissingUniform(const CompiledShader& shader, std::string_view uniform_name)
+    {
+        Engine::GetLogger().LogEvent("Uniform '" + std::string(uniform_name) + "' is not active in shader " + std::to_string(shader.Shader));
+    }
+
     void BindUniformBufferToShader(ShaderHandle shader_handle, GLuint binding_number, Handle uniform_bufer, std::string_view uniform_block_name)
     {
         const auto block_index = GL::GetUniformBlockIndex(shader_handle, uniform_block_name.data());
@@ -65,6 +448,19 @@ namespace OpenGL
             Engine::GetLogger().LogError("Uniform block '" + std::string(uniform_block_name) + "' not found in shader.");
         }
     }
+
+    void SetUniformBlockBinding(ShaderHandle shader_handle, GLuint binding_number, std::string_view uniform_block_name)
+    {
+        const auto block_index = GL::GetUniformBlockIndex(shader_handle, uniform_block_name.data());
+        if (block_index != GL_INVALID_INDEX)
+        {
+            GL::UniformBlockBinding(shader_handle, block_index, binding_number);
+        }
+        else
+        {
+            Engine::GetLogger().LogError("Uniform block '" + std::string(uniform_block_name) + "' not found in shader.");
+        }
+    }
 }
 
 namespace
@@ -86,80 +482,183 @@ namespace
         Engine::GetLogger().LogVerbose(sout.str());
     }
 
-    OpenGL::Handle compile_shader_source(GLenum type, std::string_view glsl_text)
+    // no status query here, with KHR_parallel_shader_compile the driver keeps compiling in the background
+    OpenGL::Handle submit_shader_stage(GLenum type, std::string_view glsl_text)
     {
         OpenGL::Handle shader = GL::CreateShader(type);
         GLchar const*  source[]{ glsl_text.data() };
         GL::ShaderSource(shader, 1, source, nullptr);
         GL::CompileShader(shader);
+        return shader;
+    }
+
+    std::string shader_stage_error(OpenGL::Handle shader)
+    {
         GLint is_compiled = 0;
         GL::GetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
-        if (is_compiled == GL_FALSE)
-        {
-            GLint log_length = 0;
-            GL::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
-            std::string error_log;
-            error_log.resize(static_cast<std::string::size_type>(log_length) + 1);
-            GL::GetShaderInfoLog(shader, log_length, nullptr, error_log.data());
-            GL::DeleteShader(shader);
-            shader = 0;
-            Engine::GetLogger().LogError(error_log);
-            print_glsl_text(glsl_text);
-            throw std::runtime_error(error_log);
+        if (is_compiled != GL_FALSE)
+        {
+            return {};
         }
-        return shader;
+        GLint log_length = 0;
+        GL::GetShaderiv(shader, GL_INFO_LOG_LENGTH, &log_length);
+        std::string error_log;
+        error_log.resize(static_cast<std::string::size_type>(log_length) + 1);
+        GL::GetShaderInfoLog(shader, log_length, nullptr, error_log.data());
+        return error_log;
+    }
+
+    std::string program_link_error(OpenGL::ShaderHandle program)
+    {
+        GLint is_linked = 0;
+        GL::GetProgramiv(program, GL_LINK_STATUS, &is_linked);
+        if (is_linked != GL_FALSE)
+        {
+            return {};
+        }
+        GLint log_length = 0;
+        GL::GetProgramiv(program, GL_INFO_LOG_LENGTH, &log_length);
+        std::string error;
+        error.resize(static_cast<unsigned>(log_length) + 1);
+        GL::GetProgramInfoLog(program, log_length, nullptr, error.data());
+        return error;
     }
 
-    OpenGL::Handle compile_shader_file(GLenum type, const std::filesystem::path& file_path)
+    std::string read_shader_file(const std::filesystem::path& file_path, std::string_view preamble)
     {
+        if (const auto packed = assets::find_packed(file_path))
+        {
+            // still copied, the preamble and the feature defines are inserted into the text
+            std::string glsl_text(reinterpret_cast<const char*>(packed->data()), packed->size());
+            insert_preamble(glsl_text, preamble);
+            return glsl_text;
+        }
         const auto    shader_file_path = assets::locate_asset(file_path);
         std::ifstream ifs(shader_file_path, std::ios::in);
         if (!ifs)
         {
             Engine::GetLogger().LogError("Cannot open " + file_path.string());
-            return 0;
+            throw std::runtime_error("Cannot open " + file_path.string());
         }
         std::string glsl_text;
         glsl_text.reserve(gsl::narrow<std::size_t>(std::filesystem::file_size(shader_file_path)));
         std::copy((std::istreambuf_iterator<char>(ifs)), std::istreambuf_iterator<char>(), std::back_insert_iterator(glsl_text));
-        return compile_shader_source(type, std::string_view(glsl_text));
+        insert_preamble(glsl_text, preamble);
+        return glsl_text;
     }
 
-    OpenGL::ShaderHandle link_shader_program(OpenGL::Handle vertex_handle, OpenGL::Handle fragment_handle)
+    void insert_preamble(std::string& glsl_text, std::string_view preamble)
     {
-        OpenGL::ShaderHandle program_handle = GL::CreateProgram();
-        if (program_handle == 0)
+        if (preamble.empty())
+        {
+            return;
+        }
+        // #version has to stay the very first line, so the preamble goes right after it
+        std::size_t insert_at    = 0;
+        const auto  version_line = glsl_text.find("#version");
+        if (version_line != std::string::npos)
+        {
+            const auto end_of_line = glsl_text.find('\n', version_line);
+            insert_at              = end_of_line == std::string::npos ? glsl_text.size() : end_of_line + 1;
+        }
+        if (insert_at == glsl_text.size() && !glsl_text.empty() && glsl_text.back() != '\n')
+        {
+            glsl_text.push_back('\n');
+            ++insert_at;
+        }
+        glsl_text.insert(insert_at, std::string(preamble) + "\n");
+    }
+
+    // collects the keywords of every "#pragma shader_feature A B ..." line and blanks the line, the newline stays
+    // so compiler messages keep their line numbers
+    void take_feature_pragmas(std::string& glsl_text, std::vector<std::string>& features)
+    {
+        constexpr std::string_view directive = "shader_feature";
+        for (std::size_t line_start = 0; line_start < glsl_text.size();)
+        {
+            const std::size_t newline  = glsl_text.find('\n', line_start);
+            const std::size_t line_end = newline == std::string::npos ? glsl_text.size() : newline;
+
+            std::istringstream words(glsl_text.substr(line_start, line_end - line_start));
+            std::string        word;
+            if (words >> word && word == "#pragma" && words >> word && word == directive)
+            {
+                while (words >> word)
+                {
+                    if (std::find(features.begin(), features.end(), word) == features.end())
+                    {
+                        features.push_back(word);
+                    }
+                }
+                std::fill(glsl_text.begin() + static_cast<std::ptrdiff_t>(line_start), glsl_text.begin() + static_cast<std::ptrdiff_t>(line_end), ' ');
+            }
+            line_start = line_end + 1;
+        }
+    }
+
+    // a cached binary skips both compiles and the link, which dominate startup with many shader variants
+    OpenGL::PendingShader start_shader_program(std::string vertex_text, std::string fragment_text)
+    {
+        OpenGL::PendingShader pending{};
+        pending.CacheKey = OpenGL::hash_program_sources(vertex_text, fragment_text);
+        pending.Program  = OpenGL::load_cached_program(pending.CacheKey);
+        if (pending.Program != 0)
+        {
+            return pending;
+        }
+
+        pending.Program = GL::CreateProgram();
+        if (pending.Program == 0)
         {
             throw std::runtime_error("Unable to create program\n");
         }
+        pending.Vertex   = submit_shader_stage(GL_VERTEX_SHADER, vertex_text);
+        pending.Fragment = submit_shader_stage(GL_FRAGMENT_SHADER, fragment_text);
+        GL::AttachShader(pending.Program, pending.Vertex);
+        GL::AttachShader(pending.Program, pending.Fragment);
 
-        GL::AttachShader(program_handle, vertex_handle);
-        GL::AttachShader(program_handle, fragment_handle);
+#if !defined(IS_WEBGL2)
+        if (OpenGL::HasProgramBinary)
+        {
+            GL::ProgramParameteri(pending.Program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+        }
+#endif
+        // linking before the compiles are checked lets the driver queue both, a failed stage just fails the link
+        GL::LinkProgram(pending.Program);
 
-        GL::LinkProgram(program_handle);
+        pending.VertexText   = std::move(vertex_text);
+        pending.FragmentText = std::move(fragment_text);
+        return pending;
+    }
 
-        GL::DeleteShader(vertex_handle);
-        GL::DeleteShader(fragment_handle);
+    // for a program nobody will call Get() on, its status is never checked
+    void discard_pending(OpenGL::PendingShader& pending) noexcept
+    {
+        GL::DeleteShader(std::exchange(pending.Vertex, 0));
+        GL::DeleteShader(std::exchange(pending.Fragment, 0));
+        GL::DeleteProgram(std::exchange(pending.Program, 0));
+        pending.VertexText.clear();
+        pending.FragmentText.clear();
+    }
 
-        GLint is_linked = 0;
-        GL::GetProgramiv(program_handle, GL_LINK_STATUS, &is_linked);
-        if (is_linked == GL_FALSE)
-        {
-            GLint log_length = 0;
-            GL::GetProgramiv(program_handle, GL_INFO_LOG_LENGTH, &log_length);
-            std::string error;
-            error.resize(static_cast<unsigned>(log_length) + 1);
-            GL::GetProgramInfoLog(program_handle, log_length, nullptr, error.data());
-            Engine::GetLogger().LogError(error);
-            throw std::runtime_error(error);
+    void start_rebuild(WatchedShader& watched)
+    {
+        // a second save before the first rebuild finished replaces it
+        discard_pending(watched.Rebuild);
+        try
+        {
+            watched.Rebuild = start_shader_program(read_shader_file(watched.VertexPath, watched.Preamble), read_shader_file(watched.FragmentPath, watched.Preamble));
+        }
+        catch (const std::exception& e)
+        {
+            Engine::GetLogger().LogError("Cannot reload shader: " + std::string(e.what()));
         }
-        return program_handle;
     }
 
-    std::unordered_map<std::string, GLint> get_uniform_locations(OpenGL::ShaderHandle shader)
+    std::vector<std::pair<std::uint32_t, GLint>> get_uniform_locations(OpenGL::ShaderHandle shader)
     {
-        std::unordered_map<std::string, GLint> uniform_locations;
-        GLint                                  num_uniforms = 0;
+        std::vector<std::pair<std::uint32_t, GLint>> uniform_locations;
+        GLint                                        num_uniforms = 0;
         GL::GetProgramiv(shader, GL_ACTIVE_UNIFORMS, &num_uniforms);
         if (num_uniforms <= 0)
         {
@@ -181,10 +680,17 @@ namespace
             GLint location = GL::GetUniformLocation(shader, uniform_name.c_str());
             if (location != -1)
             {
-                uniform_locations[uniform_name] = location;
+                uniform_locations.emplace_back(OpenGL::hash_uniform_name(uniform_name), location);
             }
             uniform_name.resize(static_cast<std::size_t>(max_name_length));
         }
+
+        std::sort(uniform_locations.begin(), uniform_locations.end());
+        const auto collision = std::adjacent_find(uniform_locations.begin(), uniform_locations.end(), [](const auto& a, const auto& b) { return a.first == b.first; });
+        if (collision != uniform_locations.end())
+        {
+            throw std::runtime_error("Two uniforms of shader " + std::to_string(shader) + " have the same name hash, rename one of them");
+        }
         return uniform_locations;
     }
 }
@@ -8,24 +8,213 @@
 #pragma once
 
 #include "Handle.hpp"
+#include <array>
+#include <cstdint>
 #include <filesystem>
+#include <functional>
+#include <memory>
 #include <string>
 #include <string_view>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 namespace OpenGL
 {
     using ShaderHandle = Handle;
 
+    // 32 bit FNV-1a, used to look uniforms up without hashing strings at draw time
+    constexpr std::uint32_t hash_uniform_name(std::string_view name) noexcept
+    {
+        std::uint32_t hash = 2166136261u;
+        for (const char c : name)
+        {
+            hash ^= static_cast<std::uint8_t>(c);
+            hash *= 16777619u;
+        }
+        return hash;
+    }
+
+    // A uniform name hashed at compile time, e.g. shader.GetUniformLocation("uModel")
+    struct UniformName
+    {
+        std::uint32_t    Hash;
+        std::string_view Name;
+
+        consteval UniformName(const char* name) noexcept : Hash(hash_uniform_name(name)), Name(name)
+        {
+        }
+    };
+
     struct [[nodiscard]] CompiledShader
     {
-        ShaderHandle                           Shader;
-        std::unordered_map<std::string, GLint> UniformLocations;
+        ShaderHandle                                 Shader;
+        std::vector<std::pair<std::uint32_t, GLint>> UniformLocations; // (name hash, location) sorted by hash
+
+        // -1 when the uniform is not active, which GL::Uniform* calls silently ignore
+        [[nodiscard]] GLint GetUniformLocation(UniformName name) const noexcept;
+    };
+
+    // A program the driver may still be compiling and linking, see CreateShaderAsync()
+    struct [[nodiscard]] PendingShader
+    {
+        ShaderHandle  Program  = 0;
+        Handle        Vertex   = 0; // 0 for both stages when the program came from the binary cache
+        Handle        Fragment = 0;
+        std::uint64_t CacheKey = 0;
+        std::string   VertexText{}; // kept to print the source of a stage that failed to compile
+        std::string   FragmentText{};
+
+        // false while GL_KHR_parallel_shader_compile reports the program unfinished, without the extension
+        // there is no way to ask and it is always true, Get() may then wait
+        [[nodiscard]] bool IsReady() const noexcept;
+
+        // checks the compile and link status, throws std::runtime_error like CreateShader() on failure
+        CompiledShader Get();
     };
 
     CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath);
     CompiledShader CreateShader(std::string_view vertex_source, std::string_view fragment_source);
+    // preamble (e.g. "#define NAME value" lines) is inserted right after the #version line of both stages
+    CompiledShader CreateShader(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, std::string_view preamble);
+
+    // Issue the compiles and the link without asking for their status, so several programs build in parallel on
+    // drivers with GL_KHR_parallel_shader_compile. Start every program of a state's Load() first, do the CPU
+    // work like texture decoding, then call Get() on each before it is first used:
+    //   auto pending = OpenGL::CreateShaderAsync(path{ "a.vert" }, path{ "a.frag" });
+    //   ... load textures ...
+    //   shader = pending.Get();
+    // Every PendingShader must be finished with Get(), it owns GL objects until then.
+    PendingShader CreateShaderAsync(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath);
+    PendingShader CreateShaderAsync(std::string_view vertex_source, std::string_view fragment_source);
+    PendingShader CreateShaderAsync(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, std::string_view preamble);
+
+    // also stops WatchShader() from rebuilding it
     void           DestroyShader(CompiledShader& shader) noexcept;
     void           BindUniformBufferToShader(ShaderHandle shader_handle, GLuint binding_number, Handle uniform_bufer, std::string_view uniform_block_name);
+    // only points the block at binding_number, for shaders that read a uniform buffer owned by someone else
+    void           SetUniformBlockBinding(ShaderHandle shader_handle, GLuint binding_number, std::string_view uniform_block_name);
+
+    // Developer builds: rebuild shader whenever one of its files changes on disk, see Engine::GetFileWatcher().
+    // The new program builds in the background like CreateShaderAsync() and replaces shader in place once it
+    // linked, on_reload then runs so the owner can resolve uniforms and set block bindings again. A program that
+    // fails to build is logged and the old one stays in use. shader must stay at its address until DestroyShader().
+    using ShaderReloadCallback = std::function<void(const CompiledShader& shader)>;
+    void WatchShader(CompiledShader& shader, std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath, std::string preamble = {},
+                     ShaderReloadCallback on_reload = {});
+    // stop rebuilding shader and drop a rebuild in flight, the program itself stays; for owners moving a watched shader
+    void UnwatchShader(CompiledShader& shader) noexcept;
+    // swap in the rebuilt programs the driver finished, the engine calls it every frame
+    void UpdateShaderReloads();
+
+    // Resolve a fixed list of uniforms once after linking, so drawing only indexes an array:
+    //   enum QuadUniform : std::size_t { Model, Tint, QuadUniformCount };
+    //   constexpr std::array<OpenGL::UniformName, QuadUniformCount> names = { "uModel", "uTint" };
+    //   locations = OpenGL::ResolveUniforms(shader, names);  GL::Uniform4fv(locations[Tint], ...);
+    void LogMissingUniform(const CompiledShader& shader, std::string_view uniform_name);
+
+    template <std::size_t N>
+    [[nodiscard]] std::array<GLint, N> ResolveUniforms(const CompiledShader& shader, const std::array<UniformName, N>& names)
+    {
+        std::array<GLint, N> locations{};
+        for (std::size_t i = 0; i < N; ++i)
+        {
+            locations[i] = shader.GetUniformLocation(names[i]);
+            if (locations[i] == -1)
+            {
+                LogMissingUniform(shader, names[i].Name);
+            }
+        }
+        return locations;
+    }
+
+    /**
+     * \brief Every combination of a shader's compile time features, each built the first time it is asked for
+     *
+     * A stage source declares its feature keywords on a pragma line, up to MaxFeatures of them:
+     * \code
+     * #pragma shader_feature MODULATE_COLOR USE_IMAGE
+     * ...
+     * #if defined(USE_IMAGE)
+     *     color *= texture(uTex2d, vTextureCoordinates);
+     * #endif
+     * \endcode
+     * A variant is the program compiled with "#define KEYWORD 1" after #version for every bit set in
+     * its FeatureMask, so a disabled feature costs nothing per fragment instead of being multiplied
+     * away by a flag uniform. Keywords get their bits in declaration order, vertex stage first, and
+     * the pragma lines are blanked before compiling. Each variant has its own program binary cache
+     * entry, since its source text differs.
+     *
+     * Example Usage:
+     * \code
+     * variants = OpenGL::ShaderVariants(path{ "a.vert" }, path{ "a.frag" });
+     * const auto use_image = variants.GetFeatureBit("USE_IMAGE");
+     * variants.Prepare(use_image);                   // optional, starts the build early like CreateShaderAsync()
+     * ...
+     * GL::UseProgram(variants.Get(use_image).Shader); // finishes or builds the variant
+     * \endcode
+     *
+     * In developer builds the two files are watched: after an edit every variant built so far is
+     * rebuilt in the background and Get() keeps returning the old program until the new one linked,
+     * or for good when it fails to build. Uniform locations may differ afterwards, compare
+     * CompiledShader::Shader with the program they were resolved for. Adding or removing keywords
+     * needs a restart, their bits would move.
+     *
+     * Like CompiledShader the programs are not deleted by the destructor, call Destroy() while the
+     * context is still alive.
+     */
+    class ShaderVariants
+    {
+    public:
+        using FeatureMask = std::uint32_t;
+
+        static constexpr std::size_t MaxFeatures = 32;
+
+        ShaderVariants() = default;
+        // reads both files once and watches them, throws std::runtime_error when one is missing or declares too many features
+        ShaderVariants(std::filesystem::path vertex_filepath, std::filesystem::path fragment_filepath);
+
+        ShaderVariants(const ShaderVariants& other)            = delete;
+        ShaderVariants(ShaderVariants&& other) noexcept;
+        ShaderVariants& operator=(const ShaderVariants& other) = delete;
+        // destroys the programs and watches of this object first, the moved-from object keeps none of other's
+        ShaderVariants& operator=(ShaderVariants&& other) noexcept;
+
+        // bit of a declared keyword, 0 (and a logged error) for one the sources do not declare
+        [[nodiscard]] FeatureMask GetFeatureBit(std::string_view keyword) const;
+
+        // start building a variant without waiting for it, does nothing when it was already started
+        void Prepare(FeatureMask features_to_enable);
+
+        // the variant, compiled now when Prepare() was not called for it, throws like CreateShader() on errors
+        const CompiledShader& Get(FeatureMask features_to_enable);
+
+        [[nodiscard]] std::size_t GetVariantCount() const noexcept
+        {
+            return variants.size();
+        }
+
+        // delete every variant, finished or still pending, and stop watching the files
+        void Destroy() noexcept;
+
+    private:
+        struct Variant
+        {
+            PendingShader  Pending{};
+            CompiledShader Compiled{}; // still the previous program while a rebuild is pending
+        };
+
+        Variant&    start(FeatureMask features_to_enable);
+        void        reloadSources();
+        std::string variantText(const std::string& glsl_text, FeatureMask features_to_enable) const;
+
+        std::filesystem::path                    vertexPath{};
+        std::filesystem::path                    fragmentPath{};
+        std::string                              vertexText{};
+        std::string                              fragmentText{};
+        std::vector<std::string>                 features{};
+        std::unordered_map<FeatureMask, Variant> variants{};       // node based, references returned by Get() stay valid
+        std::array<std::uint32_t, 2>             watches{};        // util::FileWatcher IDs of both files
+        std::shared_ptr<bool>                    sourcesChanged{}; // set by the watch callbacks, shared so moves keep them valid
+    };
 }
@@ -0,0 +1,198 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "StreamBuffer.hpp"
+#include "Environment.hpp"
+#include "GL.hpp"
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <utility>
+
+namespace
+{
+    constexpr GLuint64 ONE_MILLISECOND_IN_NANOSECONDS = 1'000'000;
+}
+
+namespace OpenGL
+{
+    StreamBuffer::StreamBuffer(StreamBuffer&& other) noexcept
+        : type(other.type), buffer(other.buffer), mapped(other.mapped), regionSize(other.regionSize), region(other.region), head(other.head), fences(other.fences), statistics(other.statistics)
+    {
+        other.buffer     = 0;
+        other.mapped     = nullptr;
+        other.regionSize = 0;
+        other.fences     = {};
+    }
+
+    StreamBuffer& StreamBuffer::operator=(StreamBuffer&& other) noexcept
+    {
+        if (this != &other)
+        {
+            std::swap(type, other.type);
+            std::swap(buffer, other.buffer);
+            std::swap(mapped, other.mapped);
+            std::swap(regionSize, other.regionSize);
+            std::swap(region, other.region);
+            std::swap(head, other.head);
+            std::swap(fences, other.fences);
+            std::swap(statistics, other.statistics);
+        }
+        return *this;
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+        Shutdown();
+    }
+
+    void StreamBuffer::Init(BufferType buffer_type, GLsizeiptr bytes_per_frame)
+    {
+        Shutdown();
+        type       = buffer_type;
+        regionSize = bytes_per_frame;
+        region     = 0;
+        head       = 0;
+        statistics = {};
+
+        GL::GenBuffers(1, &buffer);
+        bind();
+        const auto target = static_cast<GLenum>(type);
+
+#if !defined(IS_WEBGL2)
+        if (HasBufferStorage)
+        {
+            const GLsizeiptr total_size = regionSize * static_cast<GLsizeiptr>(FramesInFlight);
+            const GLbitfield flags      = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            GL::BufferStorage(target, total_size, nullptr, flags);
+            mapped = static_cast<std::byte*>(GL::MapBufferRange(target, 0, total_size, flags));
+            if (mapped != nullptr)
+            {
+                return;
+            }
+
+            // immutable storage cannot be re-specified, start over with a mutable buffer
+            GL::DeleteBuffers(1, &buffer);
+            GL::GenBuffers(1, &buffer);
+            bind();
+        }
+#endif
+
+        GL::BufferData(target, regionSize, nullptr, GL_STREAM_DRAW);
+    }
+
+    void StreamBuffer::Shutdown()
+    {
+        for (GLsync& fence : fences)
+        {
+            if (fence != nullptr)
+            {
+                GL::DeleteSync(fence);
+                fence = nullptr;
+            }
+        }
+        if (mapped != nullptr)
+        {
+            bind();
+            GL::UnmapBuffer(static_cast<GLenum>(type));
+            mapped = nullptr;
+        }
+        if (buffer != 0)
+        {
+            GL::DeleteBuffers(1, &buffer);
+            buffer = 0;
+        }
+    }
+
+    GLintptr StreamBuffer::Upload(std::span<const std::byte> data, GLintptr alignment)
+    {
+        const auto size = static_cast<GLsizeiptr>(data.size_bytes());
+        if (size > regionSize)
+        {
+            throw std::runtime_error("StreamBuffer upload of " + std::to_string(size) + " bytes does not fit in a region of " + std::to_string(regionSize) + " bytes");
+        }
+
+        GLintptr offset = (head + alignment - 1) / alignment * alignment;
+        if (offset + size > regionSize)
+        {
+            nextRegion();
+            offset = 0;
+        }
+
+        const GLintptr buffer_offset = static_cast<GLintptr>(region) * regionSize + offset;
+        if (mapped != nullptr)
+        {
+            std::memcpy(mapped + buffer_offset, data.data(), data.size_bytes());
+        }
+        else
+        {
+            bind();
+            GL::BufferSubData(static_cast<GLenum>(type), buffer_offset, size, data.data());
+        }
+
+        head = offset + size;
+        ++statistics.Uploads;
+        return buffer_offset;
+    }
+
+    void StreamBuffer::EndFrame()
+    {
+        // an orphaned buffer only moves on once it is full, the driver tracks what the GPU still reads
+        if (mapped != nullptr && head != 0)
+        {
+            nextRegion();
+        }
+    }
+
+    void StreamBuffer::bind() const
+    {
+        // the element array binding belongs to the bound VAO, leave it alone
+        if (type == BufferType::Indices)
+        {
+            GL::BindVertexArray(0);
+        }
+        GL::BindBuffer(static_cast<GLenum>(type), buffer);
+    }
+
+    void StreamBuffer::nextRegion()
+    {
+        head = 0;
+        if (mapped == nullptr)
+        {
+            bind();
+            GL::BufferData(static_cast<GLenum>(type), regionSize, nullptr, GL_STREAM_DRAW);
+            ++statistics.Orphans;
+            return;
+        }
+
+        fences[region] = GL::FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        region         = (region + 1) % FramesInFlight;
+        waitForRegion(region);
+    }
+
+    void StreamBuffer::waitForRegion(unsigned region_index)
+    {
+        GLsync& fence = fences[region_index];
+        if (fence == nullptr)
+        {
+            return;
+        }
+
+        GLenum result = GL::ClientWaitSync(fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            ++statistics.Waits;
+            do
+            {
+                result = GL::ClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, ONE_MILLISECOND_IN_NANOSECONDS);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+
+        GL::DeleteSync(fence);
+        fence = nullptr;
+    }
+}
@@ -0,0 +1,136 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Buffer.hpp"
+#include "GLTypes.hpp"
+#include <array>
+#include <cstddef>
+#include <span>
+
+namespace OpenGL
+{
+    /**
+     * \brief Ring buffer for vertex data that is rewritten every frame
+     *
+     * Updating a GL_DYNAMIC_DRAW buffer in place with glBufferSubData makes the driver wait until the GPU
+     * has finished reading the previous frame's contents. StreamBuffer never writes over bytes that may
+     * still be in flight, every Upload() lands in a fresh part of a large buffer and returns its offset.
+     *
+     * Two strategies are used, picked once in Init():
+     * - Persistent mapping (GL 4.4 / GL_ARB_buffer_storage): immutable storage of FramesInFlight regions
+     *   mapped once with GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT. Upload() is a memcpy. Each region
+     *   is protected by a fence placed when the CPU leaves it, the fence is only waited on when the ring
+     *   wraps around to that region, by then the GPU has normally consumed it long ago.
+     * - Orphaning (GL 3.3, WebGL2): one region uploaded with glBufferSubData. When it is full the buffer
+     *   is re-specified with glBufferData(nullptr) so the driver hands out new memory while the GPU keeps
+     *   reading the old one.
+     *
+     * Because the data moves every upload, vertex attributes must be re-pointed with
+     * OpenGL::SetVertexBufferOffset() before drawing.
+     *
+     * Example Usage:
+     * \code
+     * stream.Init(OpenGL::BufferType::Vertices, 4 * 1024 * 1024);
+     * vao = OpenGL::CreateVertexArrayObject(OpenGL::VertexBuffer{ stream.GetHandle(), layout });
+     * ...
+     * const GLintptr offset = stream.Upload(std::as_bytes(std::span{ vertices }));
+     * OpenGL::SetVertexBufferOffset(vao, 0, OpenGL::VertexBuffer{ stream.GetHandle(), layout }, offset);
+     * GL::DrawArrays(GL_TRIANGLES, 0, vertex_count);
+     * ...
+     * stream.EndFrame();                                          // once per frame, after the last draw
+     * \endcode
+     */
+    class StreamBuffer
+    {
+    public:
+        /**
+         * \brief Number of regions of a persistent ring, frames the CPU may run ahead of the GPU
+         */
+        static constexpr unsigned FramesInFlight = 3;
+
+        /**
+         * \brief Alignment of every upload, enough for any vertex attribute type
+         */
+        static constexpr GLintptr DefaultAlignment = 16;
+
+        /**
+         * \brief Counters since Init(), a non-zero Waits means the regions are too small or the GPU is behind
+         */
+        struct Statistics
+        {
+            unsigned Uploads = 0;
+            unsigned Orphans = 0; ///< buffer re-specifications on the orphaning path
+            unsigned Waits   = 0; ///< fences that were not signaled yet when their region was reused
+        };
+
+        StreamBuffer() noexcept = default;
+
+        StreamBuffer(const StreamBuffer& other)            = delete;
+        StreamBuffer& operator=(const StreamBuffer& other) = delete;
+
+        StreamBuffer(StreamBuffer&& other) noexcept;
+        StreamBuffer& operator=(StreamBuffer&& other) noexcept;
+
+        ~StreamBuffer();
+
+        /**
+         * \brief Allocate the ring
+         * \param type Buffer target the data is used as
+         * \param bytes_per_frame Size of one region, the largest single upload must fit in it
+         */
+        void Init(BufferType type, GLsizeiptr bytes_per_frame);
+
+        /**
+         * \brief Unmap and delete the buffer and its fences, safe to call multiple times
+         */
+        void Shutdown();
+
+        /**
+         * \brief Copy data into the ring
+         * \param data Bytes to copy, at most the region size given to Init()
+         * \param alignment Alignment of the returned offset
+         * \return Byte offset of the copy inside GetHandle()
+         */
+        [[nodiscard]] GLintptr Upload(std::span<const std::byte> data, GLintptr alignment = DefaultAlignment);
+
+        /**
+         * \brief Fence the current region and move to the next one, call once per frame after the last draw
+         */
+        void EndFrame();
+
+        [[nodiscard]] BufferHandle GetHandle() const noexcept
+        {
+            return buffer;
+        }
+
+        [[nodiscard]] bool IsPersistent() const noexcept
+        {
+            return mapped != nullptr;
+        }
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        void bind() const;
+        void nextRegion();
+        void waitForRegion(unsigned region_index);
+
+        BufferType                         type       = BufferType::Vertices;
+        BufferHandle                       buffer     = 0;
+        std::byte*                         mapped     = nullptr;
+        GLsizeiptr                         regionSize = 0;
+        unsigned                           region     = 0;
+        GLintptr                           head       = 0; // offset inside the current region
+        std::array<GLsync, FramesInFlight> fences{};
+        Statistics                         statistics{};
+    };
+}
@@ -7,15 +7,132 @@
  * \copyright DigiPen Institute of Technology
  */
 #include "Texture.hpp"
+#include "CS200/CompressedImage.hpp"
 #include "CS200/Image.hpp"
+#include "CS200/Mipmap.hpp"
 #include "Engine/Logger.hpp"
 #include "Engine/Engine.hpp"
 #include "Environment.hpp"
 #include "GL.hpp"
+#include "TextureUploader.hpp"
+#include <algorithm>
+#include <bit>
+#include <vector>
 
 namespace OpenGL
 {
-    TextureHandle CreateTextureFromImage(const CS200::Image& image, Filtering filtering, Wrapping wrapping) noexcept
+    namespace
+    {
+        struct TextureState
+        {
+            AlphaContent Alpha     = AlphaContent::Unknown;
+            bool         Nearest   = true;
+            bool         Mipmapped = false; // every level the min filter can reach has been specified
+        };
+
+        // indexed by texture handle, entries are rewritten whenever a handle is handed out again
+        std::vector<TextureState> texture_state;
+
+        TextureState& state_entry(TextureHandle texture_handle)
+        {
+            if (texture_handle >= texture_state.size())
+            {
+                texture_state.resize(texture_handle + 1);
+            }
+            return texture_state[texture_handle];
+        }
+
+        // texels are uploaded as GL_RGBA / GL_UNSIGNED_BYTE, so alpha is the fourth byte in memory
+        constexpr unsigned texel_alpha(CS200::RGBA texel) noexcept
+        {
+            if constexpr (std::endian::native == std::endian::little)
+            {
+                return texel >> 24;
+            }
+            else
+            {
+                return texel & 0xff;
+            }
+        }
+
+        // GL_TEXTURE_MAG_FILTER only accepts GL_NEAREST and GL_LINEAR
+        constexpr GLint mag_filter(Filtering filtering) noexcept
+        {
+            switch (filtering)
+            {
+                case Filtering::NearestPixel:
+                case Filtering::NearestMipmapNearest:
+                case Filtering::NearestMipmapLinear: return GL_NEAREST;
+                default: return GL_LINEAR;
+            }
+        }
+
+        void apply_filtering(Filtering filtering) noexcept
+        {
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, mag_filter(filtering));
+        }
+
+        // defines a level of the texture, staging the texels through uploader when there is one
+        void specify_level(TextureHandle texture_handle, GLint level, Math::ivec2 size, std::span<const CS200::RGBA> colors, TextureUploader* uploader)
+        {
+            if (uploader == nullptr)
+            {
+                GL::TexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, colors.data());
+                return;
+            }
+            GL::TexImage2D(GL_TEXTURE_2D, level, GL_RGBA8, size.x, size.y, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+            uploader->Upload(texture_handle, level, Math::ivec2{ 0, 0 }, size, colors);
+        }
+
+        // uploads levels 1..n of the texture from a CS200::build_mip_chain() layout, level 0 is already there
+        void upload_mip_chain(TextureHandle texture_handle, Math::ivec2 size, std::span<const CS200::RGBA> chain, TextureUploader* uploader)
+        {
+            std::size_t offset = 0;
+            for (GLint level = 1; size.x > 1 || size.y > 1; ++level)
+            {
+                size              = CS200::next_mip_size(size);
+                const auto texels = chain.subspan(offset, static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y));
+                specify_level(texture_handle, level, size, texels, uploader);
+                offset += texels.size();
+            }
+        }
+
+        TextureHandle create_texture(
+            Math::ivec2 size, std::span<const CS200::RGBA> colors, std::span<const CS200::RGBA> mip_chain, Filtering filtering, Wrapping wrapping, TextureUploader* uploader) noexcept
+        {
+            TextureHandle textureHandle;
+            GL::GenTextures(1, &textureHandle);
+            GL::BindTexture(GL_TEXTURE_2D, textureHandle);
+
+            apply_filtering(filtering);
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapping));
+            GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrapping));
+
+            specify_level(textureHandle, 0, size, colors, uploader);
+
+            if (UsesMipmaps(filtering))
+            {
+                if (mip_chain.size() == CS200::mip_chain_texel_count(size))
+                {
+                    upload_mip_chain(textureHandle, size, mip_chain, uploader);
+                }
+                else
+                {
+                    // nobody built the chain ahead of time, filter level 1 straight from the caller's texels
+                    std::vector<CS200::RGBA> chain(CS200::mip_chain_texel_count(size));
+                    CS200::build_mip_chain(size, colors, chain);
+                    upload_mip_chain(textureHandle, size, chain, uploader);
+                }
+            }
+
+            state_entry(textureHandle) = TextureState{ ClassifyAlpha(colors), filtering == Filtering::NearestPixel, UsesMipmaps(filtering) };
+
+            return textureHandle;
+        }
+    }
+
+    TextureHandle CreateTextureFromImage(const CS200::Image& image, Filtering filtering, Wrapping wrapping, TextureUploader* uploader) noexcept
     {
         if (image.data() == nullptr)
         {
@@ -23,17 +140,21 @@ namespace OpenGL
             return 0;
         }
 
-        return CreateTextureFromMemory(image.GetSize(), std::span(image.data(), image.GetSize().x * image.GetSize().y), filtering, wrapping);
+        return create_texture(image.GetSize(), std::span(image.data(), static_cast<std::size_t>(image.GetSize().x) * static_cast<std::size_t>(image.GetSize().y)), image.GetMipChain(), filtering, wrapping, uploader);
+    }
+
+    TextureHandle CreateTextureFromMemory(Math::ivec2 size, std::span<const CS200::RGBA> colors, Filtering filtering, Wrapping wrapping, TextureUploader* uploader) noexcept
+    {
+        return create_texture(size, colors, {}, filtering, wrapping, uploader);
     }
 
-    TextureHandle CreateTextureFromMemory(Math::ivec2 size, std::span<const CS200::RGBA> colors, Filtering filtering, Wrapping wrapping) noexcept
+    TextureHandle CreateRGBATexture(Math::ivec2 size, Filtering filtering, Wrapping wrapping) noexcept
     {
         TextureHandle textureHandle;
         GL::GenTextures(1, &textureHandle);
         GL::BindTexture(GL_TEXTURE_2D, textureHandle);
 
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(filtering));
+        apply_filtering(filtering);
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapping));
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrapping));
 
@@ -42,45 +163,122 @@ namespace OpenGL
             0, // base_mipmap_level
             GL_RGBA8, size.x, size.y,
             0, // zero_border
-            GL_RGBA, GL_UNSIGNED_BYTE, colors.data());
+            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+
+        if (UsesMipmaps(filtering))
+        {
+            GL::GenerateMipmap(GL_TEXTURE_2D);
+        }
 
-        GL::BindTexture(GL_TEXTURE_2D, 0);
+        state_entry(textureHandle) = TextureState{ AlphaContent::Unknown, filtering == Filtering::NearestPixel, UsesMipmaps(filtering) };
 
         return textureHandle;
     }
 
-    TextureHandle CreateRGBATexture(Math::ivec2 size, Filtering filtering, Wrapping wrapping) noexcept
+    bool IsCompressedFormatSupported(GLenum internal_format, Math::ivec2 size) noexcept
     {
+        switch (internal_format)
+        {
+            case GL_COMPRESSED_RGB8_ETC2:
+            case GL_COMPRESSED_SRGB8_ETC2:
+            case GL_COMPRESSED_RGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            case GL_COMPRESSED_SRGB8_PUNCHTHROUGH_ALPHA1_ETC2:
+            case GL_COMPRESSED_RGBA8_ETC2_EAC:
+            case GL_COMPRESSED_SRGB8_ALPHA8_ETC2_EAC: return HasETC2;
+            case GL_COMPRESSED_RGB_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT1_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT3_EXT:
+            case GL_COMPRESSED_RGBA_S3TC_DXT5_EXT: return HasS3TC && (!IsWebGL || (size.x % 4 == 0 && size.y % 4 == 0));
+            case GL_COMPRESSED_RGBA_BPTC_UNORM:
+            case GL_COMPRESSED_SRGB_ALPHA_BPTC_UNORM: return HasBPTC;
+            default: return false;
+        }
+    }
+
+    TextureHandle CreateTextureFromCompressedImage(const CS200::CompressedImage& image, Filtering filtering, Wrapping wrapping) noexcept
+    {
+        const auto levels = image.GetLevels();
+        if (levels.empty())
+        {
+            Engine::GetLogger().LogError("No compressed image data !!");
+            return 0;
+        }
+
         TextureHandle textureHandle;
         GL::GenTextures(1, &textureHandle);
         GL::BindTexture(GL_TEXTURE_2D, textureHandle);
 
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, static_cast<GLint>(filtering));
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, static_cast<GLint>(filtering));
+        apply_filtering(filtering);
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, static_cast<GLint>(wrapping));
         GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, static_cast<GLint>(wrapping));
+        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels.size()) - 1);
 
-        GL::TexImage2D(
-            GL_TEXTURE_2D,
-            0, // base_mipmap_level
-            GL_RGBA8, size.x, size.y,
-            0, // zero_border
-            GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+        for (std::size_t level = 0; level < levels.size(); ++level)
+        {
+            const auto& [size, blocks] = levels[level];
+            GL::CompressedTexImage2D(GL_TEXTURE_2D, static_cast<GLint>(level), image.GetFormat(), size.x, size.y, 0, static_cast<GLsizei>(blocks.size_bytes()), blocks.data());
+        }
 
-        GL::BindTexture(GL_TEXTURE_2D, 0);
+        const bool has_alpha = image.GetFormat() != GL_COMPRESSED_RGB8_ETC2 && image.GetFormat() != GL_COMPRESSED_SRGB8_ETC2 && image.GetFormat() != GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+        // GL_TEXTURE_MAX_LEVEL limits sampling to the levels in the file, compressed formats cannot be mipmapped by the driver
+        state_entry(textureHandle) = TextureState{ has_alpha ? AlphaContent::Unknown : AlphaContent::Opaque, filtering == Filtering::NearestPixel, true };
 
         return textureHandle;
     }
 
+    void UpdateTextureRegion(TextureHandle texture_handle, Math::ivec2 offset, Math::ivec2 size, std::span<const CS200::RGBA> colors, TextureUploader* uploader) noexcept
+    {
+        if (uploader != nullptr)
+        {
+            uploader->Upload(texture_handle, 0, offset, size, colors);
+        }
+        else
+        {
+            GL::BindTexture(GL_TEXTURE_2D, texture_handle);
+            GL::TexSubImage2D(GL_TEXTURE_2D, 0, offset.x, offset.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, colors.data());
+        }
+
+        TextureState& state = state_entry(texture_handle);
+        if (state.Mipmapped)
+        {
+            // the rest of level 0 only lives on the GPU, so the smaller levels are rebuilt there
+            GL::GenerateMipmap(GL_TEXTURE_2D);
+        }
+
+        // Unknown < Cutout < Opaque, the texture is only as opaque as its least opaque part
+        const AlphaContent region = ClassifyAlpha(colors);
+        if (region == AlphaContent::Unknown || state.Alpha == AlphaContent::Unknown)
+        {
+            state.Alpha = AlphaContent::Unknown;
+        }
+        else if (region == AlphaContent::Cutout)
+        {
+            state.Alpha = AlphaContent::Cutout;
+        }
+    }
+
     void SetFiltering(TextureHandle texture_handle, Filtering filtering) noexcept
     {
         GL::BindTexture(GL_TEXTURE_2D, texture_handle);
-        auto filtering_ = static_cast<GLint>(filtering);
+        apply_filtering(filtering);
 
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filtering_);
-        GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filtering_);
+        TextureState& state = state_entry(texture_handle);
+        if (UsesMipmaps(filtering) && !state.Mipmapped)
+        {
+            GL::GenerateMipmap(GL_TEXTURE_2D);
+            state.Mipmapped = true;
+        }
+        state.Nearest = filtering == Filtering::NearestPixel;
+    }
 
-        GL::BindTexture(GL_TEXTURE_2D, 0);
+    void SetAnisotropy(TextureHandle texture_handle, float max_anisotropy) noexcept
+    {
+        if (MaxAnisotropy <= 1.0f)
+        {
+            return;
+        }
+        GL::BindTexture(GL_TEXTURE_2D, texture_handle);
+        GL::TexParameterf(GL_TEXTURE_2D, GL_TEXTURE_MAX_ANISOTROPY, std::clamp(max_anisotropy, 1.0f, MaxAnisotropy));
     }
 
     void SetWrapping(TextureHandle texture_handle, Wrapping wrapping, TextureCoordinate coord) noexcept
@@ -97,7 +295,38 @@ namespace OpenGL
         {
             GL::TexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrapping_);
         }
+    }
+
+    AlphaContent ClassifyAlpha(std::span<const CS200::RGBA> colors) noexcept
+    {
+        auto content = AlphaContent::Opaque;
+        for (const CS200::RGBA color : colors)
+        {
+            const auto alpha = texel_alpha(color);
+            if (alpha == 0x00)
+            {
+                content = AlphaContent::Cutout;
+            }
+            else if (alpha != 0xff)
+            {
+                return AlphaContent::Unknown;
+            }
+        }
+        return content;
+    }
 
-        GL::BindTexture(GL_TEXTURE_2D, 0);
+    bool IsTextureOpaque(TextureHandle texture_handle) noexcept
+    {
+        if (texture_handle == 0 || texture_handle >= texture_state.size())
+        {
+            return false;
+        }
+        const TextureState& opacity = texture_state[texture_handle];
+        return opacity.Alpha == AlphaContent::Opaque || (opacity.Alpha == AlphaContent::Cutout && opacity.Nearest);
+    }
+
+    void SetAlphaContent(TextureHandle texture_handle, AlphaContent alpha) noexcept
+    {
+        state_entry(texture_handle).Alpha = alpha;
     }
 }
@@ -12,12 +12,19 @@
 #include "GLConstants.hpp"
 #include "GLTypes.hpp"
 #include "Handle.hpp"
+#include <cstdint>
 #include <filesystem>
 #include <span>
 
 namespace CS200
 {
     class Image;
+    class CompressedImage;
+}
+
+namespace OpenGL
+{
+    class TextureUploader;
 }
 
 namespace OpenGL
@@ -41,13 +48,33 @@ namespace OpenGL
      * Performance considerations:
      * - NearestPixel: Faster sampling, lower memory bandwidth
      * - Linear: More expensive sampling, higher memory bandwidth
+     *
+     * Mipmapped modes:
+     * A sprite drawn at a quarter of its size with NearestPixel or Linear still reads texels spread
+     * over the whole image, which shimmers while moving and misses the texture cache on every
+     * fragment. The *Mipmap* modes give the texture a chain of half sized copies and sample the
+     * level closest to the on-screen size. The first word is the filter inside a level (and the
+     * magnification filter), the second one how neighbouring levels are combined. LinearMipmapLinear
+     * is trilinear filtering. Mipmaps cost a third more memory.
      */
     enum class Filtering : GLint
     {
-        NearestPixel = GL_NEAREST, ///< Sharp pixelated sampling, ideal for pixel art and crisp graphics
-        Linear       = GL_LINEAR   ///< Smooth interpolated sampling, ideal for photographs and realistic textures
+        NearestPixel         = GL_NEAREST,                ///< Sharp pixelated sampling, ideal for pixel art and crisp graphics
+        Linear               = GL_LINEAR,                 ///< Smooth interpolated sampling, ideal for photographs and realistic textures
+        NearestMipmapNearest = GL_NEAREST_MIPMAP_NEAREST, ///< Nearest texel of the closest level, pixel art that stays stable when zoomed out
+        LinearMipmapNearest  = GL_LINEAR_MIPMAP_NEAREST,  ///< Bilinear inside the closest level, visible seams where the level changes
+        NearestMipmapLinear  = GL_NEAREST_MIPMAP_LINEAR,  ///< Nearest texels of the two closest levels blended
+        LinearMipmapLinear   = GL_LINEAR_MIPMAP_LINEAR    ///< Trilinear, smoothest result for minified sprites
     };
 
+    /**
+     * \brief true for the filtering modes that sample a mipmap chain
+     */
+    [[nodiscard]] constexpr bool UsesMipmaps(Filtering filtering) noexcept
+    {
+        return filtering != Filtering::NearestPixel && filtering != Filtering::Linear;
+    }
+
     /**
      * \brief Texture wrapping modes for controlling behavior outside texture boundaries
      *
@@ -85,6 +112,7 @@ namespace OpenGL
      * \param image Image object containing loaded pixel data and dimensions
      * \param filtering Texture sampling method (default: nearest pixel for crisp graphics)
      * \param wrapping Texture coordinate wrapping behavior (default: repeat for tiling)
+     * \param uploader Optional pixel buffer ring the texels are staged through, see CreateTextureFromMemory()
      * \return Handle to the created OpenGL texture object
      *
      * Creates an OpenGL texture from a pre-loaded Image object, transferring the
@@ -102,11 +130,12 @@ namespace OpenGL
      * - Importing procedurally generated images
      *
      * The function extracts size and pixel data from the Image object and
-     * delegates to CreateTextureFromMemory() for the actual OpenGL setup.
-     * This provides a convenient interface while maintaining implementation
-     * consistency across different texture creation methods.
+     * does the same OpenGL setup as CreateTextureFromMemory(). An image loaded with
+     * build_mipmaps brings its mip chain, which is uploaded as is instead of being
+     * filtered again here.
      */
-    [[nodiscard]] TextureHandle CreateTextureFromImage(const CS200::Image& image, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
+    [[nodiscard]] TextureHandle CreateTextureFromImage(
+        const CS200::Image& image, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat, TextureUploader* uploader = nullptr) noexcept;
 
     /**
      * \brief Create OpenGL texture from raw pixel data in memory
@@ -114,6 +143,7 @@ namespace OpenGL
      * \param colors Span of RGBA pixel data in row-major order
      * \param filtering Texture sampling method (default: nearest pixel)
      * \param wrapping Texture coordinate wrapping behavior (default: repeat)
+     * \param uploader Optional pixel buffer ring the texels are staged through
      * \return Handle to the created OpenGL texture object
      *
      * Creates an OpenGL texture directly from a span of RGBA color data,
@@ -136,9 +166,17 @@ namespace OpenGL
      * The implementation creates the OpenGL texture object, applies the
      * specified filtering and wrapping settings, and uploads the pixel
      * data using GL::TexImage2D() for immediate GPU availability.
+     *
+     * With a mipmapped filtering mode every level down to 1×1 is computed on the CPU with
+     * CS200::build_mip_chain() and uploaded as well, which is gamma-correct unlike the box filter
+     * behind GL::GenerateMipmap(). That runs on the calling thread, load image files with
+     * build_mipmaps to have the chain computed where they are decoded and cached with them.
+     *
+     * Given an uploader, storage is allocated empty and the texels go through one of its pixel
+     * unpack buffers, so the call does not wait for the driver to copy them.
      */
-    [[nodiscard]] TextureHandle
-        CreateTextureFromMemory(Math::ivec2 size, std::span<const CS200::RGBA> colors, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
+    [[nodiscard]] TextureHandle CreateTextureFromMemory(
+        Math::ivec2 size, std::span<const CS200::RGBA> colors, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat, TextureUploader* uploader = nullptr) noexcept;
 
     /**
      * \brief Create empty RGBA texture without initial pixel data
@@ -171,10 +209,54 @@ namespace OpenGL
      * Memory efficiency:
      * Creating empty textures avoids unnecessary data transfers and is
      * particularly efficient when the texture will be written to by
-     * rendering operations rather than CPU-provided data.
+     * rendering operations rather than CPU-provided data.     *
+     * A mipmapped filtering mode allocates the whole chain, call GL::GenerateMipmap() after
+     * rendering into level 0 to refresh the smaller levels.
      */
     [[nodiscard]] TextureHandle CreateRGBATexture(Math::ivec2 size, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
 
+    /**
+     * \brief Check whether the driver accepts a block compressed format
+     * \param internal_format GL_COMPRESSED_* value stored in a KTX file
+     * \param size Size of level 0, WebGL only accepts S3TC with multiples of 4
+     * \return true when CreateTextureFromCompressedImage() can upload it
+     *
+     * Reads the flags set by CS200::RenderingAPI::Init(), safe to call from worker threads afterwards.
+     */
+    [[nodiscard]] bool IsCompressedFormatSupported(GLenum internal_format, Math::ivec2 size) noexcept;
+
+    /**
+     * \brief Create OpenGL texture from block compressed data
+     * \param image KTX data, its format must pass IsCompressedFormatSupported()
+     * \param filtering Texture sampling method (default: nearest pixel)
+     * \param wrapping Texture coordinate wrapping behavior (default: repeat)
+     * \return Handle to the created OpenGL texture object
+     *
+     * Uploads every level with GL::CompressedTexImage2D() straight from the mapped file. ETC2 and
+     * S3TC take 4 or 8 bits per texel instead of 32, the GPU decodes blocks while sampling so the
+     * savings apply to memory, upload time and texture cache bandwidth alike.
+     *
+     * Formats without an alpha channel are reported as opaque by IsTextureOpaque().
+     */
+    [[nodiscard]] TextureHandle
+        CreateTextureFromCompressedImage(const CS200::CompressedImage& image, Filtering filtering = Filtering::NearestPixel, Wrapping wrapping = Wrapping::Repeat) noexcept;
+
+    /**
+     * \brief Overwrite a rectangle of an existing RGBA texture
+     * \param texture_handle Texture created by one of the functions above
+     * \param offset Texel of the rectangle closest to the texture origin
+     * \param size Rectangle dimensions in pixels
+     * \param colors Exactly (width × height) RGBA values in the same row order as CreateTextureFromMemory()
+     * \param uploader Optional pixel buffer ring the texels are staged through
+     *
+     * Uploads with GL::TexSubImage2D(), the rest of the texture is left untouched. This is how texture
+     * atlas pages are filled one image at a time.
+     *
+     * The alpha content tracked for IsTextureOpaque() is merged with the new texels, so a page only stays
+     * opaque while every image written into it is.
+     */
+    void UpdateTextureRegion(TextureHandle texture_handle, Math::ivec2 offset, Math::ivec2 size, std::span<const CS200::RGBA> colors, TextureUploader* uploader = nullptr) noexcept;
+
     /**
      * \brief Update texture filtering mode after creation
      * \param texture_handle Handle to the texture object to modify
@@ -198,9 +280,24 @@ namespace OpenGL
      * The function temporarily binds the texture, updates both MIN_FILTER
      * and MAG_FILTER parameters, then unbinds the texture. This ensures
      * the filtering change takes effect immediately for subsequent rendering.
+     *
+     * Switching a texture without mipmaps to a mipmapped mode builds the chain on the GPU with
+     * GL::GenerateMipmap(), its texels are no longer available for the gamma-correct CPU path.
      */
     void SetFiltering(TextureHandle texture_handle, Filtering filtering) noexcept;
 
+    /**
+     * \brief Sample up to max_anisotropy texels along the direction a texture is stretched in
+     * \param texture_handle Handle to the texture object to modify
+     * \param max_anisotropy 1 turns it off, clamped to OpenGL::MaxAnisotropy
+     *
+     * Mipmapping picks the level from the larger screen-space footprint axis, sprites squashed in one
+     * direction (scaled non-uniformly, or drawn with a skewed camera) turn blurry. Anisotropic
+     * filtering takes extra samples along the long axis instead. Does nothing when the driver lacks
+     * GL_EXT_texture_filter_anisotropic (OpenGL::MaxAnisotropy stays 1).
+     */
+    void SetAnisotropy(TextureHandle texture_handle, float max_anisotropy) noexcept;
+
     enum TextureCoordinate
     {
         S,
@@ -233,4 +330,49 @@ namespace OpenGL
      * Changes take effect immediately for subsequent texture sampling operations.
      */
     void SetWrapping(TextureHandle texture_handle, Wrapping wrapping, TextureCoordinate coord = TextureCoordinate::Both) noexcept;
+
+    /**
+     * \brief Check whether a texture can be drawn without blending
+     * \param texture_handle Handle returned by one of the Create*Texture functions
+     * \return true when every sampled texel is either fully opaque or discarded by the 2D shaders
+     *
+     * The alpha channel is inspected once when the texture is created from memory. A texture counts
+     * as opaque when every texel has alpha 255, or when every texel has alpha 0 or 255 and the texture
+     * uses Filtering::NearestPixel, because the 2D fragment shaders discard texels with alpha 0 and
+     * nearest sampling never blends the two. Linear filtering would create partially transparent
+     * texels along cut-out edges, so SetFiltering() updates the answer.
+     *
+     * Textures created with CreateRGBATexture() have unknown contents and are never opaque.
+     * Renderers use this to draw opaque sprites front-to-back with depth writes.
+     */
+    [[nodiscard]] bool IsTextureOpaque(TextureHandle texture_handle) noexcept;
+
+    /**
+     * \brief What the alpha channel of a set of texels allows, see IsTextureOpaque()
+     */
+    enum class AlphaContent : std::uint8_t
+    {
+        Unknown,
+        Opaque, ///< every texel has alpha 255
+        Cutout  ///< every texel has alpha 0 or 255
+    };
+
+    /**
+     * \brief Inspect the alpha channel of RGBA8 texels
+     * \param colors Texels in the byte order uploaded as GL_RGBA / GL_UNSIGNED_BYTE
+     * \return The classification the Create*Texture functions record for IsTextureOpaque()
+     *
+     * Touches no OpenGL state, safe to call from worker threads.
+     */
+    [[nodiscard]] AlphaContent ClassifyAlpha(std::span<const CS200::RGBA> colors) noexcept;
+
+    /**
+     * \brief Record the alpha content of a texture whose texels were written without going through this file
+     * \param texture_handle Texture created by CreateRGBATexture()
+     * \param alpha ClassifyAlpha() of everything written into it
+     *
+     * For textures filled through TextureUploader::Submit(), where the texels were classified by
+     * whoever staged them.
+     */
+    void SetAlphaContent(TextureHandle texture_handle, AlphaContent alpha) noexcept;
 }
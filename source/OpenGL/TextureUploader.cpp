@@ -0,0 +1,248 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "TextureUploader.hpp"
+#include "CS200/Mipmap.hpp"
+#include "Environment.hpp"
+#include "GL.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace
+{
+    constexpr GLuint64 ONE_MILLISECOND_IN_NANOSECONDS = 1'000'000;
+}
+
+namespace OpenGL
+{
+    TextureUploader::~TextureUploader()
+    {
+        Shutdown();
+    }
+
+    void TextureUploader::Shutdown()
+    {
+        for (StagingBuffer& slot : slots)
+        {
+            destroy(slot);
+            slot.Client.clear();
+            slot.Client.shrink_to_fit();
+        }
+        next       = 0;
+        statistics = {};
+    }
+
+    TextureUploader::Staging TextureUploader::Reserve(std::size_t size_bytes)
+    {
+        if (size_bytes == 0)
+        {
+            return {};
+        }
+
+        for (unsigned attempt = 0; attempt < SlotCount; ++attempt)
+        {
+            const unsigned index = (next + attempt) % SlotCount;
+            StagingBuffer& slot  = slots[index];
+            if (slot.Reserved)
+            {
+                continue;
+            }
+
+            std::byte* memory = nullptr;
+            if constexpr (IsWebGL)
+            {
+                slot.Client.resize(size_bytes);
+                memory = slot.Client.data();
+            }
+            else
+            {
+                memory = map(slot, static_cast<GLsizeiptr>(size_bytes));
+            }
+            if (memory == nullptr)
+            {
+                return {};
+            }
+
+            slot.Reserved = true;
+            next          = (index + 1) % SlotCount;
+            return Staging{ index, std::span{ memory, size_bytes } };
+        }
+        return {};
+    }
+
+    void TextureUploader::Submit(const Staging& staging, TextureHandle texture_handle, GLint level, Math::ivec2 offset, Math::ivec2 size)
+    {
+        StagingBuffer& slot = slots[staging.Slot];
+        beginSubmit(slot, texture_handle);
+        GL::TexSubImage2D(GL_TEXTURE_2D, level, offset.x, offset.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, source(slot, 0));
+        endSubmit(slot);
+    }
+
+    void TextureUploader::SubmitMipChain(const Staging& staging, TextureHandle texture_handle, Math::ivec2 size, bool mipmapped)
+    {
+        StagingBuffer& slot   = slots[staging.Slot];
+        std::size_t    offset = 0;
+        beginSubmit(slot, texture_handle);
+        for (GLint level = 0;; ++level)
+        {
+            GL::TexSubImage2D(GL_TEXTURE_2D, level, 0, 0, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, source(slot, offset));
+            if (!mipmapped || (size.x == 1 && size.y == 1))
+            {
+                break;
+            }
+            // levels are packed back to back, the same layout CS200::build_mip_chain() writes
+            offset += static_cast<std::size_t>(size.x) * static_cast<std::size_t>(size.y) * sizeof(CS200::RGBA);
+            size = CS200::next_mip_size(size);
+        }
+        endSubmit(slot);
+    }
+
+    void TextureUploader::Cancel(const Staging& staging)
+    {
+        StagingBuffer& slot = slots[staging.Slot];
+        if (!IsWebGL && slot.Persistent == nullptr)
+        {
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+            GL::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+        slot.Reserved = false;
+    }
+
+    void TextureUploader::Upload(TextureHandle texture_handle, GLint level, Math::ivec2 offset, Math::ivec2 size, std::span<const CS200::RGBA> colors)
+    {
+        const Staging staging = IsWebGL ? Staging{} : Reserve(colors.size_bytes());
+        if (!staging)
+        {
+            GL::BindTexture(GL_TEXTURE_2D, texture_handle);
+            GL::TexSubImage2D(GL_TEXTURE_2D, level, offset.x, offset.y, size.x, size.y, GL_RGBA, GL_UNSIGNED_BYTE, colors.data());
+            return;
+        }
+        std::memcpy(staging.Memory.data(), colors.data(), colors.size_bytes());
+        Submit(staging, texture_handle, level, offset, size);
+    }
+
+    void TextureUploader::beginSubmit(StagingBuffer& slot, TextureHandle texture_handle)
+    {
+        GL::BindTexture(GL_TEXTURE_2D, texture_handle);
+        if constexpr (!IsWebGL)
+        {
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+            if (slot.Persistent == nullptr)
+            {
+                GL::UnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+            }
+        }
+    }
+
+    const void* TextureUploader::source(const StagingBuffer& slot, std::size_t offset) noexcept
+    {
+        if constexpr (IsWebGL)
+        {
+            return slot.Client.data() + offset;
+        }
+        else
+        {
+            // with an unpack buffer bound the data pointer is a byte offset into it
+            return reinterpret_cast<const void*>(offset);
+        }
+    }
+
+    void TextureUploader::endSubmit(StagingBuffer& slot)
+    {
+        if constexpr (!IsWebGL)
+        {
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            if (slot.Persistent != nullptr)
+            {
+                slot.Fence = GL::FenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+            }
+        }
+        slot.Reserved = false;
+        ++statistics.Uploads;
+    }
+
+    void TextureUploader::waitForGPU(StagingBuffer& slot)
+    {
+        if (slot.Fence == nullptr)
+        {
+            return;
+        }
+
+        GLenum result = GL::ClientWaitSync(slot.Fence, 0, 0);
+        if (result == GL_TIMEOUT_EXPIRED)
+        {
+            ++statistics.Waits;
+            do
+            {
+                result = GL::ClientWaitSync(slot.Fence, GL_SYNC_FLUSH_COMMANDS_BIT, ONE_MILLISECOND_IN_NANOSECONDS);
+            } while (result == GL_TIMEOUT_EXPIRED);
+        }
+
+        GL::DeleteSync(slot.Fence);
+        slot.Fence = nullptr;
+    }
+
+    std::byte* TextureUploader::map([[maybe_unused]] StagingBuffer& slot, [[maybe_unused]] GLsizeiptr size)
+    {
+#if !defined(IS_WEBGL2)
+        waitForGPU(slot);
+        if (slot.Capacity < size)
+        {
+            destroy(slot);
+            slot.Capacity = std::max(size, MinimumSlotSize);
+            GL::GenBuffers(1, &slot.Buffer);
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+            if (HasBufferStorage)
+            {
+                const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+                GL::BufferStorage(GL_PIXEL_UNPACK_BUFFER, slot.Capacity, nullptr, flags);
+                slot.Persistent = static_cast<std::byte*>(GL::MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, slot.Capacity, flags));
+                if (slot.Persistent == nullptr)
+                {
+                    // immutable storage cannot be re-specified, start over with a mutable buffer
+                    GL::DeleteBuffers(1, &slot.Buffer);
+                    GL::GenBuffers(1, &slot.Buffer);
+                    GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+                }
+            }
+            GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        }
+
+        if (slot.Persistent != nullptr)
+        {
+            return slot.Persistent;
+        }
+
+        GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, slot.Buffer);
+        GL::BufferData(GL_PIXEL_UNPACK_BUFFER, slot.Capacity, nullptr, GL_STREAM_DRAW);
+        auto* memory = static_cast<std::byte*>(GL::MapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+        GL::BindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+        return memory;
+#else
+        return nullptr;
+#endif
+    }
+
+    void TextureUploader::destroy(StagingBuffer& slot)
+    {
+        if (slot.Fence != nullptr)
+        {
+            GL::DeleteSync(slot.Fence);
+            slot.Fence = nullptr;
+        }
+        if (slot.Buffer != 0)
+        {
+            // a buffer that is still mapped is unmapped by deleting it
+            GL::DeleteBuffers(1, &slot.Buffer);
+            slot.Buffer = 0;
+        }
+        slot.Persistent = nullptr;
+        slot.Capacity   = 0;
+        slot.Reserved   = false;
+    }
+}
@@ -0,0 +1,167 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include "Buffer.hpp"
+#include "CS200/RGBA.hpp"
+#include "Engine/Vec2.hpp"
+#include "GLTypes.hpp"
+#include "Texture.hpp"
+#include <array>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace OpenGL
+{
+    /**
+     * \brief Uploads texels to textures through a ring of pixel unpack buffers
+     *
+     * glTexImage2D / glTexSubImage2D reading client memory must copy every texel before returning,
+     * the application may free the memory right after. Sourcing the same call from a buffer bound to
+     * GL_PIXEL_UNPACK_BUFFER returns at once, the transfer into the texture happens later on the GPU.
+     *
+     * The uploader owns SlotCount staging buffers. Reserve() hands out the mapped memory of one of
+     * them, it can be filled from any thread, Submit() on the main thread then issues the texture
+     * update from it. The staging buffers are picked once in Reserve(), like StreamBuffer:
+     * - Persistent mapping (GL 4.4 / GL_ARB_buffer_storage): each slot stays mapped for its lifetime.
+     *   Submit() places a fence, a slot is only handed out again once the GPU has passed it.
+     * - Orphaning (GL 3.3): each Reserve() re-specifies the slot with glBufferData(nullptr) and maps
+     *   it with GL_MAP_INVALIDATE_BUFFER_BIT, the driver keeps the old storage alive while it is read.
+     * - WebGL2 has no buffer mapping. Slots are plain memory and Submit() uploads straight from it.
+     *
+     * Example Usage:
+     * \code
+     * auto staging = uploader.Reserve(size.x * size.y * sizeof(CS200::RGBA));
+     * auto done    = pool.Submit([memory = staging.Memory] { generate_texels(memory); });
+     * ...
+     * if (util::ThreadPool::IsReady(done))
+     *     uploader.Submit(staging, texture, 0, { 0, 0 }, size);    // main thread, GL calls
+     * \endcode
+     */
+    class TextureUploader
+    {
+    public:
+        /**
+         * \brief Number of staging buffers, also the number of reservations that can be open at once
+         */
+        static constexpr unsigned SlotCount = 4;
+
+        /**
+         * \brief Smallest staging buffer allocated, so a slot is not reallocated for every slightly larger image
+         */
+        static constexpr GLsizeiptr MinimumSlotSize = 1024 * 1024;
+
+        /**
+         * \brief Staging memory handed out by Reserve(), false when no slot was available
+         */
+        struct Staging
+        {
+            unsigned             Slot = SlotCount;
+            std::span<std::byte> Memory{}; ///< writable from any thread until Submit() or Cancel()
+
+            explicit operator bool() const noexcept
+            {
+                return Slot < SlotCount;
+            }
+        };
+
+        /**
+         * \brief Counters since the last Shutdown(), a non-zero Waits means uploads come faster than the GPU consumes them
+         */
+        struct Statistics
+        {
+            unsigned Uploads = 0;
+            unsigned Waits   = 0; ///< fences that were not signaled yet when their slot was reused
+        };
+
+        TextureUploader() noexcept = default;
+
+        TextureUploader(const TextureUploader& other)            = delete;
+        TextureUploader(TextureUploader&& other)                 = delete;
+        TextureUploader& operator=(const TextureUploader& other) = delete;
+        TextureUploader& operator=(TextureUploader&& other)      = delete;
+
+        ~TextureUploader();
+
+        /**
+         * \brief Unmap and delete every staging buffer and fence, safe to call multiple times
+         *
+         * Open reservations become invalid. Buffers are created again by the next Reserve().
+         */
+        void Shutdown();
+
+        /**
+         * \brief Hand out staging memory, main thread only
+         * \param size_bytes Number of bytes the upload needs
+         * \return Memory to fill, or an empty Staging when every slot is reserved already
+         *
+         * Waits on the slot's fence if the GPU still reads its previous contents.
+         */
+        [[nodiscard]] Staging Reserve(std::size_t size_bytes);
+
+        /**
+         * \brief Copy the staged texels into a texture, main thread only
+         * \param staging Reservation returned by Reserve(), filled with RGBA8 texels in GL_RGBA / GL_UNSIGNED_BYTE order
+         * \param texture_handle Texture whose storage for level already exists
+         * \param level Mipmap level to write
+         * \param offset Texel of the rectangle closest to the texture origin
+         * \param size Rectangle dimensions in pixels, size.x × size.y texels are read from the start of Memory
+         */
+        void Submit(const Staging& staging, TextureHandle texture_handle, GLint level, Math::ivec2 offset, Math::ivec2 size);
+
+        /**
+         * \brief Copy level 0 and every smaller level of a texture from one reservation, main thread only
+         * \param staging Reservation holding level 0 followed by the levels CS200::build_mip_chain() writes, in that layout
+         * \param texture_handle Texture whose storage for all levels already exists, see CreateRGBATexture()
+         * \param size Dimensions of level 0
+         * \param mipmapped false to copy level 0 only
+         */
+        void SubmitMipChain(const Staging& staging, TextureHandle texture_handle, Math::ivec2 size, bool mipmapped);
+
+        /**
+         * \brief Give a reservation back without uploading anything
+         */
+        void Cancel(const Staging& staging);
+
+        /**
+         * \brief Reserve(), copy colors into the staging memory and Submit() in one call
+         *
+         * Uploads straight from colors when no slot is free or on WebGL, where staging would only
+         * add a copy.
+         */
+        void Upload(TextureHandle texture_handle, GLint level, Math::ivec2 offset, Math::ivec2 size, std::span<const CS200::RGBA> colors);
+
+        [[nodiscard]] const Statistics& GetStatistics() const noexcept
+        {
+            return statistics;
+        }
+
+    private:
+        struct StagingBuffer
+        {
+            BufferHandle           Buffer     = 0;
+            GLsizeiptr             Capacity   = 0;
+            std::byte*             Persistent = nullptr;
+            GLsync                 Fence      = nullptr;
+            bool                   Reserved   = false;
+            std::vector<std::byte> Client{}; // WebGL staging memory
+        };
+
+        void                             beginSubmit(StagingBuffer& slot, TextureHandle texture_handle);
+        [[nodiscard]] static const void* source(const StagingBuffer& slot, std::size_t offset) noexcept;
+        void                             endSubmit(StagingBuffer& slot);
+        void                             waitForGPU(StagingBuffer& slot);
+        [[nodiscard]] std::byte*         map(StagingBuffer& slot, GLsizeiptr size);
+        void                             destroy(StagingBuffer& slot);
+
+        std::array<StagingBuffer, SlotCount> slots{};
+        unsigned                             next = 0;
+        Statistics                           statistics{};
+    };
+}
@@ -9,6 +9,53 @@
 #include "VertexArray.hpp"
 #include "GL.hpp"
 
+namespace
+{
+    // Points every attribute of one buffer layout at the currently bound VAO, returns the next free attribute index
+    GLuint configure_attributes(GLuint attribute_index, const OpenGL::VertexBuffer& vertices, GLintptr extra_byte_offset)
+    {
+        const auto& [buffer_handle, buffer_layout] = vertices;
+        GL::BindBuffer(GL_ARRAY_BUFFER, buffer_handle);
+
+        GLsizei stride = 0;
+        for (OpenGL::Attribute::Type type : buffer_layout.Attributes)
+        {
+            stride += type.SizeBytes;
+        }
+
+        GLintptr offset               = 0;
+        GLintptr starting_byte_offset = static_cast<GLintptr>(buffer_layout.BufferStartingByteOffset) + extra_byte_offset;
+
+        for (OpenGL::Attribute::Type attr_type : buffer_layout.Attributes)
+        {
+            if (attr_type == OpenGL::Attribute::None)
+                continue;
+            GL::EnableVertexAttribArray(attribute_index);
+
+            const GLenum    gl_type         = attr_type.GLType;
+            const GLint     component_count = attr_type.ComponentCount;
+            const GLboolean normalized      = attr_type.Normalize;
+            const bool      is_integer      = attr_type.IntAttribute;
+            const GLuint    divisor         = attr_type.Divisor;
+
+            if (is_integer == true)
+            {
+                GL::VertexAttribIPointer(attribute_index, component_count, gl_type, stride, reinterpret_cast<GLvoid*>(starting_byte_offset + offset));
+            }
+            else
+            {
+                GL::VertexAttribPointer(attribute_index, component_count, gl_type, normalized, stride, reinterpret_cast<GLvoid*>(starting_byte_offset + offset));
+            }
+
+            GL::VertexAttribDivisor(attribute_index, divisor);
+
+            offset += attr_type.SizeBytes;
+            attribute_index++;
+        }
+        return attribute_index;
+    }
+}
+
 namespace OpenGL
 {
     /**
@@ -46,45 +93,9 @@ namespace OpenGL
         GLuint attribute_index = 0;
 
 
-        for (const auto& [buffer_handle, buffer_layout] : vertices)
+        for (const VertexBuffer& vertex_buffer : vertices)
         {
-            GL::BindBuffer(GL_ARRAY_BUFFER, buffer_handle);
-
-            GLsizei stride = 0;
-            for (Attribute::Type type : buffer_layout.Attributes)
-            {
-                stride += type.SizeBytes;
-            }
-
-            GLintptr offset               = 0;
-            GLintptr starting_byte_offset = static_cast<GLintptr>(buffer_layout.BufferStartingByteOffset);
-
-            for (Attribute::Type attr_type : buffer_layout.Attributes)
-            {
-                if (attr_type == Attribute::None)
-                    continue;
-                GL::EnableVertexAttribArray(attribute_index);
-
-                const GLenum    gl_type         = attr_type.GLType;
-                const GLint     component_count = attr_type.ComponentCount;
-                const GLboolean normalized      = attr_type.Normalize;
-                const bool      is_integer      = attr_type.IntAttribute;
-                const GLuint    divisor         = attr_type.Divisor;
-
-                if (is_integer == true)
-                {
-                    GL::VertexAttribIPointer(attribute_index, component_count, gl_type, stride, reinterpret_cast<GLvoid*>(starting_byte_offset + offset));
-                }
-                else
-                {
-                    GL::VertexAttribPointer(attribute_index, component_count, gl_type, normalized, stride, reinterpret_cast<GLvoid*>(starting_byte_offset + offset));
-                }
-
-                GL::VertexAttribDivisor(attribute_index, divisor);
-
-                offset += attr_type.SizeBytes;
-                attribute_index++;
-            }
+            attribute_index = configure_attributes(attribute_index, vertex_buffer, 0);
         }
 
         if (index_buffer != 0)
@@ -101,4 +112,22 @@ namespace OpenGL
         return CreateVertexArrayObject({ vertices }, index_buffer);
     }
 
+    /**
+     * \brief Re-points the attributes of one vertex buffer of an existing VAO at a new byte offset
+     *
+     * Used with streamed buffers: every batch is written at a different place of the same buffer,
+     * so the attribute pointers move instead of the data. GL 3.3 and WebGL2 have no base instance,
+     * which makes this the portable way to draw instanced data from an offset.
+     *
+     * \param vao The VAO to modify, it is left bound so the following draw call can use it
+     * \param first_attribute_index Attribute index of the first attribute of vertices inside the VAO
+     * \param vertices The buffer and the layout it was created with
+     * \param byte_offset Bytes added to the layout's BufferStartingByteOffset
+     */
+    void SetVertexBufferOffset(VertexArrayHandle vao, GLuint first_attribute_index, const VertexBuffer& vertices, GLintptr byte_offset)
+    {
+        GL::BindVertexArray(vao);
+        configure_attributes(first_attribute_index, vertices, byte_offset);
+    }
+
 }
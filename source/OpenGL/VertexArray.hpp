@@ -66,6 +66,7 @@ namespace OpenGL
 
     VertexArrayHandle CreateVertexArrayObject(std::initializer_list<VertexBuffer> vertices, BufferHandle index_buffer = 0);
     VertexArrayHandle CreateVertexArrayObject(VertexBuffer vertices, BufferHandle index_buffer = 0);
+    void              SetVertexBufferOffset(VertexArrayHandle vao, GLuint first_attribute_index, const VertexBuffer& vertices, GLintptr byte_offset);
 
     namespace Attribute
     {
@@ -0,0 +1,232 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "Engine/AssetArchive.hpp"
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <limits>
+#include <string>
+#include <system_error>
+#include <vector>
+
+/*
+ * asset_packer - offline packer of the Assets folder into a single Assets.pak
+ *
+ *   asset_packer project_folder output.pak
+ *
+ * Stores every file below project_folder/Assets under its "Assets/..." name, the way the engine
+ * code spells it. The engine maps the archive once at startup and hands out views of the stored
+ * bytes, so release builds touch no loose file and make no filesystem query per asset. Files are
+ * written in sorted order, packing the same folder twice gives the same archive.
+ */
+namespace
+{
+    namespace fs      = std::filesystem;
+    namespace archive = assets::archive;
+
+    struct Input
+    {
+        std::string   Name{};
+        fs::path      Path{};
+        std::uint64_t Size = 0;
+    };
+
+    constexpr std::uint64_t align_up(std::uint64_t value, std::uint64_t alignment) noexcept
+    {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+
+    void write_padding(std::ostream& stream, std::uint64_t count)
+    {
+        for (std::uint64_t i = 0; i < count; ++i)
+        {
+            stream.put('\0');
+        }
+    }
+
+    bool collect(const fs::path& project_folder, std::vector<Input>& inputs)
+    {
+        const fs::path  assets_folder = project_folder / "Assets";
+        std::error_code error;
+        if (!fs::is_directory(assets_folder, error))
+        {
+            std::cerr << assets_folder.string() << " is not a folder\n";
+            return false;
+        }
+        for (auto it = fs::recursive_directory_iterator(assets_folder, error); !error && it != fs::recursive_directory_iterator(); it.increment(error))
+        {
+            if (!it->is_regular_file(error))
+            {
+                continue;
+            }
+            Input input;
+            input.Name = it->path().lexically_relative(project_folder).generic_string();
+            input.Path = it->path();
+            input.Size = it->file_size(error);
+            if (error)
+            {
+                break;
+            }
+            inputs.push_back(std::move(input));
+        }
+        if (error)
+        {
+            std::cerr << "Failed to list " << assets_folder.string() << ": " << error.message() << '\n';
+            return false;
+        }
+        std::sort(inputs.begin(), inputs.end(), [](const Input& a, const Input& b) { return a.Name < b.Name; });
+        return true;
+    }
+
+    bool copy_file_into(std::ostream& stream, const Input& input)
+    {
+        std::ifstream     source(input.Path, std::ios::binary);
+        std::vector<char> buffer(64 * 1024);
+        std::uint64_t     copied = 0;
+        while (source)
+        {
+            source.read(buffer.data(), static_cast<std::streamsize>(buffer.size()));
+            const std::streamsize count = source.gcount();
+            stream.write(buffer.data(), count);
+            copied += static_cast<std::uint64_t>(count);
+        }
+        // a file that changed size while packing would leave the offsets of the next entries wrong
+        return copied == input.Size && static_cast<bool>(stream);
+    }
+
+    bool pack(const std::vector<Input>& inputs, const fs::path& output)
+    {
+        if (inputs.size() > std::numeric_limits<std::uint32_t>::max() / 2)
+        {
+            std::cerr << "Too many assets for one archive\n";
+            return false;
+        }
+
+        // at most half full, probes stay short
+        std::uint32_t slot_count = 16;
+        while (slot_count < inputs.size() * 2)
+        {
+            slot_count *= 2;
+        }
+
+        archive::Header header;
+        header.Magic         = archive::Magic;
+        header.Version       = archive::Version;
+        header.EntryCount    = static_cast<std::uint32_t>(inputs.size());
+        header.SlotCount     = slot_count;
+        header.SlotsOffset   = sizeof(archive::Header);
+        header.EntriesOffset = align_up(header.SlotsOffset + std::uint64_t{ slot_count } * sizeof(std::uint32_t), alignof(archive::Entry));
+        header.NamesOffset   = header.EntriesOffset + inputs.size() * sizeof(archive::Entry);
+
+        std::vector<archive::Entry> entries(inputs.size());
+        std::vector<std::uint32_t>  slots(slot_count, 0);
+        std::uint64_t               names_size = 0;
+        for (std::size_t i = 0; i < inputs.size(); ++i)
+        {
+            archive::Entry& entry = entries[i];
+            entry.PathHash        = archive::hash_path(inputs[i].Name);
+            entry.NameOffset      = static_cast<std::uint32_t>(names_size);
+            entry.NameLength      = static_cast<std::uint32_t>(inputs[i].Name.size());
+            entry.Size            = inputs[i].Size;
+            names_size += inputs[i].Name.size();
+
+            std::uint32_t slot = static_cast<std::uint32_t>(entry.PathHash) & (slot_count - 1);
+            while (slots[slot] != 0)
+            {
+                slot = (slot + 1) & (slot_count - 1);
+            }
+            slots[slot] = static_cast<std::uint32_t>(i + 1);
+        }
+        if (names_size > std::numeric_limits<std::uint32_t>::max())
+        {
+            std::cerr << "Asset names do not fit the archive index\n";
+            return false;
+        }
+
+        std::uint64_t offset = align_up(header.NamesOffset + names_size, archive::BlobAlignment);
+        for (archive::Entry& entry : entries)
+        {
+            entry.Offset = offset;
+            offset       = align_up(offset + entry.Size, archive::BlobAlignment);
+        }
+        header.FileSize = entries.empty() ? header.NamesOffset : entries.back().Offset + entries.back().Size;
+
+        // written to a temporary file and renamed, a running game never maps half an archive
+        fs::path temporary = output;
+        temporary += ".tmp";
+        {
+            std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+            if (!stream)
+            {
+                std::cerr << "Failed to create " << temporary.string() << '\n';
+                return false;
+            }
+            stream.write(reinterpret_cast<const char*>(&header), sizeof(header));
+            stream.write(reinterpret_cast<const char*>(slots.data()), static_cast<std::streamsize>(slots.size() * sizeof(std::uint32_t)));
+            write_padding(stream, header.EntriesOffset - (header.SlotsOffset + slots.size() * sizeof(std::uint32_t)));
+            stream.write(reinterpret_cast<const char*>(entries.data()), static_cast<std::streamsize>(entries.size() * sizeof(archive::Entry)));
+            for (const Input& input : inputs)
+            {
+                stream.write(input.Name.data(), static_cast<std::streamsize>(input.Name.size()));
+            }
+            std::uint64_t position = header.NamesOffset + names_size;
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            {
+                write_padding(stream, entries[i].Offset - position);
+                if (!copy_file_into(stream, inputs[i]))
+                {
+                    std::cerr << "Failed to copy " << inputs[i].Path.string() << '\n';
+                    stream.close();
+                    fs::remove(temporary);
+                    return false;
+                }
+                position = entries[i].Offset + entries[i].Size;
+            }
+            if (!stream)
+            {
+                std::cerr << "Failed to write " << temporary.string() << '\n';
+                stream.close();
+                fs::remove(temporary);
+                return false;
+            }
+        }
+        std::error_code error;
+        fs::rename(temporary, output, error);
+        if (error)
+        {
+            std::cerr << "Failed to write " << output.string() << ": " << error.message() << '\n';
+            fs::remove(temporary, error);
+            return false;
+        }
+        std::cout << output.string() << ": " << inputs.size() << " assets, " << header.FileSize << " bytes\n";
+        return true;
+    }
+
+    void print_usage()
+    {
+        std::cerr << "usage: asset_packer project_folder output.pak\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3)
+    {
+        print_usage();
+        return 1;
+    }
+
+    std::vector<Input> inputs;
+    if (!collect(argv[1], inputs))
+    {
+        return 1;
+    }
+    return pack(inputs, argv[2]) ? 0 : 1;
+}
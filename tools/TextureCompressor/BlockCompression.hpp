@@ -0,0 +1,57 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace texture_compressor
+{
+    struct Texel
+    {
+        std::uint8_t r = 0;
+        std::uint8_t g = 0;
+        std::uint8_t b = 0;
+        std::uint8_t a = 0;
+    };
+
+    /**
+     * \brief 4×4 texels, Block[y * 4 + x], row 0 is the first row in memory
+     */
+    using Block = std::array<Texel, 16>;
+
+    /**
+     * \brief One encoded 64 bit block, bytes in the order they are written to the file
+     */
+    using EncodedBlock = std::array<std::uint8_t, 8>;
+
+    /**
+     * \brief ETC2 RGB color block (GL_COMPRESSED_RGB8_ETC2), alpha is ignored
+     *
+     * Only the ETC1 compatible individual and differential modes are used, picking the best sub-block
+     * orientation, base colors and modifier tables by exhaustive search.
+     */
+    [[nodiscard]] EncodedBlock encode_etc2_rgb(const Block& block) noexcept;
+
+    /**
+     * \brief EAC alpha block, written before the color block in GL_COMPRESSED_RGBA8_ETC2_EAC
+     */
+    [[nodiscard]] EncodedBlock encode_eac_alpha(const Block& block) noexcept;
+
+    /**
+     * \brief BC1 color block (GL_COMPRESSED_RGB_S3TC_DXT1_EXT), always in four color mode
+     *
+     * Endpoints are the texels furthest apart along the principal axis of the block's colors.
+     */
+    [[nodiscard]] EncodedBlock encode_bc1(const Block& block) noexcept;
+
+    /**
+     * \brief BC3 alpha block, written before the BC1 block in GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+     */
+    [[nodiscard]] EncodedBlock encode_bc3_alpha(const Block& block) noexcept;
+}
@@ -0,0 +1,287 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "BlockCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Bit layouts follow the OpenGL ES 3.0 specification, section C.1 "ETC Compressed Texture Image Formats"
+namespace
+{
+    using texture_compressor::Block;
+    using texture_compressor::EncodedBlock;
+
+    // intensity modifiers, a pixel index picks +small, +large, -small or -large
+    constexpr int ETC_MODIFIERS[8][2] = {
+        {  2,   8 },
+        {  5,  17 },
+        {  9,  29 },
+        { 13,  42 },
+        { 18,  60 },
+        { 24,  80 },
+        { 33, 106 },
+        { 47, 183 }
+    };
+
+    constexpr int EAC_MODIFIERS[16][8] = {
+        { -3, -6, -9, -15, 2, 5, 8, 14 },
+        { -3, -7, -10, -13, 2, 6, 9, 12 },
+        { -2, -5, -8, -13, 1, 4, 7, 12 },
+        { -2, -4, -6, -13, 1, 3, 5, 12 },
+        { -3, -6, -8, -12, 2, 5, 7, 11 },
+        { -3, -7, -9, -11, 2, 6, 8, 10 },
+        { -4, -7, -8, -11, 3, 6, 7, 10 },
+        { -3, -5, -8, -11, 2, 4, 7, 10 },
+        { -2, -6, -8, -10, 1, 5, 7, 9 },
+        { -2, -5, -8, -10, 1, 4, 7, 9 },
+        { -2, -4, -8, -10, 1, 3, 7, 9 },
+        { -2, -5, -7, -10, 1, 4, 6, 9 },
+        { -3, -4, -7, -10, 2, 3, 6, 9 },
+        { -1, -2, -3, -10, 0, 1, 2, 9 },
+        { -4, -6, -8, -9, 3, 5, 7, 8 },
+        { -3, -5, -7, -9, 2, 4, 6, 8 }
+    };
+
+    struct Color
+    {
+        int r = 0;
+        int g = 0;
+        int b = 0;
+    };
+
+    struct SubBlockFit
+    {
+        int           Table   = 0;
+        int           Error   = std::numeric_limits<int>::max();
+        std::uint32_t Indices = 0; // msb in bits 16..31, lsb in bits 0..15, bit position x * 4 + y
+    };
+
+    struct Candidate
+    {
+        std::uint64_t Bits  = 0;
+        long          Error = std::numeric_limits<long>::max();
+    };
+
+    int clamp_byte(int value) noexcept
+    {
+        return std::clamp(value, 0, 255);
+    }
+
+    int expand4(int value) noexcept
+    {
+        return (value << 4) | value;
+    }
+
+    int expand5(int value) noexcept
+    {
+        return (value << 3) | (value >> 2);
+    }
+
+    int quantize(float value, int max_value) noexcept
+    {
+        return std::clamp(static_cast<int>(std::lround(value * static_cast<float>(max_value) / 255.0f)), 0, max_value);
+    }
+
+    // flip 0: two 2×4 halves side by side, flip 1: two 4×2 halves on top of each other
+    bool in_first_half(int x, int y, bool flip) noexcept
+    {
+        return flip ? y < 2 : x < 2;
+    }
+
+    Color average(const Block& block, bool flip, bool first_half) noexcept
+    {
+        float r = 0, g = 0, b = 0;
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                if (in_first_half(x, y, flip) == first_half)
+                {
+                    const auto& texel = block[static_cast<std::size_t>(y * 4 + x)];
+                    r += texel.r;
+                    g += texel.g;
+                    b += texel.b;
+                }
+            }
+        }
+        return Color{ static_cast<int>(r / 8.0f + 0.5f), static_cast<int>(g / 8.0f + 0.5f), static_cast<int>(b / 8.0f + 0.5f) };
+    }
+
+    SubBlockFit fit_sub_block(const Block& block, bool flip, bool first_half, Color base) noexcept
+    {
+        SubBlockFit best;
+        for (int table = 0; table < 8; ++table)
+        {
+            SubBlockFit fit{ table, 0, 0 };
+            for (int y = 0; y < 4; ++y)
+            {
+                for (int x = 0; x < 4; ++x)
+                {
+                    if (in_first_half(x, y, flip) != first_half)
+                    {
+                        continue;
+                    }
+                    const auto& texel      = block[static_cast<std::size_t>(y * 4 + x)];
+                    int         best_index = 0;
+                    int         best_error = std::numeric_limits<int>::max();
+                    for (int index = 0; index < 4; ++index)
+                    {
+                        const int modifier = (index & 1 ? ETC_MODIFIERS[table][1] : ETC_MODIFIERS[table][0]) * (index & 2 ? -1 : 1);
+                        const int dr       = clamp_byte(base.r + modifier) - texel.r;
+                        const int dg       = clamp_byte(base.g + modifier) - texel.g;
+                        const int db       = clamp_byte(base.b + modifier) - texel.b;
+                        const int error    = dr * dr + dg * dg + db * db;
+                        if (error < best_error)
+                        {
+                            best_error = error;
+                            best_index = index;
+                        }
+                    }
+                    const int bit = x * 4 + y;
+                    fit.Error += best_error;
+                    fit.Indices |= static_cast<std::uint32_t>((best_index >> 1) & 1) << (16 + bit);
+                    fit.Indices |= static_cast<std::uint32_t>(best_index & 1) << bit;
+                }
+            }
+            if (fit.Error < best.Error)
+            {
+                best = fit;
+            }
+        }
+        return best;
+    }
+
+    Candidate encode_individual(const Block& block, bool flip) noexcept
+    {
+        const Color       average0 = average(block, flip, true);
+        const Color       average1 = average(block, flip, false);
+        const Color       q0{ quantize(static_cast<float>(average0.r), 15), quantize(static_cast<float>(average0.g), 15), quantize(static_cast<float>(average0.b), 15) };
+        const Color       q1{ quantize(static_cast<float>(average1.r), 15), quantize(static_cast<float>(average1.g), 15), quantize(static_cast<float>(average1.b), 15) };
+        const SubBlockFit fit0 = fit_sub_block(block, flip, true, Color{ expand4(q0.r), expand4(q0.g), expand4(q0.b) });
+        const SubBlockFit fit1 = fit_sub_block(block, flip, false, Color{ expand4(q1.r), expand4(q1.g), expand4(q1.b) });
+
+        std::uint64_t bits = 0;
+        bits |= static_cast<std::uint64_t>(q0.r) << 60 | static_cast<std::uint64_t>(q1.r) << 56;
+        bits |= static_cast<std::uint64_t>(q0.g) << 52 | static_cast<std::uint64_t>(q1.g) << 48;
+        bits |= static_cast<std::uint64_t>(q0.b) << 44 | static_cast<std::uint64_t>(q1.b) << 40;
+        bits |= static_cast<std::uint64_t>(fit0.Table) << 37 | static_cast<std::uint64_t>(fit1.Table) << 34;
+        bits |= static_cast<std::uint64_t>(flip) << 32;
+        bits |= fit0.Indices | fit1.Indices;
+        return Candidate{ bits, static_cast<long>(fit0.Error) + fit1.Error };
+    }
+
+    Candidate encode_differential(const Block& block, bool flip) noexcept
+    {
+        const Color average0 = average(block, flip, true);
+        const Color average1 = average(block, flip, false);
+        const Color q0{ quantize(static_cast<float>(average0.r), 31), quantize(static_cast<float>(average0.g), 31), quantize(static_cast<float>(average0.b), 31) };
+        const Color q1{ quantize(static_cast<float>(average1.r), 31), quantize(static_cast<float>(average1.g), 31), quantize(static_cast<float>(average1.b), 31) };
+        const Color delta{ q1.r - q0.r, q1.g - q0.g, q1.b - q0.b };
+        // a delta outside [-4, 3] cannot be stored, and would select the ETC2 T, H or planar modes
+        if (std::min({ delta.r, delta.g, delta.b }) < -4 || std::max({ delta.r, delta.g, delta.b }) > 3)
+        {
+            return Candidate{};
+        }
+
+        const SubBlockFit fit0 = fit_sub_block(block, flip, true, Color{ expand5(q0.r), expand5(q0.g), expand5(q0.b) });
+        const SubBlockFit fit1 = fit_sub_block(block, flip, false, Color{ expand5(q1.r), expand5(q1.g), expand5(q1.b) });
+
+        std::uint64_t bits = 0;
+        bits |= static_cast<std::uint64_t>(q0.r) << 59 | static_cast<std::uint64_t>(delta.r & 7) << 56;
+        bits |= static_cast<std::uint64_t>(q0.g) << 51 | static_cast<std::uint64_t>(delta.g & 7) << 48;
+        bits |= static_cast<std::uint64_t>(q0.b) << 43 | static_cast<std::uint64_t>(delta.b & 7) << 40;
+        bits |= static_cast<std::uint64_t>(fit0.Table) << 37 | static_cast<std::uint64_t>(fit1.Table) << 34;
+        bits |= std::uint64_t{ 1 } << 33 | static_cast<std::uint64_t>(flip) << 32;
+        bits |= fit0.Indices | fit1.Indices;
+        return Candidate{ bits, static_cast<long>(fit0.Error) + fit1.Error };
+    }
+
+    EncodedBlock to_big_endian(std::uint64_t bits) noexcept
+    {
+        EncodedBlock bytes{};
+        for (std::size_t i = 0; i < bytes.size(); ++i)
+        {
+            bytes[i] = static_cast<std::uint8_t>(bits >> (56 - 8 * i));
+        }
+        return bytes;
+    }
+}
+
+namespace texture_compressor
+{
+    EncodedBlock encode_etc2_rgb(const Block& block) noexcept
+    {
+        Candidate best;
+        for (const bool flip : { false, true })
+        {
+            for (const Candidate& candidate : { encode_differential(block, flip), encode_individual(block, flip) })
+            {
+                if (candidate.Error < best.Error)
+                {
+                    best = candidate;
+                }
+            }
+        }
+        return to_big_endian(best.Bits);
+    }
+
+    EncodedBlock encode_eac_alpha(const Block& block) noexcept
+    {
+        int min_alpha = 255, max_alpha = 0;
+        for (const Texel& texel : block)
+        {
+            min_alpha = std::min(min_alpha, static_cast<int>(texel.a));
+            max_alpha = std::max(max_alpha, static_cast<int>(texel.a));
+        }
+
+        // table 13 has a zero modifier at index 4, an exact encoding of a constant block
+        std::uint64_t best_bits  = static_cast<std::uint64_t>(min_alpha) << 56 | std::uint64_t{ 1 } << 52 | std::uint64_t{ 13 } << 48 | 0x924924924924ull;
+        long          best_error = min_alpha == max_alpha ? 0 : std::numeric_limits<long>::max();
+
+        for (int table = 0; table < 16 && best_error > 0; ++table)
+        {
+            const int  spread         = EAC_MODIFIERS[table][7] - EAC_MODIFIERS[table][3];
+            const int  ideal          = static_cast<int>(std::lround(static_cast<float>(max_alpha - min_alpha) / static_cast<float>(spread)));
+            for (int multiplier = std::max(ideal - 1, 1); multiplier <= std::min(ideal + 1, 15); ++multiplier)
+            {
+                const int center = static_cast<int>(std::lround((min_alpha + max_alpha) / 2.0 - (EAC_MODIFIERS[table][7] + EAC_MODIFIERS[table][3]) * multiplier / 2.0));
+                for (int base = std::max(center - 1, 0); base <= std::min(center + 1, 255); ++base)
+                {
+                    std::uint64_t indices = 0;
+                    long          error   = 0;
+                    for (int x = 0; x < 4; ++x)
+                    {
+                        for (int y = 0; y < 4; ++y)
+                        {
+                            const int alpha      = block[static_cast<std::size_t>(y * 4 + x)].a;
+                            int       best_index = 0;
+                            int       best_delta = std::numeric_limits<int>::max();
+                            for (int index = 0; index < 8; ++index)
+                            {
+                                const int delta = std::abs(clamp_byte(base + EAC_MODIFIERS[table][index] * multiplier) - alpha);
+                                if (delta < best_delta)
+                                {
+                                    best_delta = delta;
+                                    best_index = index;
+                                }
+                            }
+                            error += best_delta * best_delta;
+                            indices |= static_cast<std::uint64_t>(best_index) << (45 - 3 * (x * 4 + y));
+                        }
+                    }
+                    if (error < best_error)
+                    {
+                        best_error = error;
+                        best_bits  = static_cast<std::uint64_t>(base) << 56 | static_cast<std::uint64_t>(multiplier) << 52 | static_cast<std::uint64_t>(table) << 48 | indices;
+                    }
+                }
+            }
+        }
+        return to_big_endian(best_bits);
+    }
+}
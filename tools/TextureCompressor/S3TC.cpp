@@ -0,0 +1,203 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "BlockCompression.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+// Bit layouts follow the EXT_texture_compression_s3tc extension specification
+namespace
+{
+    using texture_compressor::Block;
+    using texture_compressor::EncodedBlock;
+
+    struct Color
+    {
+        float r = 0;
+        float g = 0;
+        float b = 0;
+    };
+
+    Color to_color(const texture_compressor::Texel& texel) noexcept
+    {
+        return Color{ static_cast<float>(texel.r), static_cast<float>(texel.g), static_cast<float>(texel.b) };
+    }
+
+    std::uint16_t to_565(Color color) noexcept
+    {
+        const auto r = static_cast<unsigned>(std::clamp(std::lround(color.r * 31.0f / 255.0f), 0l, 31l));
+        const auto g = static_cast<unsigned>(std::clamp(std::lround(color.g * 63.0f / 255.0f), 0l, 63l));
+        const auto b = static_cast<unsigned>(std::clamp(std::lround(color.b * 31.0f / 255.0f), 0l, 31l));
+        return static_cast<std::uint16_t>(r << 11 | g << 5 | b);
+    }
+
+    Color from_565(std::uint16_t value) noexcept
+    {
+        const unsigned r = (value >> 11) & 31;
+        const unsigned g = (value >> 5) & 63;
+        const unsigned b = value & 31;
+        return Color{ static_cast<float>(r << 3 | r >> 2), static_cast<float>(g << 2 | g >> 4), static_cast<float>(b << 3 | b >> 2) };
+    }
+
+    Color lerp(Color from, Color to, float t) noexcept
+    {
+        return Color{ from.r + (to.r - from.r) * t, from.g + (to.g - from.g) * t, from.b + (to.b - from.b) * t };
+    }
+
+    float distance_squared(Color a, Color b) noexcept
+    {
+        const float dr = a.r - b.r, dg = a.g - b.g, db = a.b - b.b;
+        return dr * dr + dg * dg + db * db;
+    }
+
+    // dominant direction of the block's colors, found with a few rounds of power iteration on the covariance
+    Color principal_axis(const Block& block, Color mean) noexcept
+    {
+        float cov[6] = {}; // rr, rg, rb, gg, gb, bb
+        for (const auto& texel : block)
+        {
+            const Color c = to_color(texel);
+            const float r = c.r - mean.r, g = c.g - mean.g, b = c.b - mean.b;
+            cov[0] += r * r;
+            cov[1] += r * g;
+            cov[2] += r * b;
+            cov[3] += g * g;
+            cov[4] += g * b;
+            cov[5] += b * b;
+        }
+
+        Color axis{ 1, 1, 1 };
+        for (int i = 0; i < 8; ++i)
+        {
+            const Color next{ cov[0] * axis.r + cov[1] * axis.g + cov[2] * axis.b, cov[1] * axis.r + cov[3] * axis.g + cov[4] * axis.b,
+                              cov[2] * axis.r + cov[4] * axis.g + cov[5] * axis.b };
+            const float length = std::max({ std::abs(next.r), std::abs(next.g), std::abs(next.b) });
+            if (length <= std::numeric_limits<float>::epsilon())
+            {
+                break;
+            }
+            axis = Color{ next.r / length, next.g / length, next.b / length };
+        }
+        return axis;
+    }
+
+    void write_little_endian(EncodedBlock& bytes, std::size_t offset, std::uint64_t value, std::size_t byte_count) noexcept
+    {
+        for (std::size_t i = 0; i < byte_count; ++i)
+        {
+            bytes[offset + i] = static_cast<std::uint8_t>(value >> (8 * i));
+        }
+    }
+}
+
+namespace texture_compressor
+{
+    EncodedBlock encode_bc1(const Block& block) noexcept
+    {
+        Color mean;
+        for (const auto& texel : block)
+        {
+            const Color c = to_color(texel);
+            mean          = Color{ mean.r + c.r / 16.0f, mean.g + c.g / 16.0f, mean.b + c.b / 16.0f };
+        }
+
+        const Color axis = principal_axis(block, mean);
+        float       min_t = std::numeric_limits<float>::max(), max_t = std::numeric_limits<float>::lowest();
+        Color       min_color = mean, max_color = mean;
+        for (const auto& texel : block)
+        {
+            const Color c = to_color(texel);
+            const float t = (c.r - mean.r) * axis.r + (c.g - mean.g) * axis.g + (c.b - mean.b) * axis.b;
+            if (t < min_t)
+            {
+                min_t     = t;
+                min_color = c;
+            }
+            if (t > max_t)
+            {
+                max_t     = t;
+                max_color = c;
+            }
+        }
+
+        std::uint16_t c0 = to_565(max_color);
+        std::uint16_t c1 = to_565(min_color);
+        // c0 > c1 selects the four color mode, equal endpoints can only encode one color anyway
+        if (c0 < c1)
+        {
+            std::swap(c0, c1);
+        }
+
+        EncodedBlock bytes{};
+        write_little_endian(bytes, 0, c0, 2);
+        write_little_endian(bytes, 2, c1, 2);
+        if (c0 == c1)
+        {
+            return bytes;
+        }
+
+        const Color   palette[4] = { from_565(c0), from_565(c1), lerp(from_565(c0), from_565(c1), 1.0f / 3.0f), lerp(from_565(c0), from_565(c1), 2.0f / 3.0f) };
+        std::uint32_t indices    = 0;
+        for (std::size_t i = 0; i < block.size(); ++i)
+        {
+            const Color   c          = to_color(block[i]);
+            std::uint32_t best_index = 0;
+            for (std::uint32_t index = 1; index < 4; ++index)
+            {
+                if (distance_squared(c, palette[index]) < distance_squared(c, palette[best_index]))
+                {
+                    best_index = index;
+                }
+            }
+            indices |= best_index << (2 * i);
+        }
+        write_little_endian(bytes, 4, indices, 4);
+        return bytes;
+    }
+
+    EncodedBlock encode_bc3_alpha(const Block& block) noexcept
+    {
+        int min_alpha = 255, max_alpha = 0;
+        for (const auto& texel : block)
+        {
+            min_alpha = std::min(min_alpha, static_cast<int>(texel.a));
+            max_alpha = std::max(max_alpha, static_cast<int>(texel.a));
+        }
+
+        EncodedBlock bytes{};
+        bytes[0] = static_cast<std::uint8_t>(max_alpha);
+        bytes[1] = static_cast<std::uint8_t>(min_alpha);
+        if (min_alpha == max_alpha)
+        {
+            return bytes;
+        }
+
+        // alpha0 > alpha1 selects eight interpolated values: index 0 = alpha0, 1 = alpha1, 2..7 = steps from alpha0 to alpha1
+        int palette[8] = { max_alpha, min_alpha };
+        for (int step = 1; step < 7; ++step)
+        {
+            palette[step + 1] = ((7 - step) * max_alpha + step * min_alpha + 3) / 7;
+        }
+
+        std::uint64_t indices = 0;
+        for (std::size_t i = 0; i < block.size(); ++i)
+        {
+            std::uint64_t best_index = 0;
+            for (std::uint64_t index = 1; index < 8; ++index)
+            {
+                if (std::abs(palette[index] - block[i].a) < std::abs(palette[best_index] - block[i].a))
+                {
+                    best_index = index;
+                }
+            }
+            indices |= best_index << (3 * i);
+        }
+        write_little_endian(bytes, 2, indices, 6);
+        return bytes;
+    }
+}
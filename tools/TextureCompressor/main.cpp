@@ -0,0 +1,247 @@
+/**
+ * \file
+ * \author Hyunwoo Yang
+ * \date 2025 Fall
+ * \par CS200 Computer Graphics I
+ * \copyright DigiPen Institute of Technology
+ */
+#include "BlockCompression.hpp"
+#include "CS200/KTX.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <span>
+#include <stb_image.h>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <vector>
+
+/*
+ * texture_compressor - offline converter from png to block compressed KTX files
+ *
+ *   texture_compressor [--format etc2|s3tc|all] image.png...
+ *
+ * Writes image.etc2.ktx and/or image.s3tc.ktx next to every input. TextureManager picks them up
+ * instead of the png when the GPU supports the format. Fully opaque images use the 4 bits per texel
+ * RGB formats, anything with alpha uses the 8 bits per texel RGBA formats.
+ */
+namespace
+{
+    namespace tc = texture_compressor;
+
+    constexpr std::uint32_t GL_RGB_                           = 0x1907;
+    constexpr std::uint32_t GL_RGBA_                          = 0x1908;
+    constexpr std::uint32_t GL_COMPRESSED_RGB_S3TC_DXT1_EXT_  = 0x83F0;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA_S3TC_DXT5_EXT_ = 0x83F3;
+    constexpr std::uint32_t GL_COMPRESSED_RGB8_ETC2_          = 0x9274;
+    constexpr std::uint32_t GL_COMPRESSED_RGBA8_ETC2_EAC_     = 0x9278;
+
+    enum class Family
+    {
+        ETC2,
+        S3TC
+    };
+
+    struct SourceImage
+    {
+        int                    Width  = 0;
+        int                    Height = 0;
+        std::vector<tc::Texel> Texels{};
+        bool                   Opaque = true;
+    };
+
+    bool load(const std::filesystem::path& path, SourceImage& image)
+    {
+        // the engine loads images flipped, store the bottom row first so the blocks line up with it
+        stbi_set_flip_vertically_on_load(1);
+        int      channels = 0;
+        stbi_uc* pixels   = stbi_load(path.string().c_str(), &image.Width, &image.Height, &channels, 4);
+        if (pixels == nullptr)
+        {
+            std::cerr << "Failed to load " << path.string() << " : " << stbi_failure_reason() << '\n';
+            return false;
+        }
+
+        image.Texels.resize(static_cast<std::size_t>(image.Width) * static_cast<std::size_t>(image.Height));
+        std::memcpy(image.Texels.data(), pixels, image.Texels.size() * sizeof(tc::Texel));
+        stbi_image_free(pixels);
+        image.Opaque = std::all_of(image.Texels.begin(), image.Texels.end(), [](const tc::Texel& texel) { return texel.a == 255; });
+        return true;
+    }
+
+    // partial blocks on the right and top edges repeat the last texel, they are never sampled
+    tc::Block gather_block(const SourceImage& image, int block_x, int block_y) noexcept
+    {
+        tc::Block block{};
+        for (int y = 0; y < 4; ++y)
+        {
+            for (int x = 0; x < 4; ++x)
+            {
+                const int source_x                         = std::min(block_x * 4 + x, image.Width - 1);
+                const int source_y                         = std::min(block_y * 4 + y, image.Height - 1);
+                block[static_cast<std::size_t>(y * 4 + x)] = image.Texels[static_cast<std::size_t>(source_y * image.Width + source_x)];
+            }
+        }
+        return block;
+    }
+
+    std::vector<std::uint8_t> compress(const SourceImage& image, Family family)
+    {
+        const int                 blocks_wide = (image.Width + 3) / 4;
+        const int                 blocks_high = (image.Height + 3) / 4;
+        std::vector<std::uint8_t> data;
+        data.reserve(static_cast<std::size_t>(blocks_wide * blocks_high) * (image.Opaque ? 8u : 16u));
+
+        const auto append = [&data](const tc::EncodedBlock& bytes) { data.insert(data.end(), bytes.begin(), bytes.end()); };
+        for (int block_y = 0; block_y < blocks_high; ++block_y)
+        {
+            for (int block_x = 0; block_x < blocks_wide; ++block_x)
+            {
+                const tc::Block block = gather_block(image, block_x, block_y);
+                if (family == Family::ETC2)
+                {
+                    if (!image.Opaque)
+                    {
+                        append(tc::encode_eac_alpha(block));
+                    }
+                    append(tc::encode_etc2_rgb(block));
+                }
+                else
+                {
+                    if (!image.Opaque)
+                    {
+                        append(tc::encode_bc3_alpha(block));
+                    }
+                    append(tc::encode_bc1(block));
+                }
+            }
+        }
+        return data;
+    }
+
+    template <typename T>
+    void write_raw(std::ofstream& stream, const T& value)
+    {
+        stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    bool write_ktx(const std::filesystem::path& path, const SourceImage& image, Family family, std::span<const std::uint8_t> data)
+    {
+        constexpr std::string_view orientation_key   = "KTXorientation";
+        constexpr std::string_view orientation_value = "S=r,T=u";
+        const auto                 key_value_size    = static_cast<std::uint32_t>(orientation_key.size() + 1 + orientation_value.size() + 1);
+        const std::uint32_t        key_value_padding = (4 - key_value_size % 4) % 4;
+
+        CS200::ktx::Header header;
+        header.identifier           = CS200::ktx::Identifier;
+        header.endianness           = CS200::ktx::Endianness;
+        header.glInternalFormat     = family == Family::ETC2 ? (image.Opaque ? GL_COMPRESSED_RGB8_ETC2_ : GL_COMPRESSED_RGBA8_ETC2_EAC_)
+                                                             : (image.Opaque ? GL_COMPRESSED_RGB_S3TC_DXT1_EXT_ : GL_COMPRESSED_RGBA_S3TC_DXT5_EXT_);
+        header.glBaseInternalFormat = image.Opaque ? GL_RGB_ : GL_RGBA_;
+        header.pixelWidth           = static_cast<std::uint32_t>(image.Width);
+        header.pixelHeight          = static_cast<std::uint32_t>(image.Height);
+        header.bytesOfKeyValueData  = 4 + key_value_size + key_value_padding;
+
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        if (!stream)
+        {
+            std::cerr << "Failed to create " << path.string() << '\n';
+            return false;
+        }
+
+        write_raw(stream, header);
+        write_raw(stream, key_value_size);
+        stream.write(orientation_key.data(), static_cast<std::streamsize>(orientation_key.size()));
+        stream.put('\0');
+        stream.write(orientation_value.data(), static_cast<std::streamsize>(orientation_value.size()));
+        stream.put('\0');
+        for (std::uint32_t i = 0; i < key_value_padding; ++i)
+        {
+            stream.put('\0');
+        }
+
+        // blocks are 8 or 16 bytes so the level data never needs padding
+        write_raw(stream, static_cast<std::uint32_t>(data.size()));
+        stream.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+        return static_cast<bool>(stream);
+    }
+
+    std::filesystem::path output_path(std::filesystem::path input, std::string_view suffix)
+    {
+        return input.replace_extension().string() + std::string{ suffix };
+    }
+
+    void print_usage()
+    {
+        std::cerr << "usage: texture_compressor [--format etc2|s3tc|all] image.png...\n";
+    }
+}
+
+int main(int argc, char* argv[])
+{
+    bool                               etc2 = true;
+    bool                               s3tc = true;
+    std::vector<std::filesystem::path> inputs;
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string_view argument = argv[i];
+        if (argument == "--format" && i + 1 < argc)
+        {
+            const std::string_view format = argv[++i];
+            etc2                          = format == "etc2" || format == "all";
+            s3tc                          = format == "s3tc" || format == "all";
+            if (!etc2 && !s3tc)
+            {
+                print_usage();
+                return 1;
+            }
+        }
+        else if (argument.starts_with("-"))
+        {
+            print_usage();
+            return 1;
+        }
+        else
+        {
+            inputs.emplace_back(argument);
+        }
+    }
+
+    if (inputs.empty())
+    {
+        print_usage();
+        return 1;
+    }
+
+    int failures = 0;
+    for (const auto& input : inputs)
+    {
+        SourceImage image;
+        if (!load(input, image))
+        {
+            ++failures;
+            continue;
+        }
+
+        for (const auto& [enabled, family, suffix] : { std::tuple{ etc2, Family::ETC2, CS200::ktx::ETC2Suffix }, std::tuple{ s3tc, Family::S3TC, CS200::ktx::S3TCSuffix } })
+        {
+            if (!enabled)
+            {
+                continue;
+            }
+            const auto path = output_path(input, suffix);
+            if (write_ktx(path, image, family, compress(image, family)))
+            {
+                std::cout << input.string() << " -> " << path.string() << '\n';
+            }
+            else
+            {
+                ++failures;
+            }
+        }
+    }
+    return failures == 0 ? 0 : 1;
+}